@@ -0,0 +1,245 @@
+/**
+ * Model predictive controller solve time and tracking benchmark
+ *
+ * Follows a library of trajectories with MPCMotion on the simulated drivetrain, and with a baseline which tracks the
+ * wheel velocities of the trajectory with DriveLQR but doesn't correct the pose. For every run it reports:
+ * - the mean and worst wall clock time of an update, and the worst time multiplied by the scale, which estimates the
+ *   time on the brain. Compare it to the 10 ms period of the chassis
+ * - heap allocations per update
+ * - the mean iterations of the solver, and the fraction of solves that converged
+ * - the RMS, maximum and final position error relative to the trajectory
+ *
+ *   make -C host bench && host/build/bench/mpcBenchmark [options]
+ *
+ *   --scale factor  how many times slower the brain is than this machine. Default 20
+ *   --filter name   only run the trajectories whose name contains it
+ *
+ * The "saturating" trajectory asks for more than the motors can do, so it shows how both controllers degrade.
+ */
+#include "sim/sim.hpp"
+#include "sim/allocations.hpp"
+#include "hardware/encoder/motorEncoder.hpp"
+#include "hardware/imu/v5_imu.hpp"
+#include "hardware/sensorCache.hpp"
+#include "motion/mpc.hpp"
+#include "odometry/perpWheelOdom.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+// geometry of the simulated robot
+constexpr int IMU_PORT = 7;
+constexpr double GEAR_RATIO = 0.75;
+constexpr Length WHEEL_DIAMETER = 3.25_in;
+constexpr Length TRACK_WIDTH = 12_in;
+constexpr Time PERIOD = 10_ms;
+
+/**
+ * @brief velocity profile of a trajectory
+ *
+ */
+struct Profile {
+        const char* name;
+        Time duration;
+        std::function<std::pair<double, double>(double t)> velocity; /** meters and radians per second at a time */
+};
+
+// acceleration limited ramp up and down
+static double ramp(double t, double duration) { return std::clamp(std::min(t, duration - t) / 0.5, 0.0, 1.0); }
+
+static const std::vector<Profile> PROFILES = {
+    {"straight", 3_sec, [](double t) { return std::pair {1.5 * ramp(t, 3), 0.0}; }},
+    {"arc", 4_sec, [](double t) { return std::pair {0.8 * ramp(t, 4), 1.5 * ramp(t, 4)}; }},
+    {"s-curve", 5_sec,
+     [](double t) { return std::pair {1.0 * ramp(t, 5), 2.0 * std::sin(2 * M_PI * t / 2.5) * ramp(t, 5)}; }},
+    {"saturating", 4_sec,
+     [](double t) { return std::pair {2.0 * ramp(t, 4), 2.5 * std::sin(2 * M_PI * t / 2) * ramp(t, 4)}; }},
+};
+
+// integrate a profile into a trajectory, starting where the simulated robot starts
+static Trajectory integrate(const Profile& profile) {
+    std::vector<TrajectoryPoint> points;
+    double x = 0;
+    double y = 0;
+    double theta = M_PI / 2;
+    const double dt = to_sec(PERIOD);
+    for (double t = 0; t <= to_sec(profile.duration) + 1e-9; t += dt) {
+        const auto [velocity, angularVelocity] = profile.velocity(t);
+        points.push_back({from_sec(t), units::Pose(from_m(x), from_m(y), from_sRad(theta)), from_mps(velocity),
+                          from_radps(angularVelocity)});
+        const double heading = theta + angularVelocity * dt / 2;
+        x += velocity * std::cos(heading) * dt;
+        y += velocity * std::sin(heading) * dt;
+        theta += angularVelocity * dt;
+    }
+    return Trajectory(points);
+}
+
+/**
+ * @brief baseline, which tracks the wheel velocities of the trajectory without correcting the pose
+ *
+ */
+class VelocityMotion : public Motion {
+    public:
+        VelocityMotion(Trajectory trajectory, FeedforwardGains linear, FeedforwardGains angular,
+                       std::shared_ptr<MotorGroup> leftDrive, std::shared_ptr<MotorGroup> rightDrive)
+            : trajectory(std::move(trajectory)),
+              controller(linear, angular),
+              leftDrive(leftDrive),
+              rightDrive(rightDrive) {}
+
+        ChassisSpeeds update(units::Pose pose) override {
+            const Time now = Timer::now();
+            if (start == std::nullopt) start = now;
+            const Time elapsed = now - *start;
+            if (elapsed > trajectory.getDuration()) {
+                running = false;
+                return {false, 0_mps, 0_mps, 0, 0};
+            }
+            const auto wheels = [&](Time time) {
+                const TrajectoryPoint point = trajectory.sample(time);
+                const double turn = to_radps(point.angularVelocity) * to_m(TRACK_WIDTH) / 2;
+                return std::pair {to_mps(point.velocity) - turn, to_mps(point.velocity) + turn};
+            };
+            const auto [left, right] = wheels(elapsed);
+            const auto [nextLeft, nextRight] = wheels(elapsed + PERIOD);
+            const double radius = to_m(WHEEL_DIAMETER) / 2;
+            const DriveVoltages voltages = controller.update(
+                {(nextLeft - left) / to_sec(PERIOD), (nextRight - right) / to_sec(PERIOD), left, right,
+                 to_radps(leftDrive->getVelocity()) * radius, to_radps(rightDrive->getVelocity()) * radius},
+                PERIOD);
+            return {false, 0_mps, 0_mps, std::clamp(voltages.left / 12, -1.0, 1.0),
+                    std::clamp(voltages.right / 12, -1.0, 1.0)};
+        }
+    private:
+        const Trajectory trajectory;
+        DriveLQR controller;
+        const std::shared_ptr<MotorGroup> leftDrive;
+        const std::shared_ptr<MotorGroup> rightDrive;
+        std::optional<Time> start;
+};
+
+struct Result {
+        double meanUs = 0;
+        double worstUs = 0;
+        double allocationsPerUpdate = 0;
+        double meanIterations = 0;
+        double converged = 0; /** fraction of solves that converged */
+        double rmsError = 0; /** inches */
+        double maxError = 0; /** inches */
+        double finalError = 0; /** inches */
+};
+
+static Result run(const Profile& profile, bool mpc) {
+    sim::reset();
+    sim::DrivetrainState& drivetrain = sim::drivetrain();
+    drivetrain.leftMotors = {1, 2};
+    drivetrain.rightMotors = {3, 4};
+    drivetrain.imuPort = IMU_PORT;
+    drivetrain.gearRatio = GEAR_RATIO;
+    drivetrain.wheelDiameter = WHEEL_DIAMETER;
+    drivetrain.trackWidth = TRACK_WIDTH;
+    sim::imu(IMU_PORT).calibrationEnd = 0_sec;
+    auto leftDrive = std::make_shared<MotorGroup>(std::initializer_list<int> {1, 2}, Cartridge::BLUE, GEAR_RATIO);
+    auto rightDrive = std::make_shared<MotorGroup>(std::initializer_list<int> {3, 4}, Cartridge::BLUE, GEAR_RATIO);
+    // track with the left drive, which is to the left of the tracking center
+    auto vertical = std::make_shared<TrackingWheel>(std::make_shared<MotorEncoder>(leftDrive),
+                                                    WHEEL_DIAMETER / 2, TRACK_WIDTH / 2);
+    PerpWheelOdom odometry(vertical, nullptr, std::make_shared<V5IMU>(IMU_PORT));
+    odometry.calibrate();
+    odometry.setPose({0_m, 0_m, 90_stDeg});
+    // the model of the controllers is the model of the simulation
+    const FeedforwardGains linear {drivetrain.kS, drivetrain.kV, drivetrain.kA};
+    const FeedforwardGains angular {drivetrain.kS, drivetrain.kV, drivetrain.angularKA};
+    const Trajectory trajectory = integrate(profile);
+    std::unique_ptr<Motion> motion;
+    MPCMotion* mpcMotion = nullptr;
+    if (mpc) {
+        auto created = std::make_unique<MPCMotion>(trajectory, linear, angular, leftDrive, rightDrive, WHEEL_DIAMETER,
+                                                   TRACK_WIDTH);
+        mpcMotion = created.get();
+        motion = std::move(created);
+    } else {
+        motion = std::make_unique<VelocityMotion>(trajectory, linear, angular, leftDrive, rightDrive);
+    }
+    sim::runFor(PERIOD);
+    SensorCache::invalidate();
+    odometry.update();
+    const Time start = sim::now();
+    Result result;
+    int updates = 0;
+    double squaredError = 0;
+    std::chrono::nanoseconds elapsed {0};
+    sim::allocations = 0;
+    while (motion->isRunning()) {
+        SensorCache::invalidate();
+        const units::Pose pose = odometry.update();
+        sim::countAllocations = true;
+        const auto before = std::chrono::steady_clock::now();
+        const ChassisSpeeds speeds = motion->update(pose);
+        const std::chrono::nanoseconds time = std::chrono::steady_clock::now() - before;
+        sim::countAllocations = false;
+        if (!motion->isRunning()) break;
+        elapsed += time;
+        result.worstUs = std::max(result.worstUs, time.count() / 1000.0);
+        updates++;
+        if (mpcMotion != nullptr) {
+            result.meanIterations += mpcMotion->getStats().iterations;
+            result.converged += mpcMotion->getStats().converged;
+        }
+        leftDrive->moveVoltage(from_volt(speeds.leftPwr * 12));
+        rightDrive->moveVoltage(from_volt(speeds.rightPwr * 12));
+        sim::runFor(PERIOD);
+        // compare the true pose to the trajectory
+        units::Pose target = trajectory.sample(sim::now() - start).pose;
+        const double error =
+            std::hypot(drivetrain.x - to_m(target.getX()), drivetrain.y - to_m(target.getY())) / to_m(1_in);
+        squaredError += error * error;
+        result.maxError = std::max(result.maxError, error);
+        result.finalError = error;
+    }
+    leftDrive->moveVoltage(0_volt);
+    rightDrive->moveVoltage(0_volt);
+    result.meanUs = elapsed.count() / 1000.0 / updates;
+    result.allocationsPerUpdate = double(sim::allocations) / updates;
+    result.meanIterations /= updates;
+    result.converged /= updates;
+    result.rmsError = std::sqrt(squaredError / updates);
+    return result;
+}
+
+int main(int argc, char** argv) {
+    double scale = 20;
+    std::string filter;
+    for (int i = 1; i < argc; i++) {
+        const std::string arg = argv[i];
+        if (arg == "--scale" && i + 1 < argc) scale = std::stod(argv[++i]);
+        else if (arg == "--filter" && i + 1 < argc) filter = argv[++i];
+        else {
+            std::fprintf(stderr, "unknown or incomplete option %s, see the top of mpcBenchmark.cpp\n", arg.c_str());
+            return 1;
+        }
+    }
+    std::printf("%-11s %-9s %9s %9s %12s %7s %6s %6s %8s %8s %9s\n", "path", "control", "mean(us)", "worst(us)",
+                "brain(ms)", "allocs", "iters", "conv", "rms(in)", "max(in)", "final(in)");
+    for (const Profile& profile : PROFILES) {
+        if (std::string(profile.name).find(filter) == std::string::npos) continue;
+        for (bool mpc : {false, true}) {
+            const Result result = run(profile, mpc);
+            const double brain = result.worstUs * scale / 1000;
+            std::printf("%-11s %-9s %9.1f %9.1f %6.2f/%-4.0f %7.2f ", profile.name, mpc ? "mpc" : "velocity",
+                        result.meanUs, result.worstUs, brain, to_ms(PERIOD), result.allocationsPerUpdate);
+            // the baseline doesn't solve anything
+            if (mpc) std::printf("%6.1f %5.0f%% ", result.meanIterations, result.converged * 100);
+            else std::printf("%6s %6s ", "-", "-");
+            std::printf("%8.2f %8.2f %9.2f\n", result.rmsError, result.maxError, result.finalError);
+        }
+    }
+    std::exit(0);
+}
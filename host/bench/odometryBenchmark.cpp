@@ -0,0 +1,217 @@
+/**
+ * Odometry accuracy and throughput benchmark
+ *
+ * Drives every odometry implementation through a library of synthetic trajectories in the simulation, at several
+ * update rates and sensor noise levels, and compares the pose to the ground truth. For every run it reports:
+ * - the wall clock time of update(), which includes the mock device layer, so compare runs on the same machine
+ * - heap allocations per update()
+ * - the final and maximum position and heading error
+ *
+ *   make -C host bench && host/build/bench/odometryBenchmark [filter]
+ *
+ * The optional filter only runs the odometries and trajectories whose name contains it.
+ */
+#include "sim/sim.hpp"
+#include "sim/allocations.hpp"
+#include "hardware/encoder/rotation.hpp"
+#include "hardware/gps/v5_gps.hpp"
+#include "hardware/imu/v5_imu.hpp"
+#include "hardware/sensorCache.hpp"
+#include "odometry/fusedOdom.hpp"
+#include "odometry/perpWheelOdom.hpp"
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <random>
+#include <string>
+#include <vector>
+
+// ports of the simulated sensors
+constexpr int VERTICAL_PORT = 1;
+constexpr int HORIZONTAL_PORT = 2;
+constexpr int IMU_PORT = 3;
+constexpr int GPS_PORT = 4;
+// geometry of the simulated robot
+constexpr Length WHEEL_RADIUS = 1.375_in;
+constexpr Length VERTICAL_OFFSET = -1.5_in; // to the right of the tracking center
+constexpr Length HORIZONTAL_OFFSET = -3_in; // behind the tracking center
+
+/**
+ * @brief velocity of the robot in its own frame, and how well the tracking wheels grip
+ *
+ */
+struct Motion {
+        double forward; /** meters per second */
+        double sideways; /** meters per second, to the right */
+        double angular; /** radians per second, counterclockwise */
+        double verticalGrip = 1; /** fraction of its travel the vertical wheel measures */
+        double horizontalGrip = 1; /** fraction of its travel the horizontal wheel measures */
+};
+
+struct Trajectory {
+        const char* name;
+        Time duration;
+        std::function<Motion(double t)> motion; /** motion at a time in seconds */
+};
+
+struct NoiseLevel {
+        const char* name;
+        double imuNoise; /** standard deviation of the IMU rotation, in degrees */
+        double wheelScale; /** scale error of the tracking wheels */
+        double gpsNoise; /** standard deviation of the GPS position, in meters */
+};
+
+struct OdometryType {
+        const char* name;
+        bool gps; /** whether the GPS is fused */
+};
+
+// acceleration limited profile, so the trajectories are ones a drivetrain could follow
+static double ramp(double t, double duration) { return std::clamp(std::min(t, duration - t) / 0.3, 0.0, 1.0); }
+
+static const std::vector<Trajectory> TRAJECTORIES = {
+    {"straight", 3_sec, [](double t) { return Motion {1.2 * ramp(t, 3), 0, 0}; }},
+    {"arc", 4_sec, [](double t) { return Motion {0.8 * ramp(t, 4), 0, 0.8 * ramp(t, 4)}; }},
+    {"s-curve", 6_sec,
+     [](double t) { return Motion {0.8 * ramp(t, 6), 0, 1.2 * std::sin(2 * M_PI * t / 3) * ramp(t, 6)}; }},
+    {"spin", 3_sec, [](double t) { return Motion {0, 0, 6 * ramp(t, 3)}; }},
+    {"slip", 3_sec,
+     [](double t) {
+         Motion motion {1.2 * ramp(t, 3), 0, 0};
+         // the vertical wheel loses contact crossing a bump, then the robot is pushed sideways
+         if (t > 1 && t < 1.3) motion.verticalGrip = 0.5;
+         if (t > 2 && t < 2.3) motion.sideways = 0.3;
+         return motion;
+     }},
+};
+
+static const std::vector<NoiseLevel> NOISE_LEVELS = {{"none", 0, 1, 0}, {"low", 0.05, 1.005, 0.01},
+                                                     {"high", 0.3, 1.02, 0.03}};
+
+static const std::vector<Time> PERIODS = {5_ms, 10_ms, 20_ms};
+
+static const std::vector<OdometryType> ODOMETRIES = {{"PerpWheelOdom", false}, {"FusedOdom", true}};
+
+/**
+ * @brief ground truth of a run, updated by the simulation every step
+ *
+ */
+struct Truth {
+        double x = 0;
+        double y = 0;
+        double theta = M_PI / 2;
+        double vertical = 0; /** distance measured by the vertical wheel, in meters */
+        double horizontal = 0; /** distance measured by the horizontal wheel, in meters */
+        std::optional<Time> start; /** when the robot starts moving, unset while the odometry is set up */
+};
+
+struct Result {
+        double nsPerUpdate;
+        double allocationsPerUpdate;
+        Length finalError;
+        Length maxError;
+        Angle finalHeadingError;
+        Angle maxHeadingError;
+};
+
+static Result run(const OdometryType& type, const Trajectory& trajectory, const NoiseLevel& noise, Time period) {
+    sim::reset();
+    auto truth = std::make_shared<Truth>();
+    std::mt19937 rng(1);
+    sim::onStep([=](Time now, Time dt) mutable {
+        if (truth->start == std::nullopt) return;
+        const double t = to_sec(now - *truth->start);
+        if (t > to_sec(trajectory.duration)) return;
+        const Motion motion = trajectory.motion(t);
+        const double step = to_sec(dt);
+        // integrate the pose with the heading halfway through the step
+        const double dTheta = motion.angular * step;
+        const double heading = truth->theta + dTheta / 2;
+        truth->x += (motion.forward * std::cos(heading) + motion.sideways * std::sin(heading)) * step;
+        truth->y += (motion.forward * std::sin(heading) - motion.sideways * std::cos(heading)) * step;
+        truth->theta += dTheta;
+        // each tracking wheel measures the velocity of the point it touches the ground at
+        truth->vertical +=
+            (motion.forward - motion.angular * to_m(VERTICAL_OFFSET)) * step * motion.verticalGrip * noise.wheelScale;
+        truth->horizontal += (motion.sideways - motion.angular * to_m(HORIZONTAL_OFFSET)) * step *
+                             motion.horizontalGrip * noise.wheelScale;
+        sim::rotation(VERTICAL_PORT).position = std::lround(truth->vertical / to_m(WHEEL_RADIUS) * 18000 / M_PI);
+        sim::rotation(HORIZONTAL_PORT).position = std::lround(truth->horizontal / to_m(WHEEL_RADIUS) * 18000 / M_PI);
+        std::normal_distribution<double> imuNoise(0, noise.imuNoise);
+        sim::imu(IMU_PORT).rotation = 90 - truth->theta * 180 / M_PI + (noise.imuNoise > 0 ? imuNoise(rng) : 0);
+        sim::imu(IMU_PORT).gyroZ = motion.angular * 180 / M_PI;
+        sim::gps(GPS_PORT).x = truth->x;
+        sim::gps(GPS_PORT).y = truth->y;
+        sim::gps(GPS_PORT).heading = 90 - truth->theta * 180 / M_PI;
+    });
+    sim::imu(IMU_PORT).calibrationEnd = 0_sec;
+    if (type.gps) sim::gps(GPS_PORT).noise = noise.gpsNoise;
+    // build the odometry
+    auto vertical =
+        std::make_shared<TrackingWheel>(std::make_shared<Rotation>(VERTICAL_PORT), WHEEL_RADIUS, VERTICAL_OFFSET);
+    auto horizontal =
+        std::make_shared<TrackingWheel>(std::make_shared<Rotation>(HORIZONTAL_PORT), WHEEL_RADIUS, HORIZONTAL_OFFSET);
+    std::shared_ptr<Odometry> odometry =
+        std::make_shared<PerpWheelOdom>(vertical, horizontal, std::make_shared<V5IMU>(IMU_PORT));
+    if (type.gps) odometry = std::make_shared<FusedOdom>(odometry, std::make_shared<V5GPS>(GPS_PORT));
+    odometry->calibrate();
+    odometry->setPose({0_m, 0_m, 90_stDeg});
+    // let the GPS publish a fix of the starting pose before the robot moves, and update once so the robot's motion
+    // is measured from the start
+    sim::runFor(100_ms);
+    SensorCache::invalidate();
+    odometry->update();
+    truth->start = sim::now();
+    // run the trajectory, and some more so the robot comes to a stop
+    Result result {};
+    int updates = 0;
+    std::chrono::nanoseconds elapsed {0};
+    sim::allocations = 0;
+    while (sim::now() - *truth->start < trajectory.duration + 200_ms) {
+        sim::runFor(period);
+        SensorCache::invalidate();
+        sim::countAllocations = true;
+        const auto before = std::chrono::steady_clock::now();
+        units::Pose pose = odometry->update();
+        elapsed += std::chrono::steady_clock::now() - before;
+        sim::countAllocations = false;
+        updates++;
+        // compare to the ground truth
+        const Length error = units::hypot(pose.getX() - from_m(truth->x), pose.getY() - from_m(truth->y));
+        const Angle headingError = units::abs(from_sRad(std::remainder(to_sRad(pose.getTheta()) - truth->theta,
+                                                                       2 * M_PI)));
+        result.maxError = std::max(result.maxError, error);
+        result.maxHeadingError = std::max(result.maxHeadingError, headingError);
+        result.finalError = error;
+        result.finalHeadingError = headingError;
+    }
+    result.nsPerUpdate = double(elapsed.count()) / updates;
+    result.allocationsPerUpdate = double(sim::allocations) / updates;
+    return result;
+}
+
+int main(int argc, char** argv) {
+    const std::string filter = argc > 1 ? argv[1] : "";
+    std::printf("%-14s %-9s %-6s %6s %10s %8s %10s %10s %10s %10s\n", "odometry", "path", "noise", "period",
+                "ns/update", "allocs", "final(in)", "max(in)", "final(deg)", "max(deg)");
+    for (const OdometryType& type : ODOMETRIES) {
+        for (const Trajectory& trajectory : TRAJECTORIES) {
+            if (std::string(type.name).find(filter) == std::string::npos &&
+                std::string(trajectory.name).find(filter) == std::string::npos)
+                continue;
+            for (const NoiseLevel& noise : NOISE_LEVELS) {
+                for (Time period : PERIODS) {
+                    const Result result = run(type, trajectory, noise, period);
+                    std::printf("%-14s %-9s %-6s %4.0fms %10.0f %8.2f %10.3f %10.3f %10.3f %10.3f\n", type.name,
+                                trajectory.name, noise.name, to_ms(period), result.nsPerUpdate,
+                                result.allocationsPerUpdate, to_in(result.finalError), to_in(result.maxError),
+                                to_sDeg(result.finalHeadingError), to_sDeg(result.maxHeadingError));
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,31 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+
+/**
+ * @brief count the heap allocations of a host program
+ *
+ * Replaces the global operator new, so a benchmark can check that code meant for the chassis task doesn't allocate:
+ * reset sim::allocations, set sim::countAllocations around the code, and read sim::allocations after. A program can
+ * only replace operator new once, so include this from a single source file, like the one of a benchmark.
+ */
+namespace sim {
+inline std::atomic<bool> countAllocations = false; /** whether allocations are counted */
+inline std::atomic<uint64_t> allocations = 0; /** allocations counted so far */
+} // namespace sim
+
+// GCC can't tell the replaced operator new allocates with malloc, so it warns about the free in operator delete
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+
+void* operator new(size_t size) {
+    if (sim::countAllocations) sim::allocations++;
+    if (void* ptr = std::malloc(size == 0 ? 1 : size)) return ptr;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+
+void operator delete(void* ptr, size_t) noexcept { std::free(ptr); }
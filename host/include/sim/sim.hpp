@@ -0,0 +1,252 @@
+#pragma once
+
+#include "units/units.hpp"
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+/**
+ * @brief host simulation of the PROS devices and scheduler
+ *
+ * The host build links the robot code against a mock of the PROS API instead of the real kernel. Every smart port
+ * holds the state of a simulated device, which tests and tools read and write directly through this namespace.
+ *
+ * Time is virtual: it only advances when every task is waiting in pros::delay, at which point the clock jumps to
+ * the earliest wake up time in 1 ms steps. Tasks run one at a time, so the robot code never races with the
+ * simulation, and a run is deterministic and as fast as the host can execute it. A task that never delays blocks
+ * every other task, just like it would on the brain.
+ */
+namespace sim {
+/**
+ * @brief state of a simulated rotation sensor
+ *
+ * Values are in the units of the PROS API, as seen by the robot code with the sensor not reversed
+ */
+struct RotationState {
+        bool installed = true; /** whether a rotation sensor is plugged into the port */
+        int32_t position = 0; /** position of the sensor, in centidegrees */
+        int32_t velocity = 0; /** velocity of the sensor, in centidegrees per second */
+        bool reversed = false; /** whether the sensor is reversed */
+};
+
+/**
+ * @brief state of a simulated inertial sensor
+ *
+ * Angles are in degrees and are the true orientation of the sensor. The offsets are written by the tare and set
+ * functions of the PROS API, and are added to the true orientation when it is read
+ */
+struct ImuState {
+        bool installed = true; /** whether an inertial sensor is plugged into the port */
+        Time calibrationTime = 2_sec; /** how long the sensor calibrates for after it is reset */
+        Time calibrationEnd = 2_sec; /** the time the current calibration ends. The sensor calibrates when it boots */
+        double rotation = 0; /** total rotation around the z axis, clockwise positive */
+        double pitch = 0; /** rotation around the y axis */
+        double roll = 0; /** rotation around the x axis */
+        double rotationOffset = 0;
+        double headingOffset = 0;
+        double yawOffset = 0;
+        double pitchOffset = 0;
+        double rollOffset = 0;
+        double gyroX = 0; /** angular velocity around the x axis, in degrees per second */
+        double gyroY = 0; /** angular velocity around the y axis, in degrees per second */
+        double gyroZ = 0; /** angular velocity around the z axis, in degrees per second. Counterclockwise positive */
+        double accelX = 0; /** acceleration along the x axis, in g */
+        double accelY = 0; /** acceleration along the y axis, in g */
+        double accelZ = 1; /** acceleration along the z axis, in g */
+};
+
+/**
+ * @brief state of a simulated smart motor
+ *
+ * The motor doesn't move by itself. Scripts read the commanded voltage or velocity and write the position,
+ * velocity, current and temperature, usually from a step callback
+ */
+struct MotorState {
+        bool installed = true; /** whether a motor is plugged into the port */
+        int gearset = 1; /** the gearset set by the robot code, 0 for red, 1 for green and 2 for blue */
+        bool velocityMode = false; /** whether the motor was last commanded a velocity instead of a voltage */
+        int32_t voltage = 0; /** commanded voltage, in millivolts */
+        int32_t targetVelocity = 0; /** commanded velocity, in rpm */
+        double position = 0; /** position of the motor output, in degrees */
+        double velocity = 0; /** velocity of the motor output, in rpm */
+        int32_t current = 0; /** current drawn by the motor, in milliamps */
+        double temperature = 25; /** temperature of the motor, in degrees C */
+};
+
+/**
+ * @brief state of a simulated distance sensor
+ *
+ * Scripts usually compute the distance from the simulated pose of the robot every step
+ */
+struct DistanceState {
+        bool installed = true; /** whether a distance sensor is plugged into the port */
+        int32_t distance = 9999; /** distance to the object in front of the sensor in mm, 9999 if there is none */
+        int32_t confidence = 63; /** confidence of the reading, from 0 to 63 */
+};
+
+/**
+ * @brief state of a simulated GPS sensor
+ *
+ * Scripts write the true pose of the tracking center. Every period, the simulation publishes a fix of the pose it
+ * had a latency ago, with gaussian noise added, which is what the PROS API returns
+ */
+struct GpsState {
+        bool installed = true; /** whether a GPS is plugged into the port */
+        bool calibrating = false; /** whether the GPS is still calibrating, or can't see the field strip */
+        double x = 0; /** true x position of the tracking center, in meters */
+        double y = 0; /** true y position of the tracking center, in meters */
+        double heading = 0; /** true heading, in compass degrees */
+        Time latency = 40_ms; /** how old a fix is when it is published */
+        Time period = 20_ms; /** how often a fix is published */
+        double noise = 0.01; /** standard deviation of the noise added to the position, in meters */
+        double error = 0.02; /** error reported by the GPS, in meters */
+        double offsetX = 0; /** offset of the sensor set by the robot code, in meters */
+        double offsetY = 0; /** offset of the sensor set by the robot code, in meters */
+        double fixX = 0; /** x position of the last published fix, in meters */
+        double fixY = 0; /** y position of the last published fix, in meters */
+        double fixHeading = 0; /** heading of the last published fix, in compass degrees */
+};
+
+/**
+ * @brief state of a simulated ADI quadrature encoder
+ *
+ * The count is what the PROS API returns for an encoder initialized without reversing it
+ */
+struct AdiEncoderState {
+        int32_t ticks = 0; /** count of the encoder, 360 per rotation */
+};
+
+/**
+ * @brief state of a simulated differential drivetrain
+ *
+ * Each side is driven by the mean voltage commanded to its motors, and follows
+ * voltage = kS * sign(velocity) + kV * velocity + kA * acceleration, with the wheel velocity in meters per second.
+ * Turning in place accelerates the robot's moment of inertia instead of its mass, so it has its own kA. The motors
+ * respond to a new voltage after a delay.
+ *
+ * Every step, the drivetrain moves its true pose, and writes the position and velocity of its motors and the
+ * rotation of its inertial sensor. Motors commanded a velocity are driven by the voltage they were last commanded
+ */
+struct DrivetrainState {
+        std::vector<int> leftMotors; /** ports of the left motors, negative if the motor is reversed */
+        std::vector<int> rightMotors; /** ports of the right motors, negative if the motor is reversed */
+        int imuPort = 0; /** port of the inertial sensor the drivetrain writes, 0 for none */
+        double gearRatio = 1; /** rotations of the wheels per rotation of the motor outputs */
+        Length wheelDiameter = 3.25_in;
+        Length trackWidth = 12_in;
+        double kS = 1; /** volts to overcome static friction */
+        double kV = 5.5; /** volts per meter per second */
+        double kA = 1; /** volts per meter per second squared, driving straight */
+        double angularKA = 1.5; /** volts per meter per second squared of the wheels, turning in place */
+        Time delay = 10_ms; /** how long the motors take to respond to a new voltage */
+        double x = 0; /** true x position of the center of the drivetrain, in meters */
+        double y = 0; /** true y position of the center of the drivetrain, in meters */
+        double theta = M_PI / 2; /** true heading, in radians counterclockwise from the x axis */
+        double leftVelocity = 0; /** true velocity of the left wheels, in meters per second */
+        double rightVelocity = 0; /** true velocity of the right wheels, in meters per second */
+        double leftForce = 0; /** external force on the left wheels, like a bump or a push, in volts. Positive is
+                                 forwards */
+        double rightForce = 0; /** external force on the right wheels, in volts. Positive is forwards */
+};
+
+/**
+ * @brief Get the simulated rotation sensor on a port
+ *
+ * @param port the port, from 1 to 21
+ * @return RotationState& reference to the state, which stays valid until reset() is called
+ */
+RotationState& rotation(int port);
+/**
+ * @brief Get the simulated inertial sensor on a port
+ *
+ * @param port the port, from 1 to 21
+ * @return ImuState& reference to the state, which stays valid until reset() is called
+ */
+ImuState& imu(int port);
+/**
+ * @brief Get the simulated motor on a port
+ *
+ * @param port the port, from 1 to 21
+ * @return MotorState& reference to the state, which stays valid until reset() is called
+ */
+MotorState& motor(int port);
+/**
+ * @brief Get the simulated distance sensor on a port
+ *
+ * @param port the port, from 1 to 21
+ * @return DistanceState& reference to the state, which stays valid until reset() is called
+ */
+DistanceState& distance(int port);
+/**
+ * @brief Get the simulated GPS on a port
+ *
+ * @param port the port, from 1 to 21
+ * @return GpsState& reference to the state, which stays valid until reset() is called
+ */
+GpsState& gps(int port);
+/**
+ * @brief Get the simulated ADI encoder on a pair of ports
+ *
+ * @param topPort the top port of the encoder, from 1 to 8 for ports A to H
+ * @return AdiEncoderState& reference to the state, which stays valid until reset() is called
+ */
+AdiEncoderState& adiEncoder(int topPort);
+/**
+ * @brief Get the simulated drivetrain
+ *
+ * The drivetrain is created by the first call, and is only simulated after that
+ *
+ * @return DrivetrainState& reference to the state, which stays valid until reset() is called
+ */
+DrivetrainState& drivetrain();
+/**
+ * @brief Set the competition status returned by the PROS API
+ *
+ * @param status bitmask of the status. Bit 0 is set when disabled, bit 1 in autonomous, and bit 2 when connected
+ */
+void setCompetitionStatus(uint8_t status);
+/**
+ * @brief Set the battery voltage returned by the PROS API
+ *
+ * The simulated drivetrain can't apply more than the battery voltage. Defaults to 12.8 volts, a full battery
+ *
+ * @param voltage the battery voltage
+ */
+void setBatteryVoltage(Voltage voltage);
+/**
+ * @brief Get the virtual time since the simulation started
+ *
+ * @return Time
+ */
+Time now();
+/**
+ * @brief Get the virtual time since the simulation started in microseconds
+ *
+ * @return uint64_t
+ */
+uint64_t micros();
+/**
+ * @brief add a callback which is called every time the virtual clock advances by 1 ms
+ *
+ * This is where scripts update the simulated devices, for example by integrating a model of the drivetrain. The
+ * callback runs while every task is waiting, so it can read and write device state freely
+ *
+ * @param callback the callback, which takes the current time and the time since the last step
+ */
+void onStep(std::function<void(Time now, Time dt)> callback);
+/**
+ * @brief let the tasks run until the virtual clock advances by an amount of time
+ *
+ * This is the same as calling pros::delay from the current task
+ *
+ * @param time how long to run for
+ */
+void runFor(Time time);
+/**
+ * @brief reset the simulated devices, the step callbacks, the competition status and the random number generator
+ *
+ * Tasks that are already running keep running, and the virtual clock keeps counting, so this should be called
+ * before any tasks are created
+ */
+void reset();
+} // namespace sim
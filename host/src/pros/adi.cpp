@@ -0,0 +1,44 @@
+#include "sim/internal.hpp"
+#include "pros/adi.h"
+#include "pros/error.h"
+#include <cerrno>
+
+// the handle of a simulated encoder is its top port, with bit 8 set if it is reversed
+constexpr int32_t REVERSED = 1 << 8;
+
+// convert a port given as 'A' to 'H', 'a' to 'h' or 1 to 8 to a number from 1 to 8, or 0 if it isn't valid
+static int toPort(uint8_t port) {
+    if (port >= 'a' && port <= 'h') return port - 'a' + 1;
+    if (port >= 'A' && port <= 'H') return port - 'A' + 1;
+    if (port >= 1 && port <= 8) return port;
+    return 0;
+}
+
+pros::c::adi_encoder_t pros::c::adi_encoder_init(uint8_t port_top, uint8_t port_bottom, bool reverse) {
+    const int top = toPort(port_top);
+    const int bottom = toPort(port_bottom);
+    // the top port has to be odd, and the bottom port has to be the one after it
+    if (top == 0 || top % 2 == 0 || bottom != top + 1) {
+        errno = ENXIO;
+        return PROS_ERR;
+    }
+    return top | (reverse ? REVERSED : 0);
+}
+
+int32_t pros::c::adi_encoder_get(adi_encoder_t enc) {
+    if (enc == PROS_ERR) {
+        errno = ENXIO;
+        return PROS_ERR;
+    }
+    const int32_t ticks = sim::adiEncoder(enc & ~REVERSED).ticks;
+    return (enc & REVERSED) ? -ticks : ticks;
+}
+
+int32_t pros::c::adi_encoder_reset(adi_encoder_t enc) {
+    if (enc == PROS_ERR) {
+        errno = ENXIO;
+        return PROS_ERR;
+    }
+    sim::adiEncoder(enc & ~REVERSED).ticks = 0;
+    return 1;
+}
@@ -0,0 +1,16 @@
+#include "sim/internal.hpp"
+#include "pros/device.hpp"
+
+pros::Device::Device(const std::uint8_t port)
+    : _port(port) {}
+
+std::uint8_t pros::Device::get_port() const { return _port; }
+
+bool pros::Device::is_installed() {
+    switch (_deviceType) {
+        case pros::DeviceType::rotation: return sim::rotation(_port).installed;
+        case pros::DeviceType::imu: return sim::imu(_port).installed;
+        case pros::DeviceType::motor: return sim::motor(_port).installed;
+        default: return false;
+    }
+}
@@ -0,0 +1,30 @@
+#include "sim/internal.hpp"
+#include "pros/distance.h"
+#include "pros/error.h"
+#include <cerrno>
+
+// get the state of the distance sensor on a port, or nullptr and set errno if there is none
+static sim::DistanceState* getDistance(uint8_t port) {
+    if (port < 1 || port > 21) {
+        errno = ENXIO;
+        return nullptr;
+    }
+    sim::DistanceState& state = sim::distance(port);
+    if (!state.installed) {
+        errno = ENODEV;
+        return nullptr;
+    }
+    return &state;
+}
+
+int32_t pros::c::distance_get(uint8_t port) {
+    sim::DistanceState* state = getDistance(port);
+    if (state == nullptr) return PROS_ERR;
+    return state->distance;
+}
+
+int32_t pros::c::distance_get_confidence(uint8_t port) {
+    sim::DistanceState* state = getDistance(port);
+    if (state == nullptr) return PROS_ERR;
+    return state->confidence;
+}
@@ -0,0 +1,53 @@
+#include "sim/internal.hpp"
+#include "pros/gps.h"
+#include "pros/error.h"
+#include <cerrno>
+#include <cmath>
+
+// get the state of the GPS on a port, or nullptr and set errno if there is none or it is calibrating
+static sim::GpsState* getGps(uint8_t port, bool allowCalibrating = false) {
+    if (port < 1 || port > 21) {
+        errno = ENXIO;
+        return nullptr;
+    }
+    sim::GpsState& state = sim::gps(port);
+    if (!state.installed) {
+        errno = ENODEV;
+        return nullptr;
+    }
+    if (state.calibrating && !allowCalibrating) {
+        errno = EAGAIN;
+        return nullptr;
+    }
+    return &state;
+}
+
+int32_t pros::c::gps_set_offset(uint8_t port, double xOffset, double yOffset) {
+    sim::GpsState* state = getGps(port, true);
+    if (state == nullptr) return PROS_ERR;
+    state->offsetX = xOffset;
+    state->offsetY = yOffset;
+    return 1;
+}
+
+// the position only seeds the real sensor until it sees the field strip, so the simulation ignores it
+int32_t pros::c::gps_set_position(uint8_t port, double xInitial, double yInitial, double headingInitial) {
+    if (getGps(port, true) == nullptr) return PROS_ERR;
+    return 1;
+}
+
+double pros::c::gps_get_error(uint8_t port) {
+    sim::GpsState* state = getGps(port);
+    if (state == nullptr) return PROS_ERR_F;
+    return state->error;
+}
+
+pros::gps_status_s_t pros::c::gps_get_position_and_orientation(uint8_t port) {
+    sim::GpsState* state = getGps(port);
+    if (state == nullptr) return {PROS_ERR_F, PROS_ERR_F, PROS_ERR_F, PROS_ERR_F, PROS_ERR_F};
+    // the heading is reported from -180 to 180 degrees
+    double yaw = std::fmod(state->fixHeading, 360);
+    if (yaw > 180) yaw -= 360;
+    else if (yaw < -180) yaw += 360;
+    return {state->fixX, state->fixY, 0, 0, yaw};
+}
@@ -0,0 +1,247 @@
+#include "sim/internal.hpp"
+#include "pros/imu.hpp"
+#include "pros/rtos.hpp"
+#include "pros/error.h"
+#include <cerrno>
+#include <cmath>
+
+// get the state of the inertial sensor on a port, or nullptr and set errno if there is none or it is calibrating
+static sim::ImuState* getImu(uint8_t port, bool allowCalibrating = false) {
+    if (port < 1 || port > 21) {
+        errno = ENXIO;
+        return nullptr;
+    }
+    sim::ImuState& state = sim::imu(port);
+    if (!state.installed) {
+        errno = ENODEV;
+        return nullptr;
+    }
+    if (!allowCalibrating && sim::now() < state.calibrationEnd) {
+        errno = EAGAIN;
+        return nullptr;
+    }
+    return &state;
+}
+
+// wrap an angle in degrees to the range [min, min + 360)
+static double wrap(double angle, double min) { return angle - 360 * std::floor((angle - min) / 360); }
+
+int32_t pros::c::imu_reset(uint8_t port) {
+    sim::ImuState* state = getImu(port, true);
+    if (state == nullptr) return PROS_ERR;
+    state->calibrationEnd = sim::now() + state->calibrationTime;
+    // the sensor zeroes its orientation when it calibrates
+    state->rotationOffset = -state->rotation;
+    state->headingOffset = -state->rotation;
+    state->yawOffset = -state->rotation;
+    state->pitchOffset = -state->pitch;
+    state->rollOffset = -state->roll;
+    return 1;
+}
+
+int32_t pros::c::imu_reset_blocking(uint8_t port) {
+    if (imu_reset(port) == PROS_ERR) return PROS_ERR;
+    while (sim::now() < sim::imu(port).calibrationEnd) pros::c::delay(10);
+    return 1;
+}
+
+int32_t pros::c::imu_set_data_rate(uint8_t port, uint32_t rate) {
+    if (getImu(port) == nullptr) return PROS_ERR;
+    return 1;
+}
+
+double pros::c::imu_get_rotation(uint8_t port) {
+    sim::ImuState* state = getImu(port);
+    if (state == nullptr) return PROS_ERR_F;
+    return state->rotation + state->rotationOffset;
+}
+
+double pros::c::imu_get_heading(uint8_t port) {
+    sim::ImuState* state = getImu(port);
+    if (state == nullptr) return PROS_ERR_F;
+    return wrap(state->rotation + state->headingOffset, 0);
+}
+
+pros::quaternion_s_t pros::c::imu_get_quaternion(uint8_t port) {
+    const euler_s_t euler = imu_get_euler(port);
+    if (euler.yaw == PROS_ERR_F) return {PROS_ERR_F, PROS_ERR_F, PROS_ERR_F, PROS_ERR_F};
+    // convert the euler angles to a quaternion, using the z-y-x convention
+    const double yaw = euler.yaw * M_PI / 360, pitch = euler.pitch * M_PI / 360, roll = euler.roll * M_PI / 360;
+    const double cy = std::cos(yaw), sy = std::sin(yaw);
+    const double cp = std::cos(pitch), sp = std::sin(pitch);
+    const double cr = std::cos(roll), sr = std::sin(roll);
+    return {sr * cp * cy - cr * sp * sy, cr * sp * cy + sr * cp * sy, cr * cp * sy - sr * sp * cy,
+            cr * cp * cy + sr * sp * sy};
+}
+
+pros::euler_s_t pros::c::imu_get_euler(uint8_t port) {
+    sim::ImuState* state = getImu(port);
+    if (state == nullptr) return {PROS_ERR_F, PROS_ERR_F, PROS_ERR_F};
+    return {imu_get_pitch(port), imu_get_roll(port), imu_get_yaw(port)};
+}
+
+pros::imu_gyro_s_t pros::c::imu_get_gyro_rate(uint8_t port) {
+    sim::ImuState* state = getImu(port);
+    if (state == nullptr) return {PROS_ERR_F, PROS_ERR_F, PROS_ERR_F};
+    return {state->gyroX, state->gyroY, state->gyroZ};
+}
+
+pros::imu_accel_s_t pros::c::imu_get_accel(uint8_t port) {
+    sim::ImuState* state = getImu(port);
+    if (state == nullptr) return {PROS_ERR_F, PROS_ERR_F, PROS_ERR_F};
+    return {state->accelX, state->accelY, state->accelZ};
+}
+
+pros::imu_status_e_t pros::c::imu_get_status(uint8_t port) {
+    sim::ImuState* state = getImu(port, true);
+    if (state == nullptr) return E_IMU_STATUS_ERROR;
+    return sim::now() < state->calibrationEnd ? E_IMU_STATUS_CALIBRATING : E_IMU_STATUS_READY;
+}
+
+double pros::c::imu_get_pitch(uint8_t port) {
+    sim::ImuState* state = getImu(port);
+    if (state == nullptr) return PROS_ERR_F;
+    return wrap(state->pitch + state->pitchOffset, -180);
+}
+
+double pros::c::imu_get_roll(uint8_t port) {
+    sim::ImuState* state = getImu(port);
+    if (state == nullptr) return PROS_ERR_F;
+    return wrap(state->roll + state->rollOffset, -180);
+}
+
+double pros::c::imu_get_yaw(uint8_t port) {
+    sim::ImuState* state = getImu(port);
+    if (state == nullptr) return PROS_ERR_F;
+    return wrap(state->rotation + state->yawOffset, -180);
+}
+
+int32_t pros::c::imu_tare_heading(uint8_t port) { return imu_set_heading(port, 0); }
+
+int32_t pros::c::imu_tare_rotation(uint8_t port) { return imu_set_rotation(port, 0); }
+
+int32_t pros::c::imu_tare_pitch(uint8_t port) { return imu_set_pitch(port, 0); }
+
+int32_t pros::c::imu_tare_roll(uint8_t port) { return imu_set_roll(port, 0); }
+
+int32_t pros::c::imu_tare_yaw(uint8_t port) { return imu_set_yaw(port, 0); }
+
+int32_t pros::c::imu_tare_euler(uint8_t port) { return imu_set_euler(port, {0, 0, 0}); }
+
+int32_t pros::c::imu_tare(uint8_t port) {
+    if (imu_tare_euler(port) == PROS_ERR) return PROS_ERR;
+    if (imu_tare_rotation(port) == PROS_ERR) return PROS_ERR;
+    return imu_tare_heading(port);
+}
+
+int32_t pros::c::imu_set_euler(uint8_t port, euler_s_t target) {
+    if (imu_set_pitch(port, target.pitch) == PROS_ERR) return PROS_ERR;
+    if (imu_set_roll(port, target.roll) == PROS_ERR) return PROS_ERR;
+    return imu_set_yaw(port, target.yaw);
+}
+
+int32_t pros::c::imu_set_rotation(uint8_t port, double target) {
+    sim::ImuState* state = getImu(port);
+    if (state == nullptr) return PROS_ERR;
+    state->rotationOffset = target - state->rotation;
+    return 1;
+}
+
+int32_t pros::c::imu_set_heading(uint8_t port, double target) {
+    sim::ImuState* state = getImu(port);
+    if (state == nullptr) return PROS_ERR;
+    state->headingOffset = target - state->rotation;
+    return 1;
+}
+
+int32_t pros::c::imu_set_pitch(uint8_t port, double target) {
+    sim::ImuState* state = getImu(port);
+    if (state == nullptr) return PROS_ERR;
+    state->pitchOffset = target - state->pitch;
+    return 1;
+}
+
+int32_t pros::c::imu_set_roll(uint8_t port, double target) {
+    sim::ImuState* state = getImu(port);
+    if (state == nullptr) return PROS_ERR;
+    state->rollOffset = target - state->roll;
+    return 1;
+}
+
+int32_t pros::c::imu_set_yaw(uint8_t port, double target) {
+    sim::ImuState* state = getImu(port);
+    if (state == nullptr) return PROS_ERR;
+    state->yawOffset = target - state->rotation;
+    return 1;
+}
+
+pros::imu_orientation_e_t pros::c::imu_get_physical_orientation(uint8_t port) {
+    if (getImu(port, true) == nullptr) return E_IMU_ORIENTATION_ERROR;
+    return E_IMU_Z_UP;
+}
+
+std::int32_t pros::Imu::reset(bool blocking) const {
+    return blocking ? pros::c::imu_reset_blocking(_port) : pros::c::imu_reset(_port);
+}
+
+std::int32_t pros::Imu::set_data_rate(std::uint32_t rate) const { return pros::c::imu_set_data_rate(_port, rate); }
+
+double pros::Imu::get_rotation() const { return pros::c::imu_get_rotation(_port); }
+
+double pros::Imu::get_heading() const { return pros::c::imu_get_heading(_port); }
+
+pros::quaternion_s_t pros::Imu::get_quaternion() const { return pros::c::imu_get_quaternion(_port); }
+
+pros::euler_s_t pros::Imu::get_euler() const { return pros::c::imu_get_euler(_port); }
+
+double pros::Imu::get_pitch() const { return pros::c::imu_get_pitch(_port); }
+
+double pros::Imu::get_roll() const { return pros::c::imu_get_roll(_port); }
+
+double pros::Imu::get_yaw() const { return pros::c::imu_get_yaw(_port); }
+
+pros::imu_gyro_s_t pros::Imu::get_gyro_rate() const { return pros::c::imu_get_gyro_rate(_port); }
+
+std::int32_t pros::Imu::tare_rotation() const { return pros::c::imu_tare_rotation(_port); }
+
+std::int32_t pros::Imu::tare_heading() const { return pros::c::imu_tare_heading(_port); }
+
+std::int32_t pros::Imu::tare_pitch() const { return pros::c::imu_tare_pitch(_port); }
+
+std::int32_t pros::Imu::tare_yaw() const { return pros::c::imu_tare_yaw(_port); }
+
+std::int32_t pros::Imu::tare_roll() const { return pros::c::imu_tare_roll(_port); }
+
+std::int32_t pros::Imu::tare() const { return pros::c::imu_tare(_port); }
+
+std::int32_t pros::Imu::tare_euler() const { return pros::c::imu_tare_euler(_port); }
+
+std::int32_t pros::Imu::set_heading(const double target) const { return pros::c::imu_set_heading(_port, target); }
+
+std::int32_t pros::Imu::set_rotation(const double target) const { return pros::c::imu_set_rotation(_port, target); }
+
+std::int32_t pros::Imu::set_yaw(const double target) const { return pros::c::imu_set_yaw(_port, target); }
+
+std::int32_t pros::Imu::set_pitch(const double target) const { return pros::c::imu_set_pitch(_port, target); }
+
+std::int32_t pros::Imu::set_roll(const double target) const { return pros::c::imu_set_roll(_port, target); }
+
+std::int32_t pros::Imu::set_euler(const pros::euler_s_t target) const {
+    return pros::c::imu_set_euler(_port, target);
+}
+
+pros::imu_accel_s_t pros::Imu::get_accel() const { return pros::c::imu_get_accel(_port); }
+
+pros::ImuStatus pros::Imu::get_status() const {
+    switch (pros::c::imu_get_status(_port)) {
+        case pros::E_IMU_STATUS_READY: return pros::ImuStatus::ready;
+        case pros::E_IMU_STATUS_CALIBRATING: return pros::ImuStatus::calibrating;
+        default: return pros::ImuStatus::error;
+    }
+}
+
+bool pros::Imu::is_calibrating() const { return get_status() == pros::ImuStatus::calibrating; }
+
+pros::imu_orientation_e_t pros::Imu::get_physical_orientation() const {
+    return pros::c::imu_get_physical_orientation(_port);
+}
@@ -0,0 +1,16 @@
+#include "sim/internal.hpp"
+#include "pros/misc.hpp"
+#include <cmath>
+
+uint8_t pros::c::competition_get_status() { return sim::internal::getCompetitionStatus(); }
+
+std::uint8_t pros::competition::get_status() { return pros::c::competition_get_status(); }
+
+int32_t pros::c::battery_get_voltage() { return std::lround(to_volt(sim::internal::getBatteryVoltage()) * 1000); }
+
+int32_t pros::battery::get_voltage() { return pros::c::battery_get_voltage(); }
+
+int32_t pros::c::controller_rumble(pros::controller_id_e_t id, const char* rumble_pattern) {
+    // there is no controller to rumble, so succeed silently
+    return 1;
+}
@@ -0,0 +1,88 @@
+#include "sim/internal.hpp"
+#include "pros/motors.h"
+#include "pros/error.h"
+#include <cerrno>
+#include <cstdlib>
+
+// get the state of the motor on a port, or nullptr and set errno if there is none. Negative ports are reversed
+static sim::MotorState* getMotor(int8_t port) {
+    if (std::abs(port) < 1 || std::abs(port) > 21) {
+        errno = ENXIO;
+        return nullptr;
+    }
+    sim::MotorState& state = sim::motor(std::abs(port));
+    if (!state.installed) {
+        errno = ENODEV;
+        return nullptr;
+    }
+    return &state;
+}
+
+// the sign to multiply values by, to account for reversed ports
+static int sign(int8_t port) { return port < 0 ? -1 : 1; }
+
+int32_t pros::c::motor_move_velocity(int8_t port, const int32_t velocity) {
+    sim::MotorState* state = getMotor(port);
+    if (state == nullptr) return PROS_ERR;
+    state->velocityMode = true;
+    state->targetVelocity = sign(port) * velocity;
+    return 1;
+}
+
+int32_t pros::c::motor_move_voltage(int8_t port, const int32_t voltage) {
+    sim::MotorState* state = getMotor(port);
+    if (state == nullptr) return PROS_ERR;
+    state->velocityMode = false;
+    state->voltage = sign(port) * voltage;
+    return 1;
+}
+
+double pros::c::motor_get_actual_velocity(int8_t port) {
+    sim::MotorState* state = getMotor(port);
+    if (state == nullptr) return PROS_ERR_F;
+    return sign(port) * state->velocity;
+}
+
+int32_t pros::c::motor_get_current_draw(int8_t port) {
+    sim::MotorState* state = getMotor(port);
+    if (state == nullptr) return PROS_ERR;
+    return state->current;
+}
+
+double pros::c::motor_get_position(int8_t port) {
+    sim::MotorState* state = getMotor(port);
+    if (state == nullptr) return PROS_ERR_F;
+    return sign(port) * state->position;
+}
+
+double pros::c::motor_get_temperature(int8_t port) {
+    sim::MotorState* state = getMotor(port);
+    if (state == nullptr) return PROS_ERR_F;
+    return state->temperature;
+}
+
+int32_t pros::c::motor_get_voltage(int8_t port) {
+    sim::MotorState* state = getMotor(port);
+    if (state == nullptr) return PROS_ERR;
+    return sign(port) * state->voltage;
+}
+
+int32_t pros::c::motor_tare_position(int8_t port) {
+    sim::MotorState* state = getMotor(port);
+    if (state == nullptr) return PROS_ERR;
+    state->position = 0;
+    return 1;
+}
+
+int32_t pros::c::motor_set_encoder_units(int8_t port, const motor_encoder_units_e_t units) {
+    // the simulation only supports degrees, which is what the robot code uses
+    if (getMotor(port) == nullptr) return PROS_ERR;
+    return 1;
+}
+
+int32_t pros::c::motor_set_gearing(int8_t port, const motor_gearset_e_t gearset) {
+    sim::MotorState* state = getMotor(port);
+    if (state == nullptr) return PROS_ERR;
+    state->gearset = gearset;
+    return 1;
+}
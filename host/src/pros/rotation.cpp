@@ -0,0 +1,106 @@
+#include "sim/internal.hpp"
+#include "pros/rotation.hpp"
+#include "pros/error.h"
+#include <cerrno>
+#include <cstdlib>
+
+// get the state of the rotation sensor on a port, or nullptr and set errno if there is none
+static sim::RotationState* getRotation(uint8_t port) {
+    if (port < 1 || port > 21) {
+        errno = ENXIO;
+        return nullptr;
+    }
+    sim::RotationState& state = sim::rotation(port);
+    if (!state.installed) {
+        errno = ENODEV;
+        return nullptr;
+    }
+    return &state;
+}
+
+int32_t pros::c::rotation_reset(uint8_t port) { return rotation_reset_position(port); }
+
+int32_t pros::c::rotation_set_data_rate(uint8_t port, uint32_t rate) {
+    if (getRotation(port) == nullptr) return PROS_ERR;
+    return 1;
+}
+
+int32_t pros::c::rotation_set_position(uint8_t port, uint32_t position) {
+    sim::RotationState* state = getRotation(port);
+    if (state == nullptr) return PROS_ERR;
+    state->position = state->reversed ? -int32_t(position) : int32_t(position);
+    return 1;
+}
+
+int32_t pros::c::rotation_reset_position(uint8_t port) { return rotation_set_position(port, 0); }
+
+int32_t pros::c::rotation_get_position(uint8_t port) {
+    sim::RotationState* state = getRotation(port);
+    if (state == nullptr) return PROS_ERR;
+    return state->reversed ? -state->position : state->position;
+}
+
+int32_t pros::c::rotation_get_velocity(uint8_t port) {
+    sim::RotationState* state = getRotation(port);
+    if (state == nullptr) return PROS_ERR;
+    return state->reversed ? -state->velocity : state->velocity;
+}
+
+int32_t pros::c::rotation_get_angle(uint8_t port) {
+    const int32_t position = rotation_get_position(port);
+    if (position == PROS_ERR) return PROS_ERR;
+    return ((position % 36000) + 36000) % 36000;
+}
+
+int32_t pros::c::rotation_set_reversed(uint8_t port, bool value) {
+    sim::RotationState* state = getRotation(port);
+    if (state == nullptr) return PROS_ERR;
+    state->reversed = value;
+    return 1;
+}
+
+int32_t pros::c::rotation_reverse(uint8_t port) {
+    sim::RotationState* state = getRotation(port);
+    if (state == nullptr) return PROS_ERR;
+    state->reversed = !state->reversed;
+    return 1;
+}
+
+int32_t pros::c::rotation_init_reverse(uint8_t port, bool reverse_flag) {
+    return rotation_set_reversed(port, reverse_flag);
+}
+
+int32_t pros::c::rotation_get_reversed(uint8_t port) {
+    sim::RotationState* state = getRotation(port);
+    if (state == nullptr) return PROS_ERR;
+    return state->reversed;
+}
+
+pros::Rotation::Rotation(const std::int8_t port)
+    : Device(std::abs(port), pros::DeviceType::rotation) {
+    pros::c::rotation_init_reverse(_port, port < 0);
+}
+
+std::int32_t pros::Rotation::reset() { return pros::c::rotation_reset(_port); }
+
+std::int32_t pros::Rotation::set_data_rate(std::uint32_t rate) const {
+    return pros::c::rotation_set_data_rate(_port, rate);
+}
+
+std::int32_t pros::Rotation::set_position(std::uint32_t position) const {
+    return pros::c::rotation_set_position(_port, position);
+}
+
+std::int32_t pros::Rotation::reset_position() const { return pros::c::rotation_reset_position(_port); }
+
+std::int32_t pros::Rotation::get_position() const { return pros::c::rotation_get_position(_port); }
+
+std::int32_t pros::Rotation::get_velocity() const { return pros::c::rotation_get_velocity(_port); }
+
+std::int32_t pros::Rotation::get_angle() const { return pros::c::rotation_get_angle(_port); }
+
+std::int32_t pros::Rotation::set_reversed(bool value) const { return pros::c::rotation_set_reversed(_port, value); }
+
+std::int32_t pros::Rotation::reverse() const { return pros::c::rotation_reverse(_port); }
+
+std::int32_t pros::Rotation::get_reversed() const { return pros::c::rotation_get_reversed(_port); }
@@ -0,0 +1,145 @@
+#include "sim/internal.hpp"
+#include "pros/rtos.hpp"
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * Cooperative scheduler of the simulation
+ *
+ * Every PROS task is a host thread, but only the task that holds the baton runs. When a task delays, it gives the
+ * baton to the task which wakes up first, advancing the virtual clock to its wake up time. Tasks waking up at the
+ * same time run in round robin order. The thread that first calls into the scheduler, usually main, becomes a task
+ * too.
+ */
+namespace {
+struct SimTask {
+        std::condition_variable wake; /** notified when the task gets the baton */
+        uint64_t wakeTime = 0; /** when the task should run next, in microseconds */
+        std::string name;
+};
+
+struct Scheduler {
+        std::mutex mutex;
+        std::vector<SimTask*> tasks; /** running tasks, in the order they were created */
+        SimTask* current = nullptr; /** the task holding the baton */
+        std::atomic<uint64_t> time = 0; /** virtual time, in microseconds */
+};
+
+constexpr uint64_t STEP = 1000; // how much the virtual clock advances every step, in microseconds
+
+// the scheduler is never destroyed, so detached tasks can still reach it while the program exits
+Scheduler& scheduler() {
+    static Scheduler* instance = new Scheduler();
+    return *instance;
+}
+
+thread_local SimTask* thisTask = nullptr;
+
+// register the calling thread as a task if it isn't one yet
+SimTask* getThisTask(Scheduler& s) {
+    if (thisTask == nullptr) {
+        thisTask = new SimTask();
+        thisTask->wakeTime = s.time;
+        thisTask->name = "main";
+        s.tasks.push_back(thisTask);
+        if (s.current == nullptr) s.current = thisTask;
+    }
+    return thisTask;
+}
+
+// pass the baton to the task that wakes up first, advancing the clock. Blocks until the baton comes back, unless
+// the calling task has already been removed
+void yield(Scheduler& s, std::unique_lock<std::mutex>& lock, SimTask* task) {
+    if (s.tasks.empty()) return;
+    // find the task which wakes up first, starting the search after the current task for round robin
+    size_t start = 0;
+    for (size_t i = 0; i < s.tasks.size(); i++) {
+        if (s.tasks[i] == task) start = i + 1;
+    }
+    SimTask* next = nullptr;
+    for (size_t i = 0; i < s.tasks.size(); i++) {
+        SimTask* candidate = s.tasks[(start + i) % s.tasks.size()];
+        if (next == nullptr || candidate->wakeTime < next->wakeTime) next = candidate;
+    }
+    // advance the clock, running the step callbacks every millisecond
+    while (s.time + STEP <= next->wakeTime) {
+        s.time += STEP;
+        sim::internal::step(from_us(s.time), from_us(STEP));
+    }
+    if (s.time < next->wakeTime) s.time = next->wakeTime;
+    // hand over the baton
+    s.current = next;
+    next->wake.notify_one();
+    if (task == nullptr) return;
+    task->wake.wait(lock, [&] { return s.current == task; });
+}
+} // namespace
+
+uint32_t pros::c::millis() { return scheduler().time / 1000; }
+
+uint64_t pros::c::micros() { return scheduler().time; }
+
+void pros::c::delay(const uint32_t milliseconds) {
+    Scheduler& s = scheduler();
+    std::unique_lock lock(s.mutex);
+    SimTask* task = getThisTask(s);
+    task->wakeTime = s.time + uint64_t(milliseconds) * 1000;
+    yield(s, lock, task);
+}
+
+void pros::c::task_delay(const uint32_t milliseconds) { pros::c::delay(milliseconds); }
+
+void pros::c::task_delay_until(uint32_t* const prev_time, const uint32_t delta) {
+    *prev_time += delta;
+    const uint32_t now = pros::c::millis();
+    pros::c::delay(*prev_time > now ? *prev_time - now : 0);
+}
+
+pros::task_t pros::c::task_create(pros::task_fn_t function, void* const parameters, uint32_t prio,
+                                  const uint16_t stack_depth, const char* const name) {
+    Scheduler& s = scheduler();
+    std::unique_lock lock(s.mutex);
+    getThisTask(s); // make sure the creator can get the baton back
+    SimTask* task = new SimTask();
+    task->wakeTime = s.time;
+    task->name = name == nullptr ? "" : name;
+    s.tasks.push_back(task);
+    std::thread([&s, task, function, parameters] {
+        {
+            std::unique_lock lock(s.mutex);
+            thisTask = task;
+            task->wake.wait(lock, [&] { return s.current == task; });
+        }
+        function(parameters);
+        // the task returned, remove it and give the baton to the next task
+        std::unique_lock lock(s.mutex);
+        std::erase(s.tasks, task);
+        yield(s, lock, nullptr);
+        lock.unlock();
+        delete task;
+    }).detach();
+    return task;
+}
+
+pros::Task::Task(pros::task_fn_t function, void* parameters, std::uint32_t prio, std::uint16_t stack_depth,
+                 const char* name)
+    : task(pros::c::task_create(function, parameters, prio, stack_depth, name)) {}
+
+pros::Task::Task(pros::task_fn_t function, void* parameters, const char* name)
+    : Task(function, parameters, TASK_PRIORITY_DEFAULT, TASK_STACK_DEPTH_DEFAULT, name) {}
+
+void pros::Task::delay(const std::uint32_t milliseconds) { pros::c::delay(milliseconds); }
+
+void pros::Task::delay_until(std::uint32_t* const prev_time, const std::uint32_t delta) {
+    pros::c::task_delay_until(prev_time, delta);
+}
+
+Time sim::now() { return from_us(scheduler().time); }
+
+uint64_t sim::micros() { return scheduler().time; }
+
+void sim::runFor(Time time) { pros::c::delay(to_ms(time)); }
@@ -0,0 +1,26 @@
+#pragma once
+
+#include "sim/sim.hpp"
+
+// functions shared between the simulation and the mock PROS API. They are not part of the simulation's interface
+namespace sim::internal {
+/**
+ * @brief call the step callbacks
+ *
+ * @param now the current time
+ * @param dt the time since the last step
+ */
+void step(Time now, Time dt);
+/**
+ * @brief Get the competition status set by the simulation
+ *
+ * @return uint8_t
+ */
+uint8_t getCompetitionStatus();
+/**
+ * @brief Get the battery voltage set by the simulation
+ *
+ * @return Voltage
+ */
+Voltage getBatteryVoltage();
+} // namespace sim::internal
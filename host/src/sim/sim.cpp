@@ -0,0 +1,180 @@
+#include "sim/internal.hpp"
+#include <algorithm>
+#include <cmath>
+#include <deque>
+#include <map>
+#include <optional>
+#include <random>
+#include <vector>
+
+// true poses of a simulated GPS, so fixes can be published late
+struct GpsHistory {
+        struct Entry {
+                Time time;
+                double x;
+                double y;
+                double heading;
+        };
+
+        std::deque<Entry> entries;
+        Time nextFix = 0_sec;
+};
+
+// voltages commanded to a simulated drivetrain, so they can be applied late
+struct DrivetrainHistory {
+        struct Entry {
+                Time time;
+                double left;
+                double right;
+        };
+
+        std::deque<Entry> entries;
+};
+
+// the devices of the robot code, like the ones in devices.cpp, are constructed during static initialization and
+// configure their ports, so the state is constructed before any other static object
+#define SIM_STATE __attribute__((init_priority(101)))
+
+// std::map never moves its elements, so references to the states stay valid when other ports are added
+static std::map<int, sim::RotationState> rotations SIM_STATE;
+static std::map<int, sim::ImuState> imus SIM_STATE;
+static std::map<int, sim::MotorState> motors SIM_STATE;
+static std::map<int, sim::DistanceState> distances SIM_STATE;
+static std::map<int, sim::GpsState> gpses SIM_STATE;
+static std::map<int, GpsHistory> gpsHistories SIM_STATE;
+static std::map<int, sim::AdiEncoderState> adiEncoders SIM_STATE;
+static std::optional<sim::DrivetrainState> drivetrainState SIM_STATE;
+static DrivetrainHistory drivetrainHistory SIM_STATE;
+static std::mt19937 rng SIM_STATE; // seeded the same every run, so simulations are repeatable
+static std::vector<std::function<void(Time, Time)>> stepCallbacks SIM_STATE;
+static uint8_t competitionStatus = 0;
+static Voltage batteryVoltage = 12.8_volt;
+
+sim::RotationState& sim::rotation(int port) { return rotations[port]; }
+
+sim::ImuState& sim::imu(int port) { return imus[port]; }
+
+sim::MotorState& sim::motor(int port) { return motors[port]; }
+
+sim::DistanceState& sim::distance(int port) { return distances[port]; }
+
+sim::GpsState& sim::gps(int port) { return gpses[port]; }
+
+sim::AdiEncoderState& sim::adiEncoder(int topPort) { return adiEncoders[topPort]; }
+
+sim::DrivetrainState& sim::drivetrain() {
+    if (drivetrainState == std::nullopt) drivetrainState.emplace();
+    return *drivetrainState;
+}
+
+void sim::setCompetitionStatus(uint8_t status) { competitionStatus = status; }
+
+void sim::setBatteryVoltage(Voltage voltage) { batteryVoltage = voltage; }
+
+void sim::onStep(std::function<void(Time now, Time dt)> callback) { stepCallbacks.push_back(callback); }
+
+void sim::reset() {
+    rotations.clear();
+    imus.clear();
+    motors.clear();
+    distances.clear();
+    gpses.clear();
+    gpsHistories.clear();
+    adiEncoders.clear();
+    drivetrainState.reset();
+    drivetrainHistory.entries.clear();
+    rng.seed(std::mt19937::default_seed);
+    stepCallbacks.clear();
+    competitionStatus = 0;
+    batteryVoltage = 12.8_volt;
+}
+
+// mean voltage commanded to the motors of a side, in volts. The motors can't apply more than the battery voltage
+static double sideVoltage(const std::vector<int>& ports) {
+    if (ports.empty()) return 0;
+    const double limit = std::min(12.0, to_volt(batteryVoltage));
+    double sum = 0;
+    for (int port : ports) {
+        const int sign = port < 0 ? -1 : 1;
+        sum += sign * std::clamp(motors[std::abs(port)].voltage / 1000.0, -limit, limit);
+    }
+    return sum / ports.size();
+}
+
+// voltage left to accelerate a side after friction. A side at rest stays at rest until the voltage overcomes kS
+static double afterFriction(double voltage, double velocity, double kS) {
+    if (velocity != 0) return voltage - std::copysign(kS, velocity);
+    return std::copysign(std::max(std::abs(voltage) - kS, 0.0), voltage);
+}
+
+static void stepDrivetrain(sim::DrivetrainState& state, Time now, Time dt) {
+    // apply the newest voltages that are at least as old as the delay
+    drivetrainHistory.entries.push_back({now, sideVoltage(state.leftMotors), sideVoltage(state.rightMotors)});
+    while (drivetrainHistory.entries.size() > 1 && drivetrainHistory.entries[1].time <= now - state.delay)
+        drivetrainHistory.entries.pop_front();
+    const DrivetrainHistory::Entry& delayed = drivetrainHistory.entries.front();
+    // external forces act like extra voltage, so they have to overcome static friction too
+    const DrivetrainHistory::Entry applied = {delayed.time, delayed.left + state.leftForce,
+                                              delayed.right + state.rightForce};
+    // split the sides into driving straight and turning in place, which have different inertia
+    const double left = afterFriction(applied.left, state.leftVelocity, state.kS) - state.kV * state.leftVelocity;
+    const double right = afterFriction(applied.right, state.rightVelocity, state.kS) - state.kV * state.rightVelocity;
+    const double linearAcceleration = (left + right) / 2 / state.kA;
+    const double angularAcceleration = (right - left) / 2 / state.angularKA;
+    const double step = to_sec(dt);
+    const double leftVelocity = state.leftVelocity + (linearAcceleration - angularAcceleration) * step;
+    const double rightVelocity = state.rightVelocity + (linearAcceleration + angularAcceleration) * step;
+    // friction can stop a side, but never reverse it
+    const auto stop = [&](double before, double after, double voltage) {
+        if (before != 0 && std::signbit(before) != std::signbit(after) && std::abs(voltage) <= state.kS) return 0.0;
+        return after;
+    };
+    const double leftDistance = (state.leftVelocity + leftVelocity) / 2 * step;
+    const double rightDistance = (state.rightVelocity + rightVelocity) / 2 * step;
+    state.leftVelocity = stop(state.leftVelocity, leftVelocity, applied.left);
+    state.rightVelocity = stop(state.rightVelocity, rightVelocity, applied.right);
+    // integrate the pose with the heading halfway through the step
+    const double dTheta = (rightDistance - leftDistance) / to_m(state.trackWidth);
+    const double heading = state.theta + dTheta / 2;
+    state.x += (leftDistance + rightDistance) / 2 * std::cos(heading);
+    state.y += (leftDistance + rightDistance) / 2 * std::sin(heading);
+    state.theta += dTheta;
+    // write the sensors. Motor positions are in degrees and velocities in rpm, at the motor outputs
+    const double radius = to_m(state.wheelDiameter) / 2;
+    const auto writeMotors = [&](const std::vector<int>& ports, double distance, double velocity) {
+        for (int port : ports) {
+            const int sign = port < 0 ? -1 : 1;
+            motors[std::abs(port)].position += sign * distance / radius / state.gearRatio * 180 / M_PI;
+            motors[std::abs(port)].velocity = sign * velocity / radius / state.gearRatio * 30 / M_PI;
+        }
+    };
+    writeMotors(state.leftMotors, leftDistance, state.leftVelocity);
+    writeMotors(state.rightMotors, rightDistance, state.rightVelocity);
+    if (state.imuPort != 0) {
+        imus[state.imuPort].rotation = 90 - state.theta * 180 / M_PI;
+        imus[state.imuPort].gyroZ = (state.rightVelocity - state.leftVelocity) / to_m(state.trackWidth) * 180 / M_PI;
+    }
+}
+
+void sim::internal::step(Time now, Time dt) {
+    if (drivetrainState != std::nullopt) stepDrivetrain(*drivetrainState, now, dt);
+    for (const std::function<void(Time, Time)>& callback : stepCallbacks) callback(now, dt);
+    // publish GPS fixes, after the callbacks have moved the robot
+    for (auto& [port, state] : gpses) {
+        GpsHistory& history = gpsHistories[port];
+        history.entries.push_back({now, state.x, state.y, state.heading});
+        while (history.entries.size() > 1 && history.entries[1].time <= now - state.latency)
+            history.entries.pop_front();
+        if (now < history.nextFix) continue;
+        history.nextFix = now + state.period;
+        const GpsHistory::Entry& entry = history.entries.front();
+        std::normal_distribution<double> noise(0, state.noise);
+        state.fixX = entry.x + noise(rng);
+        state.fixY = entry.y + noise(rng);
+        state.fixHeading = entry.heading;
+    }
+}
+
+uint8_t sim::internal::getCompetitionStatus() { return competitionStatus; }
+
+Voltage sim::internal::getBatteryVoltage() { return batteryVoltage; }
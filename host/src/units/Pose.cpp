@@ -0,0 +1,25 @@
+#include "units/Pose.hpp"
+
+// the robot links against a prebuilt units library, which isn't built for the host, so Pose is defined here
+
+namespace units {
+Pose::Pose()
+    : V2Position(),
+      theta(0_stRad) {}
+
+Pose::Pose(V2Position v)
+    : V2Position(v),
+      theta(0_stRad) {}
+
+Pose::Pose(V2Position v, Angle h)
+    : V2Position(v),
+      theta(h) {}
+
+Pose::Pose(Length nx, Length ny, Angle nh)
+    : V2Position(nx, ny),
+      theta(nh) {}
+
+Angle Pose::getTheta() { return theta; }
+
+void Pose::setTheta(Angle h) { theta = h; }
+} // namespace units
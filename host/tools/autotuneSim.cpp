@@ -0,0 +1,185 @@
+/**
+ * Autotune the chassis loops against the simulated drivetrain
+ *
+ * Runs Chassis::autotune() on a simulated drivetrain, then checks the proposed gains with a step response: 0.5 m for
+ * the linear loop, 90 degrees for the angular loop, and from rest to the velocity target for the velocity loop. The
+ * inertia of the simulated robot can be scaled, to see how the gains follow a change of mass before retuning the
+ * real robot. The autotuner is given the static friction of the simulated drivetrain, like Chassis::characterize()
+ * would measure it. The steps saturate the motors, which the tuning rules don't account for, so expect more overshoot
+ * than the rules promise.
+ *
+ *   make -C host tools && host/build/tools/autotuneSim [options]
+ *
+ *   --loop name    linear, angular, velocity or all. Default all
+ *   --rule name    zn, tl or conservative. Default tl
+ *   --relay volts  how far the relay switches the voltage. Default 4
+ *   --mass scale   multiply the inertia of the simulated robot. Default 1
+ */
+#include "sim/sim.hpp"
+#include "chassis.hpp"
+#include "hardware/encoder/motorEncoder.hpp"
+#include "hardware/imu/v5_imu.hpp"
+#include "odometry/perpWheelOdom.hpp"
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <vector>
+
+// geometry of the simulated robot
+constexpr int IMU_PORT = 7;
+constexpr double GEAR_RATIO = 0.75;
+constexpr Length WHEEL_DIAMETER = 3.25_in;
+constexpr Length TRACK_WIDTH = 12_in;
+
+/**
+ * @brief step response of a loop, using the controllers of the chassis
+ *
+ */
+class StepMotion : public Motion {
+    public:
+        StepMotion(int loop, double target, std::shared_ptr<Controller<PositionControllerInput, double>> controller)
+            : loop(loop),
+              target(target),
+              controller(controller) {}
+
+        ChassisSpeeds update(units::Pose pose) override {
+            if (start == std::nullopt) start = pose;
+            if (loop == AUTOTUNE_WHEEL_VELOCITY) return {true, from_mps(target), from_mps(target), 0, 0};
+            const double measurement = measure(pose);
+            const double power = controller->update({target, measurement}) / 12;
+            if (loop == AUTOTUNE_ANGULAR_POSITION) return {false, 0_mps, 0_mps, -power, power};
+            return {false, 0_mps, 0_mps, power, power};
+        }
+
+        // position of the loop since the start of the step, or the wheel velocity
+        double measure(units::Pose pose) const {
+            if (loop == AUTOTUNE_WHEEL_VELOCITY)
+                return (sim::drivetrain().leftVelocity + sim::drivetrain().rightVelocity) / 2;
+            if (start == std::nullopt) return 0;
+            units::Pose origin = *start;
+            if (loop == AUTOTUNE_ANGULAR_POSITION) return to_sRad(pose.getTheta() - origin.getTheta());
+            const Angle theta = origin.getTheta();
+            return to_m((pose.getX() - origin.getX()) * units::cos(theta) +
+                        (pose.getY() - origin.getY()) * units::sin(theta));
+        }
+    private:
+        const int loop;
+        const double target;
+        const std::shared_ptr<Controller<PositionControllerInput, double>> controller;
+        std::optional<units::Pose> start;
+};
+
+static int parseLoop(const std::string& name) {
+    if (name == "linear") return AUTOTUNE_LINEAR_POSITION;
+    if (name == "angular") return AUTOTUNE_ANGULAR_POSITION;
+    if (name == "velocity") return AUTOTUNE_WHEEL_VELOCITY;
+    return -1;
+}
+
+static int parseRule(const std::string& name) {
+    if (name == "zn") return TUNING_ZIEGLER_NICHOLS;
+    if (name == "tl") return TUNING_TYREUS_LUYBEN;
+    if (name == "conservative") return TUNING_CONSERVATIVE;
+    return -1;
+}
+
+int main(int argc, char** argv) {
+    std::vector<int> loops = {AUTOTUNE_LINEAR_POSITION, AUTOTUNE_ANGULAR_POSITION, AUTOTUNE_WHEEL_VELOCITY};
+    AutotuneSettings settings;
+    settings.resultPath = "";
+    double mass = 1;
+    for (int i = 1; i < argc; i++) {
+        const std::string arg = argv[i];
+        if (i + 1 >= argc) {
+            std::fprintf(stderr, "unknown or incomplete option %s, see the top of autotuneSim.cpp\n", arg.c_str());
+            return 1;
+        }
+        const std::string value = argv[++i];
+        if (arg == "--loop" && value == "all") continue;
+        else if (arg == "--loop" && parseLoop(value) != -1) loops = {parseLoop(value)};
+        else if (arg == "--rule" && parseRule(value) != -1) settings.rule = parseRule(value);
+        else if (arg == "--relay") settings.relayVoltage = from_volt(std::stod(value));
+        else if (arg == "--mass") mass = std::stod(value);
+        else {
+            std::fprintf(stderr, "unknown or incomplete option %s, see the top of autotuneSim.cpp\n", arg.c_str());
+            return 1;
+        }
+    }
+    // simulate the drivetrain
+    sim::reset();
+    sim::DrivetrainState& drivetrain = sim::drivetrain();
+    drivetrain.leftMotors = {1, 2};
+    drivetrain.rightMotors = {3, 4};
+    drivetrain.imuPort = IMU_PORT;
+    drivetrain.gearRatio = GEAR_RATIO;
+    drivetrain.wheelDiameter = WHEEL_DIAMETER;
+    drivetrain.trackWidth = TRACK_WIDTH;
+    drivetrain.kA *= mass;
+    drivetrain.angularKA *= mass;
+    // build the chassis, tracking with the left drive and the IMU
+    auto leftDrive = std::make_shared<MotorGroup>(std::initializer_list<int> {1, 2}, Cartridge::BLUE, GEAR_RATIO);
+    auto rightDrive = std::make_shared<MotorGroup>(std::initializer_list<int> {3, 4}, Cartridge::BLUE, GEAR_RATIO);
+    auto vertical = std::make_shared<TrackingWheel>(std::make_shared<MotorEncoder>(leftDrive),
+                                                    WHEEL_DIAMETER / 2, TRACK_WIDTH / 2);
+    auto odometry = std::make_shared<PerpWheelOdom>(vertical, nullptr, std::make_shared<V5IMU>(IMU_PORT));
+    auto leftVelocity = std::make_shared<VAPID>(0, 0, 0, 0, 0);
+    auto rightVelocity = std::make_shared<VAPID>(0, 0, 0, 0, 0);
+    // the slew limit isn't tuned, and at its default it takes the output 0.2 s to reverse, which the steps would
+    // overshoot by however far the robot drives in that time
+    auto linear = std::make_shared<PID<PID_ALL & ~PID_SLEW>>(PIDGains {});
+    auto angular = std::make_shared<PID<PID_ALL & ~PID_SLEW>>(PIDGains {});
+    Chassis chassis(leftDrive, rightDrive, odometry, TRACK_WIDTH, WHEEL_DIAMETER, leftVelocity, rightVelocity, linear,
+                    angular);
+    chassis.initialize();
+    // the friction a characterization would measure
+    settings.kS = drivetrain.kS;
+    std::printf("simulated drivetrain: kS %.2f V  kV %.2f V/(m/s)  kA %.2f V/(m/s^2)  turning kA %.2f V/(m/s^2)\n\n",
+                drivetrain.kS, drivetrain.kV, drivetrain.kA, drivetrain.angularKA);
+    for (int loop : loops) {
+        const char* names[] = {"linear position", "angular position", "wheel velocity"};
+        std::printf("%s\n", names[loop]);
+        const std::optional<AutotuneResult> result = chassis.autotune(loop, settings);
+        if (!result) {
+            std::printf("  timed out\n\n");
+            continue;
+        }
+        const RelayResult& relay = result->relay;
+        const PIDGains& gains = result->gains;
+        std::printf("  Ku %.3f  Tu %.3f s  amplitude %.4f  bias %.2f V  period spread %.1f%%\n", relay.ultimateGain,
+                    to_sec(relay.ultimatePeriod), relay.amplitude, relay.bias, relay.periodSpread * 100);
+        std::printf("  kP %.3f  kI %.3f  kD %.4f  kS %.2f\n", gains.kP, gains.kI, gains.kD, gains.kS);
+        // let the robot come to rest, then check the gains with a step response
+        sim::runFor(1_sec);
+        double target = (loop == AUTOTUNE_ANGULAR_POSITION) ? M_PI / 2 : 0.5;
+        if (loop == AUTOTUNE_WHEEL_VELOCITY) {
+            target = to_mps(settings.velocityTarget);
+            // the relay's bias is the voltage that holds the target, so it becomes kV
+            leftVelocity->setGains(relay.bias / target, 0, gains.kP, gains.kI, gains.kD);
+            rightVelocity->setGains(relay.bias / target, 0, gains.kP, gains.kI, gains.kD);
+        } else {
+            (loop == AUTOTUNE_LINEAR_POSITION ? linear : angular)->setGains(gains);
+        }
+        auto step = std::make_unique<StepMotion>(loop, target, loop == AUTOTUNE_LINEAR_POSITION ? linear : angular);
+        StepMotion* stepMotion = step.get();
+        chassis.move(std::move(step));
+        double peak = 0;
+        std::optional<Time> settled;
+        const Time start = sim::now();
+        while (sim::now() - start < 3_sec) {
+            sim::runFor(10_ms);
+            const double measurement = stepMotion->measure(chassis.getPose());
+            peak = std::max(peak, measurement);
+            const bool inside = std::abs(measurement - target) < 0.02 * target;
+            if (!inside) settled = std::nullopt;
+            else if (settled == std::nullopt) settled = sim::now() - start;
+        }
+        chassis.stopMotion();
+        std::printf("  step to %.2f: overshoot %.1f%%  ", target, std::max(peak / target - 1, 0.0) * 100);
+        if (settled) std::printf("settled within 2%% after %.2f s\n\n", to_sec(*settled));
+        else std::printf("not settled within 2%% after 3 s\n\n");
+        sim::runFor(1_sec);
+    }
+    std::exit(0);
+}
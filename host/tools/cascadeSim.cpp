@@ -0,0 +1,217 @@
+/**
+ * Compare the rates and the acceleration feedforward of the cascaded chassis loops
+ *
+ * Follows trajectories with RamseteMotion through Chassis on the simulated drivetrain, with the velocity loops of
+ * each configuration. The first configuration leaves out the accelerations of the targets, like the chassis did
+ * before motions could output them. For every run it prints:
+ * - the RMS velocity error of the wheels relative to the trajectory
+ * - the lag of the start: how much later than the trajectory the robot reaches 90% of its top speed
+ * - the RMS position error, and the position error once the robot has stopped
+ *
+ * The simulated motors report a new velocity every millisecond, but V5 motors only report one every 10 ms, so a 5 ms
+ * velocity loop does better here than it would on the robot.
+ *
+ *   make -C host tools && host/build/tools/cascadeSim
+ */
+#include "sim/sim.hpp"
+#include "chassis.hpp"
+#include "hardware/encoder/motorEncoder.hpp"
+#include "hardware/imu/v5_imu.hpp"
+#include "motion/ramsete.hpp"
+#include "odometry/perpWheelOdom.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <memory>
+#include <vector>
+
+// geometry of the simulated robot
+constexpr int IMU_PORT = 7;
+constexpr double GEAR_RATIO = 0.75;
+constexpr Length WHEEL_DIAMETER = 3.25_in;
+constexpr Length TRACK_WIDTH = 12_in;
+
+/**
+ * @brief velocity profile of a trajectory
+ *
+ */
+struct Profile {
+        const char* name;
+        Time duration;
+        double topSpeed; /** meters per second */
+        std::function<std::pair<double, double>(double t)> velocity; /** meters and radians per second at a time */
+};
+
+/**
+ * @brief rates of the loops, and whether the accelerations reach the velocity controllers
+ *
+ */
+struct Configuration {
+        const char* name;
+        ChassisRates rates;
+        bool acceleration;
+};
+
+// trapezoidal profile, which accelerates as hard as the drivetrain can
+static double trapezoid(double t, double duration, double speed, double acceleration) {
+    return std::clamp(std::min(t, duration - t) * acceleration, 0.0, speed);
+}
+
+static const std::vector<Profile> PROFILES = {
+    {"sprint", 2_sec, 1.6, [](double t) { return std::pair {trapezoid(t, 2, 1.6, 4), 0.0}; }},
+    {"s-curve", 4_sec, 1.2,
+     [](double t) { return std::pair {trapezoid(t, 4, 1.2, 4), 1.5 * std::sin(M_PI * t / 2) * (t < 4)}; }},
+};
+
+static const std::vector<Configuration> CONFIGURATIONS = {
+    {"10/10 ms, no accel", {10_ms, 10_ms}, false},
+    {"10/10 ms", {10_ms, 10_ms}, true},
+    {"10/5 ms", {10_ms, 5_ms}, true},
+    {"20/5 ms", {20_ms, 5_ms}, true},
+};
+
+// integrate a profile into a trajectory, starting where the simulated robot starts
+static Trajectory integrate(const Profile& profile) {
+    std::vector<TrajectoryPoint> points;
+    double x = 0;
+    double y = 0;
+    double theta = M_PI / 2;
+    const double dt = 0.01;
+    for (double t = 0; t <= to_sec(profile.duration) + 1e-9; t += dt) {
+        const auto [velocity, angularVelocity] = profile.velocity(t);
+        points.push_back({from_sec(t), units::Pose(from_m(x), from_m(y), from_sRad(theta)), from_mps(velocity),
+                          from_radps(angularVelocity)});
+        const double heading = theta + angularVelocity * dt / 2;
+        x += velocity * std::cos(heading) * dt;
+        y += velocity * std::sin(heading) * dt;
+        theta += angularVelocity * dt;
+    }
+    return Trajectory(points);
+}
+
+/**
+ * @brief wrapper which drops the accelerations of a motion
+ *
+ */
+class NoAcceleration : public Motion {
+    public:
+        NoAcceleration(std::unique_ptr<Motion> motion)
+            : motion(std::move(motion)) {}
+
+        ChassisSpeeds update(units::Pose pose) override {
+            ChassisSpeeds speeds = motion->update(pose);
+            running = motion->isRunning();
+            speeds.leftAcceleration = 0_mps2;
+            speeds.rightAcceleration = 0_mps2;
+            return speeds;
+        }
+    private:
+        const std::unique_ptr<Motion> motion;
+};
+
+/**
+ * @brief odometry which stops reading the sensors once its run is over
+ *
+ * The chassis tasks never end, so the odometry of old runs would read the sensors of the next runs
+ */
+class RunOdometry : public Odometry {
+    public:
+        RunOdometry(std::shared_ptr<Odometry> odometry)
+            : odometry(odometry) {}
+
+        void calibrate() override { odometry->calibrate(); }
+
+        units::Pose update() override {
+            if (active) pose = odometry->update();
+            return pose;
+        }
+
+        void setPose(units::Pose pose) override {
+            odometry->setPose(pose);
+            this->pose = pose;
+        }
+
+        bool active = true;
+    private:
+        const std::shared_ptr<Odometry> odometry;
+};
+
+int main() {
+    // the chassis tasks never end, so the chassis of every run is kept
+    std::vector<std::unique_ptr<Chassis>> chassis;
+    std::printf("%-8s %-19s %12s %9s %9s %10s\n", "path", "loops", "vel rms(m/s)", "lag(ms)", "rms(in)", "stop(in)");
+    for (const Profile& profile : PROFILES) {
+        const Trajectory trajectory = integrate(profile);
+        for (const Configuration& configuration : CONFIGURATIONS) {
+            sim::reset();
+            sim::DrivetrainState& drivetrain = sim::drivetrain();
+            drivetrain.leftMotors = {1, 2};
+            drivetrain.rightMotors = {3, 4};
+            drivetrain.imuPort = IMU_PORT;
+            drivetrain.gearRatio = GEAR_RATIO;
+            drivetrain.wheelDiameter = WHEEL_DIAMETER;
+            drivetrain.trackWidth = TRACK_WIDTH;
+            sim::imu(IMU_PORT).calibrationEnd = 0_sec;
+            auto leftDrive =
+                std::make_shared<MotorGroup>(std::initializer_list<int> {1, 2}, Cartridge::BLUE, GEAR_RATIO);
+            auto rightDrive =
+                std::make_shared<MotorGroup>(std::initializer_list<int> {3, 4}, Cartridge::BLUE, GEAR_RATIO);
+            // track with the left drive, which is to the left of the tracking center
+            auto vertical = std::make_shared<TrackingWheel>(
+                std::make_shared<MotorEncoder>(leftDrive), WHEEL_DIAMETER / 2, TRACK_WIDTH / 2);
+            auto odometry = std::make_shared<RunOdometry>(
+                std::make_shared<PerpWheelOdom>(vertical, nullptr, std::make_shared<V5IMU>(IMU_PORT)));
+            const FeedforwardGains feedforward {drivetrain.kS, drivetrain.kV, drivetrain.kA};
+            chassis.push_back(std::make_unique<Chassis>(
+                leftDrive, rightDrive, odometry, TRACK_WIDTH, WHEEL_DIAMETER,
+                std::make_shared<VAPID>(feedforward, 4, 0, 0), std::make_shared<VAPID>(feedforward, 4, 0, 0),
+                std::make_shared<PID<>>(PIDGains {}), std::make_shared<PID<>>(PIDGains {}),
+                ChassisOptions {.rates = configuration.rates}));
+            chassis.back()->initialize();
+            chassis.back()->setPose({0_m, 0_m, 90_stDeg});
+            std::unique_ptr<Motion> motion = std::make_unique<RamseteMotion>(trajectory, TRACK_WIDTH);
+            if (!configuration.acceleration) motion = std::make_unique<NoAcceleration>(std::move(motion));
+            chassis.back()->move(std::move(motion));
+            // measure every millisecond, until the robot has stopped
+            const Time start = sim::now();
+            double squaredVelocityError = 0;
+            double squaredError = 0;
+            int samples = 0;
+            std::optional<double> reached;
+            std::optional<double> referenceReached;
+            double stopError = 0;
+            while (sim::now() - start < trajectory.getDuration() + 300_ms) {
+                sim::runFor(1_ms);
+                const Time elapsed = sim::now() - start;
+                const TrajectoryPoint reference = trajectory.sample(elapsed);
+                units::Pose target = reference.pose;
+                const double error =
+                    std::hypot(drivetrain.x - to_m(target.getX()), drivetrain.y - to_m(target.getY())) / to_m(1_in);
+                if (elapsed > trajectory.getDuration()) {
+                    stopError = error;
+                    continue;
+                }
+                const double turn = to_radps(reference.angularVelocity) * to_m(TRACK_WIDTH) / 2;
+                const double leftError = drivetrain.leftVelocity - (to_mps(reference.velocity) - turn);
+                const double rightError = drivetrain.rightVelocity - (to_mps(reference.velocity) + turn);
+                squaredVelocityError += (leftError * leftError + rightError * rightError) / 2;
+                squaredError += error * error;
+                samples++;
+                const double speed = (drivetrain.leftVelocity + drivetrain.rightVelocity) / 2;
+                if (!reached && speed >= 0.9 * profile.topSpeed) reached = to_sec(elapsed);
+                if (!referenceReached && to_mps(reference.velocity) >= 0.9 * profile.topSpeed)
+                    referenceReached = to_sec(elapsed);
+            }
+            chassis.back()->stopMotion();
+            odometry->active = false;
+            std::printf("%-8s %-19s %12.3f ", profile.name, configuration.name,
+                        std::sqrt(squaredVelocityError / samples));
+            if (reached && referenceReached) std::printf("%9.0f ", (*reached - *referenceReached) * 1000);
+            else std::printf("%9s ", "-");
+            std::printf("%9.3f %10.3f\n", std::sqrt(squaredError / samples), stopError);
+        }
+    }
+    std::exit(0);
+}
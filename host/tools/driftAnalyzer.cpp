@@ -0,0 +1,452 @@
+/**
+ * Offline drift analyzer for logged runs
+ *
+ * Replays sensor logs recorded with #RecordingEncoder and #RecordingIMU through #PerpWheelOdom, which reproduces the
+ * pose the robot estimated live. Known positions from the run, like waypoints the robot was placed at or walls it
+ * touched, are then fused with the odometry by a Kalman filter and a Rauch-Tung-Striebel smoother, which gives the
+ * best estimate of the whole trajectory. The filter estimates the calibration errors alongside the position, so the
+ * drift of the live estimate can be attributed to:
+ * - heading: an offset of the heading when the pose was set, and a constant drift of the IMU
+ * - radius: scale errors of the vertical and horizontal tracking wheels
+ * - offset: errors in the offsets of the tracking wheels, which cause drift while turning
+ * - unmodeled: anything else, like wheel slip
+ *
+ * Logs are processed in parallel. A summary of the calibration errors over every log with known positions shows
+ * systematic problems, like a tracking wheel radius that is consistently too small.
+ *
+ *   make -C host tools && host/build/tools/driftAnalyzer [options] log...
+ *
+ *   --vertical id,radius,offset    sensor id of the vertical wheel, its radius and offset in inches. Default 0,1.375,0
+ *   --horizontal id,radius,offset  same for the horizontal wheel, or "none". Default 1,1.375,0
+ *   --imu id                       sensor id of the IMU. Default 2
+ *   --period ms                    how often odometry is updated, like the chassis task. Default 10
+ *   --threads n                    how many logs are processed at once. Defaults to the number of cores
+ *   --trajectories dir             write the live and smoothed trajectory of each log to dir/<log name>.csv
+ *
+ * Known positions are read from <log>.constraints if it exists, one per line, in inches and in seconds since the
+ * program started, like the times in the log. Lines starting with # are ignored:
+ *
+ *   start,x,y[,heading]     the pose the robot was set to when the log started. The heading is in degrees,
+ *                           counterclockwise from the x axis, and defaults to the heading measured by the IMU
+ *   waypoint,time,x,y       the robot's tracking center was at a known position
+ *   wall,time,x|y,position  the robot touched a wall, so its x or y coordinate was known
+ */
+#include "hardware/encoder/playbackEncoder.hpp"
+#include "hardware/imu/playbackImu.hpp"
+#include "odometry/perpWheelOdom.hpp"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+// state of the filter: the unmodeled position error, and the calibration errors
+enum State {
+    STATE_X = 0, /** unmodeled x error, meters */
+    STATE_Y = 1, /** unmodeled y error, meters */
+    STATE_HEADING_OFFSET = 2, /** radians */
+    STATE_HEADING_DRIFT = 3, /** radians per second */
+    STATE_VERTICAL_SCALE = 4, /** fraction of the distance measured by the vertical wheel */
+    STATE_HORIZONTAL_SCALE = 5, /** fraction of the distance measured by the horizontal wheel */
+    STATE_VERTICAL_OFFSET = 6, /** meters */
+    STATE_HORIZONTAL_OFFSET = 7, /** meters */
+    STATE_SIZE = 8
+};
+
+using Vector = std::array<double, STATE_SIZE>;
+using Matrix = std::array<Vector, STATE_SIZE>;
+
+// standard deviations of the calibration errors before any positions are known
+constexpr Vector PRIOR = {0.0127, 0.0127, 2 * M_PI / 180, 0.02 * M_PI / 180, 0.03, 0.03, 0.0127, 0.0127};
+constexpr double DRIFT_PER_METER = 0.01; // standard deviation of unmodeled drift after 1 meter, in meters
+constexpr double DRIFT_PER_SECOND = 0.002; // standard deviation of unmodeled drift after 1 second, in meters
+constexpr double WAYPOINT_NOISE = 0.0127; // standard deviation of a waypoint, in meters
+constexpr double WALL_NOISE = 0.00635; // standard deviation of a wall contact, in meters
+
+struct WheelConfig {
+        int id;
+        Length radius;
+        Length offset;
+};
+
+struct Config {
+        WheelConfig vertical {0, 1.375_in, 0_in};
+        std::optional<WheelConfig> horizontal = WheelConfig {1, 1.375_in, 0_in};
+        int imu = 2;
+        Time period = 10_ms;
+        unsigned threads = std::max(1u, std::thread::hardware_concurrency());
+        std::optional<std::filesystem::path> trajectories;
+};
+
+/**
+ * @brief a known coordinate of the robot at a point in time
+ *
+ */
+struct Constraint {
+        Time time;
+        int axis; /** 0 for x, 1 for y */
+        double value; /** meters */
+        double noise; /** standard deviation, in meters */
+};
+
+struct Result {
+        std::string name;
+        std::string error; /** why the log couldn't be analyzed, empty if it was */
+        int ticks = 0;
+        int constraints = 0;
+        Vector calibration {}; /** smoothed calibration errors, see #State */
+        double finalDrift = 0; /** distance between the live and smoothed position at the end, in meters */
+        double maxDrift = 0; /** maximum distance between the live and smoothed position, in meters */
+        double headingDrift = 0; /** final drift caused by heading errors, in meters */
+        double radiusDrift = 0; /** final drift caused by radius errors, in meters */
+        double offsetDrift = 0; /** final drift caused by offset errors, in meters */
+        double unmodeledDrift = 0; /** final drift not explained by the calibration errors, in meters */
+};
+
+// solve for the inverse of a matrix with Gauss-Jordan elimination
+static Matrix invert(Matrix a) {
+    Matrix inverse {};
+    for (int i = 0; i < STATE_SIZE; i++) inverse[i][i] = 1;
+    for (int col = 0; col < STATE_SIZE; col++) {
+        int pivot = col;
+        for (int row = col + 1; row < STATE_SIZE; row++)
+            if (std::abs(a[row][col]) > std::abs(a[pivot][col])) pivot = row;
+        std::swap(a[col], a[pivot]);
+        std::swap(inverse[col], inverse[pivot]);
+        const double scale = a[col][col];
+        for (int j = 0; j < STATE_SIZE; j++) {
+            a[col][j] /= scale;
+            inverse[col][j] /= scale;
+        }
+        for (int row = 0; row < STATE_SIZE; row++) {
+            if (row == col) continue;
+            const double factor = a[row][col];
+            for (int j = 0; j < STATE_SIZE; j++) {
+                a[row][j] -= factor * a[col][j];
+                inverse[row][j] -= factor * inverse[col][j];
+            }
+        }
+    }
+    return inverse;
+}
+
+static Matrix multiply(const Matrix& a, const Matrix& b) {
+    Matrix result {};
+    for (int i = 0; i < STATE_SIZE; i++)
+        for (int k = 0; k < STATE_SIZE; k++)
+            for (int j = 0; j < STATE_SIZE; j++) result[i][j] += a[i][k] * b[k][j];
+    return result;
+}
+
+static Vector multiply(const Matrix& a, const Vector& v) {
+    Vector result {};
+    for (int i = 0; i < STATE_SIZE; i++)
+        for (int j = 0; j < STATE_SIZE; j++) result[i] += a[i][j] * v[j];
+    return result;
+}
+
+/**
+ * @brief a tick of the replayed run
+ *
+ */
+struct Tick {
+        Time time;
+        double x; /** live x, meters */
+        double y; /** live y, meters */
+        double theta; /** live heading, radians */
+        std::array<Vector, 2> jacobian; /** change of the x and y position per unit of each calibration error */
+        Vector predicted; /** filter state before the constraints of this tick */
+        Matrix predictedCovariance;
+        Vector filtered; /** filter state after the constraints of this tick */
+        Matrix filteredCovariance;
+};
+
+// read the constraints of a log, and the position the pose was set to
+static std::vector<Constraint> readConstraints(const std::filesystem::path& path, std::optional<units::Pose>& start,
+                                               std::optional<Angle>& heading) {
+    std::vector<Constraint> constraints;
+    std::ifstream file(path);
+    std::string line;
+    while (std::getline(file, line)) {
+        if (line.empty() || line[0] == '#') continue;
+        std::stringstream stream(line);
+        std::string kind, field;
+        std::vector<std::string> fields;
+        std::getline(stream, kind, ',');
+        while (std::getline(stream, field, ',')) fields.push_back(field);
+        if (kind == "start" && (fields.size() == 2 || fields.size() == 3)) {
+            start = units::Pose(from_in(std::stod(fields[0])), from_in(std::stod(fields[1])));
+            if (fields.size() == 3) heading = from_sdeg(std::stod(fields[2]));
+        } else if (kind == "waypoint" && fields.size() == 3) {
+            const Time time = from_sec(std::stod(fields[0]));
+            constraints.push_back({time, 0, to_m(from_in(std::stod(fields[1]))), WAYPOINT_NOISE});
+            constraints.push_back({time, 1, to_m(from_in(std::stod(fields[2]))), WAYPOINT_NOISE});
+        } else if (kind == "wall" && fields.size() == 3 && (fields[1] == "x" || fields[1] == "y")) {
+            constraints.push_back({from_sec(std::stod(fields[0])), fields[1] == "x" ? 0 : 1,
+                                   to_m(from_in(std::stod(fields[2]))), WALL_NOISE});
+        } else {
+            std::fprintf(stderr, "%s: ignoring line \"%s\"\n", path.c_str(), line.c_str());
+        }
+    }
+    std::sort(constraints.begin(), constraints.end(),
+              [](const Constraint& a, const Constraint& b) { return a.time < b.time; });
+    return constraints;
+}
+
+static Result analyze(const std::filesystem::path& path, const Config& config) {
+    Result result;
+    result.name = path.filename().string();
+    std::ifstream file(path, std::ios::binary);
+    auto log = std::make_shared<SensorLogReader>(file);
+    if (!log->isValid()) {
+        result.error = "not a sensor log";
+        return result;
+    }
+    std::optional<units::Pose> start;
+    std::optional<Angle> startHeading;
+    const std::vector<Constraint> constraints = readConstraints(path.string() + ".constraints", start, startHeading);
+    result.constraints = constraints.size();
+    // replay the log through odometry, on a clock local to this log so logs can be replayed in parallel
+    Time now = 0_sec;
+    auto clock = [&now] { return now; };
+    auto vertical = std::make_shared<TrackingWheel>(std::make_shared<PlaybackEncoder>(log, config.vertical.id, clock),
+                                                    config.vertical.radius, config.vertical.offset);
+    std::shared_ptr<TrackingWheel> horizontal;
+    if (config.horizontal)
+        horizontal = std::make_shared<TrackingWheel>(
+            std::make_shared<PlaybackEncoder>(log, config.horizontal->id, clock), config.horizontal->radius,
+            config.horizontal->offset);
+    auto imu = std::make_shared<PlaybackIMU>(log, config.imu, clock);
+    PerpWheelOdom odometry(vertical, horizontal, imu);
+    // start replaying when the sensors were first read, so odometry doesn't see a jump from the values before
+    std::optional<Time> begin;
+    for (int channel : {sensorChannel(config.vertical.id, ENCODER_FIELD_POSITION),
+                        sensorChannel(config.imu, IMU_FIELD_ROTATION)}) {
+        const std::vector<SensorSample>& samples = log->getSamples(channel);
+        if (!samples.empty()) begin = std::max(begin.value_or(samples.front().time), samples.front().time);
+    }
+    if (!begin) {
+        result.error = "no samples of the vertical wheel or the IMU";
+        return result;
+    }
+    now = *begin;
+    if (start) odometry.setPose(units::Pose(start->getX(), start->getY(), startHeading.value_or(imu->getRotation())));
+    // run the filter forwards. The state transition is the identity: the unmodeled error is a random walk and the
+    // calibration errors are constant, so only the covariance grows between ticks
+    std::vector<Tick> ticks;
+    Vector state {};
+    Matrix covariance {};
+    for (int i = 0; i < STATE_SIZE; i++) covariance[i][i] = PRIOR[i] * PRIOR[i];
+    std::array<Vector, 2> jacobian {};
+    size_t nextConstraint = 0;
+    std::optional<units::Pose> prevPose;
+    double prevVertical = 0, prevHorizontal = 0, prevTheta = 0;
+    for (; now <= log->getEndTime(); now += config.period) {
+        units::Pose pose = odometry.update();
+        const double verticalDistance = to_m(vertical->getDistance());
+        const double horizontalDistance = horizontal ? to_m(horizontal->getDistance()) : 0;
+        const double theta = to_sRad(pose.getTheta());
+        if (prevPose) {
+            // how much each calibration error would have changed this tick's motion
+            const double dx = to_m(pose.getX() - prevPose->getX());
+            const double dy = to_m(pose.getY() - prevPose->getY());
+            const double deltaTheta = theta - prevTheta;
+            const double deltaVertical = verticalDistance - prevVertical;
+            const double deltaHorizontal = horizontalDistance - prevHorizontal;
+            // the local frame has y forwards, 90 degrees from the x axis of the heading
+            const double angle = prevTheta + deltaTheta / 2 - M_PI / 2;
+            const double c = std::cos(angle), s = std::sin(angle);
+            const auto local = [&](int index, double lx, double ly) {
+                jacobian[0][index] += lx * c - ly * s;
+                jacobian[1][index] += lx * s + ly * c;
+            };
+            jacobian[0][STATE_HEADING_OFFSET] -= dy;
+            jacobian[1][STATE_HEADING_OFFSET] += dx;
+            jacobian[0][STATE_HEADING_DRIFT] -= dy * to_sec(now);
+            jacobian[1][STATE_HEADING_DRIFT] += dx * to_sec(now);
+            local(STATE_VERTICAL_SCALE, 0, deltaVertical);
+            local(STATE_HORIZONTAL_SCALE, deltaHorizontal, 0);
+            local(STATE_VERTICAL_OFFSET, 0, deltaTheta);
+            local(STATE_HORIZONTAL_OFFSET, deltaTheta, 0);
+            // unmodeled errors grow with the distance traveled
+            const double drift = DRIFT_PER_METER * DRIFT_PER_METER * std::hypot(dx, dy) +
+                                 DRIFT_PER_SECOND * DRIFT_PER_SECOND * to_sec(config.period);
+            covariance[STATE_X][STATE_X] += drift;
+            covariance[STATE_Y][STATE_Y] += drift;
+        }
+        prevPose = pose;
+        prevVertical = verticalDistance;
+        prevHorizontal = horizontalDistance;
+        prevTheta = theta;
+        Tick tick {now, to_m(pose.getX()), to_m(pose.getY()), theta, jacobian, state, covariance};
+        // fuse the constraints up to this tick
+        while (nextConstraint < constraints.size() && constraints[nextConstraint].time <= now) {
+            const Constraint& constraint = constraints[nextConstraint++];
+            // the smoothed position is the live position plus the unmodeled error and the calibration errors
+            Vector h = jacobian[constraint.axis];
+            h[STATE_X] = constraint.axis == 0 ? 1 : 0;
+            h[STATE_Y] = constraint.axis == 1 ? 1 : 0;
+            const double live = constraint.axis == 0 ? tick.x : tick.y;
+            double predicted = live;
+            for (int i = 0; i < STATE_SIZE; i++) predicted += h[i] * state[i];
+            const Vector ph = multiply(covariance, h);
+            double innovationVariance = constraint.noise * constraint.noise;
+            for (int i = 0; i < STATE_SIZE; i++) innovationVariance += h[i] * ph[i];
+            const double innovation = constraint.value - predicted;
+            for (int i = 0; i < STATE_SIZE; i++) state[i] += ph[i] / innovationVariance * innovation;
+            for (int i = 0; i < STATE_SIZE; i++)
+                for (int j = 0; j < STATE_SIZE; j++) covariance[i][j] -= ph[i] * ph[j] / innovationVariance;
+        }
+        tick.filtered = state;
+        tick.filteredCovariance = covariance;
+        ticks.push_back(tick);
+    }
+    result.ticks = ticks.size();
+    if (ticks.empty()) {
+        result.error = "log is empty";
+        return result;
+    }
+    // run the Rauch-Tung-Striebel smoother backwards
+    std::vector<Vector> smoothed(ticks.size());
+    smoothed.back() = ticks.back().filtered;
+    for (size_t k = ticks.size() - 1; k-- > 0;) {
+        const Matrix gain = multiply(ticks[k].filteredCovariance, invert(ticks[k + 1].predictedCovariance));
+        Vector difference;
+        for (int i = 0; i < STATE_SIZE; i++) difference[i] = smoothed[k + 1][i] - ticks[k + 1].predicted[i];
+        const Vector correction = multiply(gain, difference);
+        for (int i = 0; i < STATE_SIZE; i++) smoothed[k][i] = ticks[k].filtered[i] + correction[i];
+    }
+    // compare the smoothed trajectory to the live one
+    std::ofstream trajectory;
+    if (config.trajectories) {
+        trajectory.open(*config.trajectories / (result.name + ".csv"));
+        trajectory << "time,live x,live y,live heading,smoothed x,smoothed y\n";
+    }
+    for (size_t k = 0; k < ticks.size(); k++) {
+        const Tick& tick = ticks[k];
+        double correction[2];
+        for (int axis = 0; axis < 2; axis++) {
+            correction[axis] = smoothed[k][axis];
+            for (int i = STATE_HEADING_OFFSET; i < STATE_SIZE; i++)
+                correction[axis] += tick.jacobian[axis][i] * smoothed[k][i];
+        }
+        const double drift = std::hypot(correction[0], correction[1]);
+        result.maxDrift = std::max(result.maxDrift, drift);
+        result.finalDrift = drift;
+        if (trajectory.is_open())
+            trajectory << to_sec(tick.time) << ',' << to_in(from_m(tick.x)) << ',' << to_in(from_m(tick.y)) << ','
+                       << tick.theta * 180 / M_PI << ',' << to_in(from_m(tick.x + correction[0])) << ','
+                       << to_in(from_m(tick.y + correction[1])) << '\n';
+    }
+    // attribute the final drift to each group of calibration errors
+    const Vector& final = smoothed.back();
+    const auto contribution = [&](std::initializer_list<int> indices) {
+        double x = 0, y = 0;
+        for (int i : indices) {
+            x += ticks.back().jacobian[0][i] * final[i];
+            y += ticks.back().jacobian[1][i] * final[i];
+        }
+        return std::hypot(x, y);
+    };
+    result.calibration = final;
+    result.headingDrift = contribution({STATE_HEADING_OFFSET, STATE_HEADING_DRIFT});
+    result.radiusDrift = contribution({STATE_VERTICAL_SCALE, STATE_HORIZONTAL_SCALE});
+    result.offsetDrift = contribution({STATE_VERTICAL_OFFSET, STATE_HORIZONTAL_OFFSET});
+    result.unmodeledDrift = std::hypot(final[STATE_X], final[STATE_Y]);
+    return result;
+}
+
+static std::optional<WheelConfig> parseWheel(const std::string& value) {
+    WheelConfig wheel;
+    double radius, offset;
+    if (std::sscanf(value.c_str(), "%d,%lf,%lf", &wheel.id, &radius, &offset) != 3) return std::nullopt;
+    wheel.radius = from_in(radius);
+    wheel.offset = from_in(offset);
+    return wheel;
+}
+
+int main(int argc, char** argv) {
+    Config config;
+    std::vector<std::filesystem::path> logs;
+    for (int i = 1; i < argc; i++) {
+        const std::string arg = argv[i];
+        const bool hasValue = i + 1 < argc;
+        if (arg == "--vertical" && hasValue && parseWheel(argv[i + 1])) config.vertical = *parseWheel(argv[++i]);
+        else if (arg == "--horizontal" && hasValue && std::string(argv[i + 1]) == "none") {
+            config.horizontal = std::nullopt;
+            i++;
+        } else if (arg == "--horizontal" && hasValue && parseWheel(argv[i + 1]))
+            config.horizontal = parseWheel(argv[++i]);
+        else if (arg == "--imu" && hasValue) config.imu = std::stoi(argv[++i]);
+        else if (arg == "--period" && hasValue) config.period = from_ms(std::stod(argv[++i]));
+        else if (arg == "--threads" && hasValue) config.threads = std::max(1, std::stoi(argv[++i]));
+        else if (arg == "--trajectories" && hasValue) config.trajectories = argv[++i];
+        else if (arg.starts_with("--")) {
+            std::fprintf(stderr, "unknown or incomplete option %s, see the top of driftAnalyzer.cpp\n", arg.c_str());
+            return 1;
+        } else logs.push_back(arg);
+    }
+    if (logs.empty()) {
+        std::fprintf(stderr, "usage: driftAnalyzer [options] log...\n");
+        return 1;
+    }
+    if (config.trajectories) std::filesystem::create_directories(*config.trajectories);
+    // analyze the logs on a pool of threads, each taking the next log until there are none left
+    std::vector<Result> results(logs.size());
+    std::atomic<size_t> next = 0;
+    std::vector<std::thread> workers;
+    for (unsigned i = 0; i < std::min<size_t>(config.threads, logs.size()); i++)
+        workers.emplace_back([&] {
+            for (size_t job = next++; job < logs.size(); job = next++) results[job] = analyze(logs[job], config);
+        });
+    for (std::thread& worker : workers) worker.join();
+    // report every log, then the calibration errors over every log with constraints
+    std::printf("%-24s %6s %5s %9s %9s | %8s %8s %8s %8s | %8s %9s %8s %8s %8s %8s\n", "log", "ticks", "known",
+                "final(in)", "max(in)", "heading", "radius", "offset", "other", "hdg(deg)", "drift(d/m)", "vert(%)",
+                "horiz(%)", "vOff(in)", "hOff(in)");
+    std::vector<Vector> calibrations;
+    for (const Result& result : results) {
+        if (!result.error.empty()) {
+            std::printf("%-24s %s\n", result.name.c_str(), result.error.c_str());
+            continue;
+        }
+        const Vector& c = result.calibration;
+        std::printf("%-24s %6d %5d %9.2f %9.2f | %8.2f %8.2f %8.2f %8.2f | %8.2f %9.3f %8.2f %8.2f %8.2f %8.2f\n",
+                    result.name.c_str(), result.ticks, result.constraints, to_in(from_m(result.finalDrift)),
+                    to_in(from_m(result.maxDrift)), to_in(from_m(result.headingDrift)),
+                    to_in(from_m(result.radiusDrift)), to_in(from_m(result.offsetDrift)),
+                    to_in(from_m(result.unmodeledDrift)), c[STATE_HEADING_OFFSET] * 180 / M_PI,
+                    c[STATE_HEADING_DRIFT] * 180 / M_PI * 60, c[STATE_VERTICAL_SCALE] * 100,
+                    c[STATE_HORIZONTAL_SCALE] * 100, to_in(from_m(c[STATE_VERTICAL_OFFSET])),
+                    to_in(from_m(c[STATE_HORIZONTAL_OFFSET])));
+        if (result.constraints > 0) calibrations.push_back(c);
+    }
+    if (calibrations.size() < 2) return 0;
+    // a calibration error with a mean much larger than its spread is systematic, and worth fixing in the config
+    Vector mean {}, spread {};
+    for (const Vector& c : calibrations)
+        for (int i = 0; i < STATE_SIZE; i++) mean[i] += c[i] / calibrations.size();
+    for (const Vector& c : calibrations)
+        for (int i = 0; i < STATE_SIZE; i++) spread[i] += (c[i] - mean[i]) * (c[i] - mean[i]) / calibrations.size();
+    for (double& s : spread) s = std::sqrt(s);
+    std::printf("\nover %zu logs with known positions, mean +- standard deviation:\n", calibrations.size());
+    std::printf("  heading offset     %8.3f +- %.3f deg\n", mean[STATE_HEADING_OFFSET] * 180 / M_PI,
+                spread[STATE_HEADING_OFFSET] * 180 / M_PI);
+    std::printf("  heading drift      %8.3f +- %.3f deg/min\n", mean[STATE_HEADING_DRIFT] * 180 / M_PI * 60,
+                spread[STATE_HEADING_DRIFT] * 180 / M_PI * 60);
+    std::printf("  vertical radius    %8.3f +- %.3f %%\n", mean[STATE_VERTICAL_SCALE] * 100,
+                spread[STATE_VERTICAL_SCALE] * 100);
+    std::printf("  horizontal radius  %8.3f +- %.3f %%\n", mean[STATE_HORIZONTAL_SCALE] * 100,
+                spread[STATE_HORIZONTAL_SCALE] * 100);
+    std::printf("  vertical offset    %8.3f +- %.3f in\n", to_in(from_m(mean[STATE_VERTICAL_OFFSET])),
+                to_in(from_m(spread[STATE_VERTICAL_OFFSET])));
+    std::printf("  horizontal offset  %8.3f +- %.3f in\n", to_in(from_m(mean[STATE_HORIZONTAL_OFFSET])),
+                to_in(from_m(spread[STATE_HORIZONTAL_OFFSET])));
+}
@@ -0,0 +1,120 @@
+/**
+ * Simulate fusing the GPS into drifting odometry
+ *
+ * Drives a figure eight for 60 seconds, with odometry which measures 3% too far and whose direction of travel is
+ * rotated by 1 degree, plus 0.1 degrees per second, like tracking wheels with the wrong radius and an IMU drifting.
+ * The GPS reports fixes 40 ms late, and has bursts of bad fixes:
+ * - for the last second of every 10, it reports a large error, like when it can't see the field strip
+ * - for the last half second of every 13, it reports a small error but its fixes jump around, which the gate has to
+ *   reject
+ *
+ * Every second it prints the position error of the odometry, of the latest GPS fix on its own, and of FusedOdom,
+ * then the mean and maximum of each over the run.
+ *
+ *   make -C host tools && host/build/tools/gpsFusionSim
+ */
+#include "sim/sim.hpp"
+#include "hardware/gps/v5_gps.hpp"
+#include "hardware/sensorCache.hpp"
+#include "odometry/fusedOdom.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <memory>
+
+constexpr int GPS_PORT = 3;
+constexpr Time DURATION = 60_sec;
+constexpr Time PERIOD = 10_ms;
+
+// true position of the robot, in meters
+static double trueX = 0;
+static double trueY = 0;
+
+/**
+ * @brief odometry which integrates the true motion with a scale and direction error
+ *
+ */
+class DriftingOdom : public Odometry {
+    public:
+        void calibrate() override {}
+
+        units::Pose update() override {
+            const double dx = trueX - prevX;
+            const double dy = trueY - prevY;
+            prevX = trueX;
+            prevY = trueY;
+            const double rotation = (1 + 0.1 * to_sec(sim::now())) * M_PI / 180;
+            x += 1.03 * (dx * std::cos(rotation) - dy * std::sin(rotation));
+            y += 1.03 * (dx * std::sin(rotation) + dy * std::cos(rotation));
+            pose = units::Pose(from_m(x), from_m(y), from_sdeg(90));
+            return pose;
+        }
+
+        void setPose(units::Pose pose) override {
+            this->pose = pose;
+            x = to_m(pose.getX());
+            y = to_m(pose.getY());
+        }
+    private:
+        double x = 0;
+        double y = 0;
+        double prevX = 0;
+        double prevY = 0;
+};
+
+/**
+ * @brief error statistics of a position estimate
+ *
+ */
+struct ErrorStats {
+        double sum = 0;
+        double max = 0;
+        int count = 0;
+
+        void add(double error) {
+            sum += error;
+            max = std::max(max, error);
+            count++;
+        }
+};
+
+int main() {
+    sim::gps(GPS_PORT);
+    sim::onStep([](Time now, Time) {
+        const double t = to_sec(now);
+        trueX = 1.2 * std::sin(0.4 * t);
+        trueY = 0.96 * std::sin(0.8 * t);
+        sim::GpsState& gps = sim::gps(GPS_PORT);
+        gps.x = trueX;
+        gps.y = trueY;
+        gps.error = (std::fmod(t, 10) > 9) ? 0.15 : 0.02;
+        gps.noise = (std::fmod(t, 13) > 12.5) ? 0.3 : 0.01;
+    });
+    auto odometry = std::make_shared<DriftingOdom>();
+    FusedOdom fused(odometry, std::make_shared<V5GPS>(GPS_PORT));
+    fused.calibrate();
+    ErrorStats odometryError, gpsError, fusedError;
+    std::printf("%6s %12s %9s %9s %14s %9s\n", "t(s)", "odometry(m)", "gps(m)", "fused(m)", "uncertainty(m)",
+                "rejected");
+    const int ticks = int(std::lround(to_sec(DURATION) / to_sec(PERIOD)));
+    for (int i = 0; i < ticks; i++) {
+        SensorCache::invalidate();
+        const units::Pose pose = fused.update();
+        const units::Pose raw = odometry->getPose();
+        const double error = std::hypot(to_m(pose.getX()) - trueX, to_m(pose.getY()) - trueY);
+        const double rawError = std::hypot(to_m(raw.getX()) - trueX, to_m(raw.getY()) - trueY);
+        const double fixError = std::hypot(sim::gps(GPS_PORT).fixX - trueX, sim::gps(GPS_PORT).fixY - trueY);
+        fusedError.add(error);
+        odometryError.add(rawError);
+        gpsError.add(fixError);
+        if (i % 100 == 99)
+            std::printf("%6.0f %12.3f %9.3f %9.3f %14.3f %9d\n", to_sec(sim::now()), rawError, fixError, error,
+                        to_m(fused.getUncertainty()), fused.getRejectedFixes());
+        sim::runFor(PERIOD);
+    }
+    std::printf("\n%8s %12s %9s %9s\n", "", "odometry(m)", "gps(m)", "fused(m)");
+    std::printf("%8s %12.4f %9.4f %9.4f\n", "mean", odometryError.sum / odometryError.count,
+                gpsError.sum / gpsError.count, fusedError.sum / fusedError.count);
+    std::printf("%8s %12.4f %9.4f %9.4f\n", "max", odometryError.max, gpsError.max, fusedError.max);
+    return 0;
+}
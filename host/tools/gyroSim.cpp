@@ -0,0 +1,69 @@
+/**
+ * Simulate the heading drift of GyroIMU
+ *
+ * The gyro of the simulated IMU has noise, and a bias which drifts with time like it does as the sensor warms up.
+ * The robot turns 180 degrees every 10 seconds for 60 seconds, and sits still in between. Every 10 seconds it prints
+ * the heading error of:
+ * - GyroIMU, which keeps following the bias whenever the robot is still
+ * - the same integration with the bias measured once after calibrating, which is what GyroIMU does without tracking
+ *   the bias
+ *
+ *   make -C host tools && host/build/tools/gyroSim [bias drift]
+ *
+ * The optional bias drift is in degrees per second per second. Default 0.005, 0.3 degrees per second over the run
+ */
+#include "sim/sim.hpp"
+#include "hardware/imu/gyroImu.hpp"
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <string>
+
+constexpr int IMU_PORT = 7;
+constexpr double INITIAL_BIAS = 0.3; // degrees per second
+constexpr double NOISE = 0.2; // standard deviation of the gyro rate, in degrees per second
+constexpr Time BIAS_TIME = 1_sec; // default bias measurement time of GyroIMU
+constexpr int DURATION = 60; // seconds
+
+int main(int argc, char** argv) {
+    const double biasDrift = (argc > 1) ? std::stod(argv[1]) : 0.005;
+    std::mt19937 generator(1);
+    std::normal_distribution<double> noise(0, NOISE);
+    double truth = 90; // standard degrees
+    double rate = 0; // last gyro rate, degrees per second counterclockwise
+    // integration with a fixed bias, measured over the same time as GyroIMU after the sensor calibrates
+    double fixedHeading = 90;
+    double fixedBiasSum = 0;
+    int fixedBiasSamples = 0;
+    bool integrating = false;
+    sim::onStep([&](Time now, Time dt) {
+        const double t = to_sec(now);
+        // 180 degree turn in the sixth second of every 10
+        const double phase = std::fmod(t, 10);
+        const double turnRate = (phase > 5 && phase < 6) ? 360 * std::pow(std::sin(M_PI * (phase - 5)), 2) : 0;
+        truth += turnRate * to_sec(dt);
+        rate = turnRate + INITIAL_BIAS + biasDrift * t + noise(generator);
+        sim::imu(IMU_PORT).gyroZ = rate;
+        if (integrating) {
+            fixedHeading += (rate - fixedBiasSum / fixedBiasSamples) * to_sec(dt);
+        } else if (now >= sim::imu(IMU_PORT).calibrationEnd) {
+            fixedBiasSum += rate;
+            fixedBiasSamples++;
+        }
+    });
+    GyroIMU imu(IMU_PORT, 1, BIAS_TIME);
+    imu.calibrate();
+    while (imu.getStatus() == IMU_CALIBRATING) sim::runFor(1_ms);
+    std::printf("ready after %.2f s\n", to_sec(sim::now()));
+    truth = 90;
+    fixedHeading = 90;
+    integrating = true;
+    imu.setYaw(90_stDeg);
+    std::printf("%6s %14s %15s\n", "t(s)", "GyroIMU(deg)", "fixed bias(deg)");
+    for (int second = 1; second <= DURATION; second++) {
+        sim::runFor(1_sec);
+        if (second % 10 != 0) continue;
+        std::printf("%6d %14.2f %15.2f\n", second, to_sDeg(imu.getRotation()) - truth, fixedHeading - truth);
+    }
+    return 0;
+}
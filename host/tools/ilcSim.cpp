@@ -0,0 +1,138 @@
+/**
+ * Learn out a repeatable disturbance over repeated runs of a trajectory
+ *
+ * Follows the same S-curve with MPCMotion again and again on the simulated drivetrain. Every run has the same
+ * disturbances: a bump which drags the right wheels partway through, and a left side which scrubs and needs more
+ * voltage than the model says. The learning controller is shared between the runs, so each run applies what the
+ * previous runs learned, and saves the table after each run like an autonomous would. For every run it prints the RMS
+ * and maximum position error relative to the trajectory.
+ *
+ *   make -C host tools && host/build/tools/ilcSim [options]
+ *
+ *   --runs count     how many runs. Default 8
+ *   --prefix path    save the table to path + hash + ".txt", and load it at the start. Default none
+ *   --no-bump        leave out the bump
+ *   --no-scrub       leave out the scrubbing side
+ */
+#include "sim/sim.hpp"
+#include "hardware/encoder/motorEncoder.hpp"
+#include "hardware/imu/v5_imu.hpp"
+#include "hardware/sensorCache.hpp"
+#include "motion/mpc.hpp"
+#include "odometry/perpWheelOdom.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <vector>
+
+// geometry of the simulated robot
+constexpr int IMU_PORT = 7;
+constexpr double GEAR_RATIO = 0.75;
+constexpr Length WHEEL_DIAMETER = 3.25_in;
+constexpr Length TRACK_WIDTH = 12_in;
+constexpr Time PERIOD = 10_ms;
+constexpr Time DURATION = 5_sec;
+
+// S-curve with acceleration limited ramps, starting where the simulated robot starts
+static Trajectory sCurve() {
+    std::vector<TrajectoryPoint> points;
+    double x = 0;
+    double y = 0;
+    double theta = M_PI / 2;
+    const double dt = to_sec(PERIOD);
+    for (double t = 0; t <= to_sec(DURATION) + 1e-9; t += dt) {
+        const double ramp = std::clamp(std::min(t, to_sec(DURATION) - t) / 0.5, 0.0, 1.0);
+        const double velocity = 1.2 * ramp;
+        const double angularVelocity = 1.5 * std::sin(2 * M_PI * t / 2.5) * ramp;
+        points.push_back({from_sec(t), units::Pose(from_m(x), from_m(y), from_sRad(theta)), from_mps(velocity),
+                          from_radps(angularVelocity)});
+        const double heading = theta + angularVelocity * dt / 2;
+        x += velocity * std::cos(heading) * dt;
+        y += velocity * std::sin(heading) * dt;
+        theta += angularVelocity * dt;
+    }
+    return Trajectory(points);
+}
+
+int main(int argc, char** argv) {
+    int runs = 8;
+    bool bump = true;
+    bool scrub = true;
+    ILCSettings settings;
+    settings.prefix = "";
+    for (int i = 1; i < argc; i++) {
+        const std::string arg = argv[i];
+        if (arg == "--runs" && i + 1 < argc) runs = std::stoi(argv[++i]);
+        else if (arg == "--prefix" && i + 1 < argc) settings.prefix = argv[++i];
+        else if (arg == "--no-bump") bump = false;
+        else if (arg == "--no-scrub") scrub = false;
+        else {
+            std::fprintf(stderr, "unknown or incomplete option %s, see the top of ilcSim.cpp\n", arg.c_str());
+            return 1;
+        }
+    }
+    const Trajectory trajectory = sCurve();
+    auto learning = std::make_shared<ILC>(trajectory.hash(), trajectory.getDuration(), settings);
+    if (!settings.prefix.empty())
+        std::printf("table %s, %d runs learned before\n\n", learning->getPath().c_str(), learning->getRuns());
+    std::printf("%4s %8s %8s %8s\n", "run", "rms(in)", "max(in)", "learned");
+    for (int run = 1; run <= runs; run++) {
+        sim::reset();
+        sim::DrivetrainState& drivetrain = sim::drivetrain();
+        drivetrain.leftMotors = {1, 2};
+        drivetrain.rightMotors = {3, 4};
+        drivetrain.imuPort = IMU_PORT;
+        drivetrain.gearRatio = GEAR_RATIO;
+        drivetrain.wheelDiameter = WHEEL_DIAMETER;
+        drivetrain.trackWidth = TRACK_WIDTH;
+        sim::imu(IMU_PORT).calibrationEnd = 0_sec;
+        // the disturbances depend on how far the robot has driven, so they're in the same place every run
+        auto distance = std::make_shared<double>(0);
+        sim::onStep([=, &drivetrain](Time now, Time dt) {
+            *distance += (drivetrain.leftVelocity + drivetrain.rightVelocity) / 2 * to_sec(dt);
+            drivetrain.leftForce = scrub ? -0.8 : 0;
+            drivetrain.rightForce = (bump && *distance > 2 && *distance < 2.25) ? -4 : 0;
+        });
+        auto leftDrive = std::make_shared<MotorGroup>(std::initializer_list<int> {1, 2}, Cartridge::BLUE, GEAR_RATIO);
+        auto rightDrive =
+            std::make_shared<MotorGroup>(std::initializer_list<int> {3, 4}, Cartridge::BLUE, GEAR_RATIO);
+        // track with the left drive, which is to the left of the tracking center
+        auto vertical = std::make_shared<TrackingWheel>(
+            std::make_shared<MotorEncoder>(leftDrive), WHEEL_DIAMETER / 2, TRACK_WIDTH / 2);
+        PerpWheelOdom odometry(vertical, nullptr, std::make_shared<V5IMU>(IMU_PORT));
+        odometry.calibrate();
+        odometry.setPose({0_m, 0_m, 90_stDeg});
+        const FeedforwardGains linear {drivetrain.kS, drivetrain.kV, drivetrain.kA};
+        const FeedforwardGains angular {drivetrain.kS, drivetrain.kV, drivetrain.angularKA};
+        MPCMotion motion(trajectory, linear, angular, leftDrive, rightDrive, WHEEL_DIAMETER, TRACK_WIDTH, {},
+                         learning);
+        sim::runFor(PERIOD);
+        SensorCache::invalidate();
+        odometry.update();
+        const Time start = sim::now();
+        int updates = 0;
+        double squaredError = 0;
+        double maxError = 0;
+        while (true) {
+            SensorCache::invalidate();
+            const ChassisSpeeds speeds = motion.update(odometry.update());
+            if (!motion.isRunning()) break;
+            leftDrive->moveVoltage(from_volt(speeds.leftPwr * 12));
+            rightDrive->moveVoltage(from_volt(speeds.rightPwr * 12));
+            sim::runFor(PERIOD);
+            units::Pose target = trajectory.sample(sim::now() - start).pose;
+            const double error =
+                std::hypot(drivetrain.x - to_m(target.getX()), drivetrain.y - to_m(target.getY())) / to_m(1_in);
+            squaredError += error * error;
+            maxError = std::max(maxError, error);
+            updates++;
+        }
+        // the motion is done, so the table can be saved without holding up the control loop
+        if (!learning->save()) std::fprintf(stderr, "couldn't write %s\n", learning->getPath().c_str());
+        std::printf("%4d %8.3f %8.3f %8d\n", run, std::sqrt(squaredError / updates), maxError, learning->getRuns());
+    }
+    std::exit(0);
+}
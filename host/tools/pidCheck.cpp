@@ -0,0 +1,76 @@
+/**
+ * Check the features of the PID controller, and how they interact
+ *
+ * Runs each feature of PID through a scripted sequence of errors, and checks the integral it leaves behind through
+ * an update with no time step and a small error, whose output is kP * error + integral. It prints whether each check
+ * passed, and exits with 1 if any failed:
+ * - anti windup stops integrating while the output is saturated by the error
+ * - the integral zone clears the integral when the error leaves the zone, even while the output is saturated, which
+ *   anti windup would otherwise undo
+ * - the integral is kI * error * dt, so changing kI doesn't make the output jump
+ * - the derivative on measurement doesn't kick when the target changes
+ * - the slew limit limits the change of the output per second
+ *
+ *   make -C host tools && host/build/tools/pidCheck
+ */
+#include "controller/pid.hpp"
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+
+constexpr Time PERIOD = 10_ms;
+
+static int failures = 0;
+
+static void check(const char* name, double value, double expected, double tolerance = 1e-6) {
+    const bool passed = std::abs(value - expected) <= tolerance;
+    if (!passed) failures++;
+    std::printf("%-4s %-55s %9.4f  expected %9.4f\n", passed ? "ok" : "FAIL", name, value, expected);
+}
+
+// the output of an update with no time step, which is kP * error + integral when there's no derivative. The error
+// has to be small enough not to saturate the output
+template <unsigned Features> static double integralOf(PID<Features>& pid, double error, double kP) {
+    return pid.update({error, 0}, 0_ms) - kP * error;
+}
+
+int main() {
+    constexpr unsigned INTEGRAL = PID_ANTI_WINDUP | PID_OUTPUT_CLAMP | PID_INTEGRAL_ZONE;
+    {
+        // an error of 20 saturates the output, so nothing is integrated
+        PID<INTEGRAL> pid({1, 2, 0, 0});
+        for (int i = 0; i < 100; i++) pid.update({20, 0}, PERIOD);
+        check("anti windup holds the integral while saturated", integralOf(pid, 0.5, 1), 0);
+    }
+    {
+        // build up an integral inside the zone, then leave it with an error that saturates the output
+        PIDSettings settings;
+        settings.integralZone = 1;
+        PID<INTEGRAL> pid({1, 2, 0, 0}, settings);
+        for (int i = 0; i < 100; i++) pid.update({0.5, 0}, PERIOD);
+        check("integral inside the zone", integralOf(pid, 0.5, 1), 2 * 0.5 * 0.99, 1e-3);
+        pid.update({20, 0}, PERIOD);
+        check("integral zone clears the integral while saturated", integralOf(pid, 0.5, 1), 0);
+    }
+    {
+        // doubling kI only doubles how fast the integral grows from then on
+        PID<PID_NONE> pid({1, 2, 0, 0});
+        for (int i = 0; i < 100; i++) pid.update({1, 0}, PERIOD);
+        const double before = pid.update({1, 0}, 0_ms);
+        pid.setGains({1, 4, 0, 0});
+        check("changing kI doesn't move the output", pid.update({1, 0}, 0_ms), before);
+    }
+    {
+        // after settling on a target, moving the target only changes the proportional term
+        PID<PID_DERIVATIVE_ON_MEASUREMENT> pid({1, 0, 1, 0});
+        for (int i = 0; i < 10; i++) pid.update({0, 0}, PERIOD);
+        check("derivative on measurement doesn't kick", pid.update({5, 0}, PERIOD), 5);
+    }
+    {
+        // the output can change by at most maxSlew * dt per update
+        PID<PID_SLEW> pid({10, 0, 0, 0});
+        check("slew limits the first output", pid.update({1, 0}, PERIOD), 120 * to_sec(PERIOD));
+    }
+    std::printf("\n%d failed\n", failures);
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,195 @@
+/**
+ * Push the robot off its trajectory, and compare how it recovers with and without the disturbance observer
+ *
+ * Follows a straight trajectory with RamseteMotion through Chassis on the simulated drivetrain. Partway through, a
+ * defender pushes the robot back and to the side, by applying a force to each side of the drivetrain. The first
+ * configuration has no observer, the second only detects the push, and the third cancels it too. A last run without
+ * a push counts false detections while the robot accelerates. For every run it prints:
+ * - the RMS and maximum position error relative to the trajectory
+ * - how long after the push starts it is detected, and how many milliseconds were reported pushed outside of the push
+ * - the mean force estimated during the push, against the force applied
+ *
+ *   make -C host tools && host/build/tools/pushSim [options]
+ *
+ *   --left volts      force of the push on the left wheels. Default -4
+ *   --right volts     force of the push on the right wheels. Default -2
+ */
+#include "sim/sim.hpp"
+#include "chassis.hpp"
+#include "hardware/encoder/motorEncoder.hpp"
+#include "hardware/imu/v5_imu.hpp"
+#include "motion/ramsete.hpp"
+#include "odometry/perpWheelOdom.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+// geometry of the simulated robot
+constexpr int IMU_PORT = 7;
+constexpr double GEAR_RATIO = 0.75;
+constexpr Length WHEEL_DIAMETER = 3.25_in;
+constexpr Length TRACK_WIDTH = 12_in;
+constexpr Time DURATION = 3_sec;
+constexpr Time PUSH_START = 1_sec;
+constexpr Time PUSH_END = 1.6_sec;
+
+/**
+ * @brief the observer of a run, and whether the robot is pushed
+ *
+ */
+struct Configuration {
+        const char* name;
+        std::optional<DisturbanceSettings> observer; /** std::nullopt for no observer */
+        bool push;
+};
+
+// straight line with acceleration limited ramps, starting where the simulated robot starts
+static Trajectory straight() {
+    std::vector<TrajectoryPoint> points;
+    double y = 0;
+    const double dt = 0.01;
+    for (double t = 0; t <= to_sec(DURATION) + 1e-9; t += dt) {
+        const double velocity = std::clamp(std::min(t, to_sec(DURATION) - t) * 3, 0.0, 1.2);
+        points.push_back({from_sec(t), units::Pose(0_m, from_m(y), 90_stDeg), from_mps(velocity), 0_radps});
+        y += velocity * dt;
+    }
+    return Trajectory(points);
+}
+
+/**
+ * @brief odometry which stops reading the sensors once its run is over
+ *
+ * The chassis tasks never end, so the odometry of old runs would read the sensors of the next runs
+ */
+class RunOdometry : public Odometry {
+    public:
+        RunOdometry(std::shared_ptr<Odometry> odometry)
+            : odometry(odometry) {}
+
+        void calibrate() override { odometry->calibrate(); }
+
+        units::Pose update() override {
+            if (active) pose = odometry->update();
+            return pose;
+        }
+
+        void setPose(units::Pose pose) override {
+            odometry->setPose(pose);
+            this->pose = pose;
+        }
+
+        bool active = true;
+    private:
+        const std::shared_ptr<Odometry> odometry;
+};
+
+int main(int argc, char** argv) {
+    double leftPush = -4;
+    double rightPush = -2;
+    for (int i = 1; i < argc; i++) {
+        const std::string arg = argv[i];
+        if (arg == "--left" && i + 1 < argc) leftPush = std::stod(argv[++i]);
+        else if (arg == "--right" && i + 1 < argc) rightPush = std::stod(argv[++i]);
+        else {
+            std::fprintf(stderr, "unknown or incomplete option %s, see the top of pushSim.cpp\n", arg.c_str());
+            return 1;
+        }
+    }
+    DisturbanceSettings detectOnly;
+    detectOnly.compensation = 0;
+    const std::vector<Configuration> configurations = {
+        {"no observer", std::nullopt, true},
+        {"detect only", detectOnly, true},
+        {"compensate", DisturbanceSettings {}, true},
+        {"compensate, no push", DisturbanceSettings {}, false},
+    };
+    const Trajectory trajectory = straight();
+    // the chassis tasks never end, so the chassis of every run is kept
+    std::vector<std::unique_ptr<Chassis>> chassis;
+    std::printf("push of %.1f V on the left and %.1f V on the right, from %.1f s to %.1f s\n\n", leftPush, rightPush,
+                to_sec(PUSH_START), to_sec(PUSH_END));
+    std::printf("%-20s %8s %8s %11s %10s %16s\n", "observer", "rms(in)", "max(in)", "detect(ms)", "false(ms)",
+                "force(V) l / r");
+    for (const Configuration& configuration : configurations) {
+        sim::reset();
+        sim::DrivetrainState& drivetrain = sim::drivetrain();
+        drivetrain.leftMotors = {1, 2};
+        drivetrain.rightMotors = {3, 4};
+        drivetrain.imuPort = IMU_PORT;
+        drivetrain.gearRatio = GEAR_RATIO;
+        drivetrain.wheelDiameter = WHEEL_DIAMETER;
+        drivetrain.trackWidth = TRACK_WIDTH;
+        sim::imu(IMU_PORT).calibrationEnd = 0_sec;
+        auto leftDrive = std::make_shared<MotorGroup>(std::initializer_list<int> {1, 2}, Cartridge::BLUE, GEAR_RATIO);
+        auto rightDrive =
+            std::make_shared<MotorGroup>(std::initializer_list<int> {3, 4}, Cartridge::BLUE, GEAR_RATIO);
+        // track with the left drive, which is to the left of the tracking center
+        auto vertical = std::make_shared<TrackingWheel>(
+            std::make_shared<MotorEncoder>(leftDrive), WHEEL_DIAMETER / 2, TRACK_WIDTH / 2);
+        auto odometry = std::make_shared<RunOdometry>(
+            std::make_shared<PerpWheelOdom>(vertical, nullptr, std::make_shared<V5IMU>(IMU_PORT)));
+        const FeedforwardGains linear {drivetrain.kS, drivetrain.kV, drivetrain.kA};
+        const FeedforwardGains angular {drivetrain.kS, drivetrain.kV, drivetrain.angularKA};
+        const ChassisRates rates;
+        std::shared_ptr<DisturbanceObserver> observer = nullptr;
+        if (configuration.observer)
+            observer = std::make_shared<DisturbanceObserver>(linear, angular, *configuration.observer,
+                                                             rates.velocityPeriod);
+        chassis.push_back(std::make_unique<Chassis>(
+            leftDrive, rightDrive, odometry, TRACK_WIDTH, WHEEL_DIAMETER, std::make_shared<VAPID>(linear, 4, 0, 0),
+            std::make_shared<VAPID>(linear, 4, 0, 0), std::make_shared<PID<>>(PIDGains {}),
+            std::make_shared<PID<>>(PIDGains {}), ChassisOptions {.rates = rates, .disturbanceObserver = observer}));
+        chassis.back()->initialize();
+        chassis.back()->setPose({0_m, 0_m, 90_stDeg});
+        chassis.back()->move(std::make_unique<RamseteMotion>(trajectory, TRACK_WIDTH));
+        // measure every millisecond
+        const Time start = sim::now();
+        double squaredError = 0;
+        double maxError = 0;
+        int samples = 0;
+        std::optional<double> detected;
+        int falseTime = 0;
+        double leftForce = 0;
+        double rightForce = 0;
+        int pushSamples = 0;
+        while (sim::now() - start < trajectory.getDuration()) {
+            const Time elapsed = sim::now() - start;
+            const bool pushing = configuration.push && elapsed >= PUSH_START && elapsed < PUSH_END;
+            // the push is still reported while the estimate decays after it ends
+            const bool decaying = configuration.push && elapsed >= PUSH_END && elapsed < PUSH_END + 50_ms;
+            drivetrain.leftForce = pushing ? leftPush : 0;
+            drivetrain.rightForce = pushing ? rightPush : 0;
+            sim::runFor(1_ms);
+            units::Pose target = trajectory.sample(sim::now() - start).pose;
+            const double error =
+                std::hypot(drivetrain.x - to_m(target.getX()), drivetrain.y - to_m(target.getY())) / to_m(1_in);
+            squaredError += error * error;
+            maxError = std::max(maxError, error);
+            samples++;
+            const DisturbanceSignal signal = chassis.back()->getDisturbance();
+            if (pushing) {
+                if (!detected && signal.pushed) detected = to_sec(elapsed - PUSH_START);
+                leftForce += signal.leftForce;
+                rightForce += signal.rightForce;
+                pushSamples++;
+            } else if (signal.pushed && !decaying) {
+                falseTime++;
+            }
+        }
+        chassis.back()->stopMotion();
+        odometry->active = false;
+        std::printf("%-20s %8.3f %8.3f ", configuration.name, std::sqrt(squaredError / samples), maxError);
+        if (detected) std::printf("%11.0f ", *detected * 1000);
+        else std::printf("%11s ", "-");
+        std::printf("%10d ", falseTime);
+        if (pushSamples > 0 && observer != nullptr)
+            std::printf("%7.2f / %5.2f\n", leftForce / pushSamples, rightForce / pushSamples);
+        else std::printf("%16s\n", "-");
+    }
+    std::exit(0);
+}
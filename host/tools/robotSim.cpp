@@ -0,0 +1,70 @@
+/**
+ * Run the routines which measure the gains on the robot configuration of devices.cpp
+ *
+ * The other tools build a chassis with every controller set, but the robot in devices.cpp starts with its
+ * controllers unset or untuned, since these routines are how their gains are measured. This runs them on the chassis
+ * of devices.cpp, on a simulated drivetrain with the same motor ports and geometry, so they're checked with the
+ * configuration the robot actually has:
+ * - Chassis::characterize(), comparing the fitted gains to the ones of the simulated drivetrain
+ * - Chassis::autotune() on each loop, with the static friction from the characterization
+ *
+ *   make -C host tools && host/build/tools/robotSim
+ */
+#include "sim/sim.hpp"
+#include "devices.hpp"
+#include <cstdio>
+#include <cstdlib>
+
+// the drivetrain of devices.cpp
+constexpr int IMU_PORT = 7;
+constexpr double GEAR_RATIO = 0.75;
+constexpr Length WHEEL_DIAMETER = 3.25_in;
+constexpr Length TRACK_WIDTH = 12_in;
+
+static void printGains(const char* name, const FeedforwardGains& gains) {
+    std::printf("  %-8s kS %.3f  kV %.3f  kA %.3f  r^2 %.4f\n", name, gains.kS, gains.kV, gains.kA, gains.rSquared);
+}
+
+int main() {
+    sim::reset();
+    sim::DrivetrainState& drivetrain = sim::drivetrain();
+    drivetrain.leftMotors = {1, 2};
+    drivetrain.rightMotors = {3, 4};
+    drivetrain.imuPort = IMU_PORT;
+    drivetrain.gearRatio = GEAR_RATIO;
+    drivetrain.wheelDiameter = WHEEL_DIAMETER;
+    drivetrain.trackWidth = TRACK_WIDTH;
+    sim::imu(IMU_PORT).calibrationEnd = 0_sec;
+    chassis.initialize();
+    std::printf("simulated drivetrain: kS %.2f V  kV %.2f V/(m/s)  kA %.2f V/(m/s^2)  turning kA %.2f V/(m/s^2)\n\n",
+                drivetrain.kS, drivetrain.kV, drivetrain.kA, drivetrain.angularKA);
+    // characterize the drivetrain, without writing to the SD card
+    SysIdSettings sysid;
+    sysid.samplesPath = "";
+    sysid.resultPath = "";
+    const SysIdResult result = chassis.characterize(sysid);
+    std::printf("characterization\n");
+    printGains("left", result.left);
+    printGains("right", result.right);
+    printGains("angular", result.angular);
+    std::printf("  track width %.2f in\n\n", to_in(result.trackWidth));
+    // autotune each loop, letting the robot come to rest in between
+    AutotuneSettings autotune;
+    autotune.kS = (result.left.kS + result.right.kS) / 2;
+    autotune.resultPath = "";
+    const char* names[] = {"linear position", "angular position", "wheel velocity"};
+    for (int loop : {AUTOTUNE_LINEAR_POSITION, AUTOTUNE_ANGULAR_POSITION, AUTOTUNE_WHEEL_VELOCITY}) {
+        sim::runFor(1_sec);
+        std::printf("%s\n", names[loop]);
+        const std::optional<AutotuneResult> tuned = chassis.autotune(loop, autotune);
+        if (!tuned) {
+            std::printf("  timed out\n\n");
+            continue;
+        }
+        const PIDGains& gains = tuned->gains;
+        std::printf("  Ku %.3f  Tu %.3f s  period spread %.1f%%\n", tuned->relay.ultimateGain,
+                    to_sec(tuned->relay.ultimatePeriod), tuned->relay.periodSpread * 100);
+        std::printf("  kP %.3f  kI %.3f  kD %.4f  kS %.2f\n\n", gains.kP, gains.kI, gains.kD, gains.kS);
+    }
+    std::exit(0);
+}
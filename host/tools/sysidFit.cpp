@@ -0,0 +1,74 @@
+/**
+ * Fit drivetrain feedforward gains from characterization samples
+ *
+ * Reads samples written by Chassis::characterize() from the SD card, and fits the same gains the robot does. This
+ * lets samples be refit with different settings, or several runs be combined into one fit.
+ *
+ *   make -C host tools && host/build/tools/sysidFit [options] samples.csv...
+ *
+ *   --window n        recalculate the accelerations as differences over n samples on each side. By default the
+ *                     accelerations in the files are used
+ *   --min-velocity v  skip samples slower than v meters per second. Default 0.02
+ *   --output path     write the result to path, in the format readSysIdResult() reads
+ */
+#include "controller/sysid.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <optional>
+#include <string>
+
+static void print(const char* name, const std::optional<FeedforwardGains>& gains) {
+    if (!gains) {
+        std::printf("%-8s not enough samples\n", name);
+        return;
+    }
+    std::printf("%-8s kS %7.4f V  kV %7.4f V/(m/s)  kA %7.4f V/(m/s^2)  r^2 %.4f\n", name, gains->kS, gains->kV,
+                gains->kA, gains->rSquared);
+}
+
+int main(int argc, char** argv) {
+    std::optional<int> window;
+    LinearVelocity minVelocity = 0.02_mps;
+    std::string output;
+    std::vector<SysIdSample> samples;
+    for (int i = 1; i < argc; i++) {
+        const std::string arg = argv[i];
+        const bool hasValue = i + 1 < argc;
+        if (arg == "--window" && hasValue) window = std::stoi(argv[++i]);
+        else if (arg == "--min-velocity" && hasValue) minVelocity = from_mps(std::stod(argv[++i]));
+        else if (arg == "--output" && hasValue) output = argv[++i];
+        else if (arg.starts_with("--")) {
+            std::fprintf(stderr, "unknown or incomplete option %s, see the top of sysidFit.cpp\n", arg.c_str());
+            return 1;
+        } else {
+            std::ifstream file(arg);
+            if (!file) {
+                std::fprintf(stderr, "can't open %s\n", arg.c_str());
+                return 1;
+            }
+            std::vector<SysIdSample> read = readSysIdSamples(file);
+            // number the runs of each file after those of the previous files, so runs of different files are apart
+            int firstRun = 0;
+            for (const SysIdSample& sample : samples) firstRun = std::max(firstRun, sample.run + 1);
+            for (SysIdSample& sample : read) sample.run += firstRun;
+            std::printf("%s: %zu samples\n", arg.c_str(), read.size());
+            samples.insert(samples.end(), read.begin(), read.end());
+        }
+    }
+    if (samples.empty()) {
+        std::fprintf(stderr, "usage: sysidFit [options] samples.csv...\n");
+        return 1;
+    }
+    if (window) computeAccelerations(samples, *window);
+    print("left", fitFeedforward(samples, true, false, minVelocity));
+    print("right", fitFeedforward(samples, false, false, minVelocity));
+    print("turn L", fitFeedforward(samples, true, true, minVelocity));
+    print("turn R", fitFeedforward(samples, false, true, minVelocity));
+    const SysIdResult result = fitSysId(samples, minVelocity);
+    std::printf("effective track width %.3f in\n", to_in(result.trackWidth));
+    if (!output.empty()) {
+        std::ofstream file(output);
+        writeSysIdResult(file, result);
+    }
+}
@@ -0,0 +1,216 @@
+/**
+ * Check the motor thermal model against recorded telemetry
+ *
+ * Replays the current and temperature of each motor through MotorThermalModel, like PowerBudget does on the robot,
+ * and prints for every motor:
+ * - the RMS error between the estimate and the measured temperature. The motor reports its temperature in steps of
+ *   5 degrees C, so this is at least about 1.4 degrees C even for a perfect model
+ * - when the temperature first reached the derate temperature, and when the model predicted it would, from the
+ *   current averaged over the last 2 seconds, at a few times before
+ *
+ * The telemetry is a CSV file with a header line, and a row per motor per sample. Log it on the robot by printing
+ * Motor::getCurrent() and Motor::getTemperature() of every drive motor every 20 ms or so:
+ *
+ *   time,motor,current,temperature      seconds, index of the motor, amps, degrees C
+ *
+ * Without a file, it generates the telemetry of a 60 s skills run of a drive whose motors heat faster than the
+ * default parameters say, with temperatures rounded to 5 degrees C like the motor reports them.
+ *
+ *   make -C host tools && host/build/tools/thermalCheck [telemetry.csv] [options]
+ *
+ *   --fit            fit the thermal resistance and capacitance to the telemetry, and check the fitted model too
+ *   --ambient C      temperature of the air, in degrees C. Default 25
+ *   --write path     write the generated telemetry to a CSV file
+ */
+#include "hardware/motor/thermalModel.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+constexpr Time AVERAGING_WINDOW = 2_sec; // same as PowerBudget
+constexpr double REPORTED_STEP = 5; // resolution of the temperature the motor reports, in degrees C
+
+/**
+ * @brief a telemetry sample of a motor
+ *
+ */
+struct Sample {
+        double time; /** seconds */
+        double current; /** amps */
+        double temperature; /** measured temperature, in degrees C */
+        double trueTemperature; /** actual temperature of generated telemetry, NaN if it was recorded */
+};
+
+// read a telemetry file, grouped by motor
+static std::map<int, std::vector<Sample>> readTelemetry(const std::string& path) {
+    std::map<int, std::vector<Sample>> telemetry;
+    std::ifstream file(path);
+    std::string line;
+    std::getline(file, line); // header
+    while (std::getline(file, line)) {
+        std::stringstream stream(line);
+        std::string field;
+        std::vector<double> fields;
+        while (std::getline(stream, field, ',')) fields.push_back(std::stod(field));
+        if (fields.size() != 4) continue;
+        telemetry[int(fields[1])].push_back({fields[0], fields[2], fields[3], NAN});
+    }
+    return telemetry;
+}
+
+// simulate a skills run: bursts of hard acceleration, cruising and short stops, repeated for 60 seconds. The motors
+// are still warm from practice when it starts
+static std::map<int, std::vector<Sample>> generateTelemetry() {
+    // the motors heat faster than the defaults say, and the motors on one side work harder
+    ThermalParameters truth;
+    truth.windingResistance = 2.2;
+    truth.thermalResistance = 5;
+    truth.thermalCapacitance = 20;
+    const std::vector<double> loads = {1.1, 1.05, 0.95, 0.9};
+    std::map<int, std::vector<Sample>> telemetry;
+    const double dt = 0.02;
+    for (size_t motor = 0; motor < loads.size(); motor++) {
+        double temperature = 40;
+        for (double t = 0; t <= 60 + 1e-9; t += dt) {
+            const double phase = std::fmod(t, 6);
+            const double current = loads[motor] * (phase < 1.5 ? 2.5 : phase < 5 ? 2 : 0.3);
+            const double power = current * current * truth.windingResistance;
+            const double cooling = (temperature - truth.ambientTemperature) / truth.thermalResistance;
+            temperature += (power - cooling) / truth.thermalCapacitance * dt;
+            const double reported = std::round(temperature / REPORTED_STEP) * REPORTED_STEP;
+            telemetry[int(motor)].push_back({t, current, reported, temperature});
+        }
+    }
+    return telemetry;
+}
+
+/**
+ * @brief result of replaying a motor's telemetry through the model
+ *
+ */
+struct Replay {
+        double rmsError = 0; /** against the measured temperature, degrees C */
+        double rmsTrueError = NAN; /** against the actual temperature, if it's known */
+        std::vector<std::pair<double, double>> predictions; /** time of the prediction, predicted derate time */
+};
+
+static Replay replay(const std::vector<Sample>& samples, ThermalParameters parameters) {
+    MotorThermalModel model(parameters);
+    Replay result;
+    double squaredError = 0;
+    double squaredTrueError = 0;
+    double averageCurrent = 0;
+    double nextPrediction = 10;
+    for (size_t i = 0; i < samples.size(); i++) {
+        const Sample& sample = samples[i];
+        const double dt = (i == 0) ? 0 : sample.time - samples[i - 1].time;
+        model.update(from_amp(sample.current), sample.temperature, from_sec(dt));
+        averageCurrent += (sample.current - averageCurrent) * std::min(1.0, dt / to_sec(AVERAGING_WINDOW));
+        squaredError += std::pow(model.getTemperature() - sample.temperature, 2);
+        squaredTrueError += std::pow(model.getTemperature() - sample.trueTemperature, 2);
+        if (sample.time >= nextPrediction) {
+            const std::optional<Time> left = model.getTimeToDerate(from_amp(averageCurrent));
+            result.predictions.push_back({sample.time, left ? sample.time + to_sec(*left) : INFINITY});
+            nextPrediction += 10;
+        }
+    }
+    result.rmsError = std::sqrt(squaredError / samples.size());
+    result.rmsTrueError = std::sqrt(squaredTrueError / samples.size());
+    return result;
+}
+
+// grid search of the thermal resistance and capacitance which predict the measured temperature best, without
+// correcting the estimate with the measurement
+static ThermalParameters fit(const std::map<int, std::vector<Sample>>& telemetry, ThermalParameters parameters) {
+    ThermalParameters best = parameters;
+    double bestError = INFINITY;
+    for (double resistance = 1; resistance <= 8 + 1e-9; resistance += 0.1) {
+        for (double capacitance = 10; capacitance <= 150 + 1e-9; capacitance += 1) {
+            ThermalParameters candidate = parameters;
+            candidate.thermalResistance = resistance;
+            candidate.thermalCapacitance = capacitance;
+            candidate.observerGain = 0;
+            double error = 0;
+            for (const auto& [motor, samples] : telemetry) error += std::pow(replay(samples, candidate).rmsError, 2);
+            if (error < bestError) {
+                bestError = error;
+                best = candidate;
+            }
+        }
+    }
+    best.observerGain = parameters.observerGain;
+    return best;
+}
+
+static void check(const std::map<int, std::vector<Sample>>& telemetry, ThermalParameters parameters) {
+    std::printf("%5s %9s %10s %9s   %s\n", "motor", "rms(C)", "true(C)", "derate(s)",
+                "predicted derate(s) at 10 s, 20 s, ...");
+    for (const auto& [motor, samples] : telemetry) {
+        const Replay result = replay(samples, parameters);
+        std::optional<double> derate;
+        for (const Sample& sample : samples) {
+            // the measurement is rounded, so use the actual temperature if it's known
+            const double temperature = std::isnan(sample.trueTemperature) ? sample.temperature : sample.trueTemperature;
+            if (temperature >= parameters.derateTemperature) {
+                derate = sample.time;
+                break;
+            }
+        }
+        std::printf("%5d %9.2f %10.2f ", motor, result.rmsError, result.rmsTrueError);
+        if (derate) std::printf("%9.1f  ", *derate);
+        else std::printf("%9s  ", "never");
+        for (const auto& [time, predicted] : result.predictions) {
+            if (derate && time >= *derate) break;
+            if (std::isfinite(predicted)) std::printf(" %6.1f", predicted);
+            else std::printf(" %6s", "never");
+        }
+        std::printf("\n");
+    }
+}
+
+int main(int argc, char** argv) {
+    std::string path;
+    std::string writePath;
+    bool fitParameters = false;
+    ThermalParameters parameters;
+    for (int i = 1; i < argc; i++) {
+        const std::string arg = argv[i];
+        if (arg == "--fit") fitParameters = true;
+        else if (arg == "--write" && i + 1 < argc) writePath = argv[++i];
+        else if (arg == "--ambient" && i + 1 < argc) parameters.ambientTemperature = std::stod(argv[++i]);
+        else if (arg.rfind("--", 0) != 0 && path.empty()) path = arg;
+        else {
+            std::fprintf(stderr, "unknown or incomplete option %s, see the top of thermalCheck.cpp\n", arg.c_str());
+            return 1;
+        }
+    }
+    const std::map<int, std::vector<Sample>> telemetry = path.empty() ? generateTelemetry() : readTelemetry(path);
+    if (telemetry.empty()) {
+        std::fprintf(stderr, "no telemetry in %s\n", path.c_str());
+        return 1;
+    }
+    if (!writePath.empty()) {
+        std::ofstream file(writePath);
+        file << "time,motor,current,temperature\n";
+        for (const auto& [motor, samples] : telemetry)
+            for (const Sample& sample : samples)
+                file << sample.time << ',' << motor << ',' << sample.current << ',' << sample.temperature << '\n';
+    }
+    std::printf("placeholder parameters: %.1f C/W, %.0f J/C\n", parameters.thermalResistance,
+                parameters.thermalCapacitance);
+    check(telemetry, parameters);
+    if (fitParameters) {
+        parameters = fit(telemetry, parameters);
+        std::printf("\nfitted parameters: %.1f C/W, %.0f J/C\n", parameters.thermalResistance,
+                    parameters.thermalCapacitance);
+        check(telemetry, parameters);
+        std::printf("\nset thermalResistance = %.1f and thermalCapacitance = %.0f in the parameters of the budget\n",
+                    parameters.thermalResistance, parameters.thermalCapacitance);
+    }
+    return 0;
+}
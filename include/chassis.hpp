@@ -1,32 +1,82 @@
 #pragma once
 
+#include "controller/disturbanceObserver.hpp"
+#include "controller/lqr.hpp"
+#include "controller/pid.hpp"
 #include "controller/vapid.hpp"
+#include "motion/autotune.hpp"
+#include "motion/characterization.hpp"
 #include "motion/motion.hpp"
 #include "odometry/odometry.hpp"
-#include "pros/motor_group.hpp"
+#include "odometry/slipDetector.hpp"
+#include "odometry/wallRelocalizer.hpp"
+#include "hardware/motor/thermalModel.hpp"
+#include "hardware/motor/motorGroup.hpp"
 #include "pros/rtos.hpp"
 #include <memory>
 
+/**
+ * @brief rates of the control loops of #Chassis
+ *
+ * The loops are cascaded: the motion turns the pose into velocity and acceleration targets, and the velocity
+ * controllers turn the targets and the measured velocities into voltages. The velocity loop can run faster than the
+ * motion, since it only reads the motors, but V5 motors only report a new velocity every 10 ms, so a faster velocity
+ * loop mostly reacts to the same sample again. The motion period is rounded to a multiple of the velocity period
+ */
+struct ChassisRates {
+        Time motionPeriod = 10_ms; /** time between updates of odometry and the motion */
+        Time velocityPeriod = 10_ms; /** time between updates of the velocity controllers */
+};
+
+/**
+ * @brief optional parts of #Chassis
+ *
+ * Every part defaults to nullptr, which disables it, so only the parts a robot has need to be set, by name:
+ *
+ * Chassis chassis(..., {.slipDetector = slipDetector, .rates = {10_ms, 10_ms}});
+ *
+ * A #DriveLQR or #DisturbanceObserver should be constructed with the velocity period of the rates
+ */
+struct ChassisOptions {
+        std::shared_ptr<SlipDetector> slipDetector = nullptr; /** detects the wheels slipping */
+        std::shared_ptr<PowerBudget> powerBudget = nullptr; /** keeps the drive motors cool. Its period starts
+                                                               whenever the robot is enabled */
+        std::shared_ptr<WallRelocalizer> relocalizer = nullptr; /** corrects the pose with distance sensors */
+        /** controls the velocities of both sides together, like #DriveLQR, in place of the left and right velocity
+         * controllers */
+        std::shared_ptr<Controller<DriveVelocityInput, DriveVoltages>> driveVelocityController = nullptr;
+        ChassisRates rates = {}; /** the rates of the control loops */
+        std::shared_ptr<DisturbanceObserver> disturbanceObserver = nullptr; /** cancels external forces */
+};
+
 class Chassis {
     public:
         /**
          * @brief Construct a new Chassis object
          *
+         * The controllers can be nullptr until they're tuned, so the robot can already run open loop motions. A motion
+         * which outputs velocity targets is stopped if there are no velocity controllers to follow them
+         *
          * @param leftDrive shared ptr to the left drive motor group
          * @param rightDrive shared ptr to the right drive motor group
          * @param odometry shared ptr to the odometry object
          * @param trackWidth the distance between the left and right wheels
+         * @param wheelDiameter the diameter of the drive wheels
          * @param leftVelocityController shared ptr to the linear velocity controller
          * @param rightVelocityController shared ptr to the angular velocity controller
-         * @param linearPositionController shared ptr to the linear position controller
-         * @param angularPositionController shared ptr to the angular position controller
+         * @param linearPositionController shared ptr to the linear position controller. Takes meters, outputs volts
+         * @param angularPositionController shared ptr to the angular position controller. Takes radians, outputs
+         * volts
+         * @param options the optional parts of the chassis, see #ChassisOptions. Defaults to none of them, and 10 ms
+         * for both loops
          */
-        Chassis(const std::shared_ptr<pros::MotorGroup> leftDrive, const std::shared_ptr<pros::MotorGroup> rightDrive,
-                const std::shared_ptr<Odometry> odometry, const Length trackWidth,
+        Chassis(const std::shared_ptr<MotorGroup> leftDrive, const std::shared_ptr<MotorGroup> rightDrive,
+                const std::shared_ptr<Odometry> odometry, const Length trackWidth, const Length wheelDiameter,
                 const std::shared_ptr<Controller<VelocityControllerInput, double>> leftVelocityController,
                 const std::shared_ptr<Controller<VelocityControllerInput, double>> rightVelocityController,
-                const std::shared_ptr<Controller<double, double>> linearPositionController,
-                const std::shared_ptr<Controller<double, double>> angularPositionController);
+                const std::shared_ptr<Controller<PositionControllerInput, double>> linearPositionController,
+                const std::shared_ptr<Controller<PositionControllerInput, double>> angularPositionController,
+                const ChassisOptions options = {});
         /**
          * @brief initialize the chassis thread, and calibrate sensors
          *
@@ -38,6 +88,32 @@ class Chassis {
          * @param motion
          */
         void move(std::unique_ptr<Motion> motion);
+        /**
+         * @brief characterize the drivetrain, and fit its feedforward gains
+         *
+         * Runs quasistatic and dynamic tests driving forwards, backwards, and turning both ways, then fits kS, kV and
+         * kA of each side and of turning, and the effective track width. The samples and the result are written to
+         * the paths in the settings, and the result can be loaded into #VAPID. This blocks until every test is done,
+         * and the robot needs room to drive the maximum distance of the settings in both directions.
+         *
+         * @param settings the settings of the characterization
+         * @return SysIdResult the fitted gains
+         */
+        SysIdResult characterize(SysIdSettings settings = {});
+        /**
+         * @brief autotune a loop of the chassis with relay feedback
+         *
+         * Puts the loop into relay oscillation, measures its ultimate gain and period, and proposes PID gains with
+         * the tuning rule of the settings. The result is written to the path in the settings. The gains aren't
+         * applied, since the controllers are only known by their interface, so copy them into the constructor of the
+         * controller. This blocks until the autotuner is done. The kS of the proposed gains of a position loop is
+         * the kS of the settings, since the loop was measured with the friction cancelled.
+         *
+         * @param loop the loop to tune, see #AutotuneLoop
+         * @param settings the settings of the autotuner
+         * @return std::optional<AutotuneResult> the result, or std::nullopt if the autotuner timed out
+         */
+        std::optional<AutotuneResult> autotune(int loop, AutotuneSettings settings = {});
         /**
          * @brief stop the current motion
          *
@@ -68,22 +144,68 @@ class Chassis {
          * @param pose
          */
         void setPose(units::Pose pose);
+        /**
+         * @brief Get the traction signal calculated on the last update
+         *
+         * Motions and opcontrol can use this to cut power or to flag the pose as uncertain
+         *
+         * @return TractionSignal the traction signal. Always #TRACTION_OK if there is no slip detector
+         */
+        TractionSignal getTraction();
+        /**
+         * @brief Get the power budget of the drive calculated on the last update
+         *
+         * Motions can scale their maximum velocity by this to avoid the drive motors overheating
+         *
+         * @return double from 0 to 1. Always 1 if there is no power budget
+         */
+        double getPowerBudget();
+        /**
+         * @brief Get the disturbance signal calculated on the last update
+         *
+         * Motions and opcontrol can use this to react to being pushed, for example by holding their position
+         *
+         * @return DisturbanceSignal the disturbance signal. Never pushed if there is no disturbance observer
+         */
+        DisturbanceSignal getDisturbance();
     protected:
         /**
-         * @brief update odometry the motion alg, and velocity controllers
+         * @brief update the control loops. Called every velocity period
          *
+         * Odometry and the motion are updated every motion period. Between updates of the motion, velocity targets
+         * move with their acceleration, so the velocity controllers follow a ramp instead of a staircase
          */
         void update();
+        /**
+         * @brief apply a voltage to the left and right drive motors
+         *
+         * @param left left drive voltage
+         * @param right right drive voltage
+         */
+        void moveVoltage(Voltage left, Voltage right);
         int prevCompState = -1;
+        bool wasEnabled = false; /** whether the robot was enabled on the last update */
         const Length trackWidth;
-        // TODO: replace with LemLib motor abstraction
-        const std::shared_ptr<pros::MotorGroup> leftDrive;
-        const std::shared_ptr<pros::MotorGroup> rightDrive;
+        const Length wheelDiameter;
+        const std::shared_ptr<MotorGroup> leftDrive;
+        const std::shared_ptr<MotorGroup> rightDrive;
         const std::shared_ptr<Odometry> odometry;
         const std::shared_ptr<Controller<VelocityControllerInput, double>> leftVelocityController;
         const std::shared_ptr<Controller<VelocityControllerInput, double>> rightVelocityController;
-        const std::shared_ptr<Controller<double, double>> linearPositionController;
-        const std::shared_ptr<Controller<double, double>> angularPositionController;
+        const std::shared_ptr<Controller<PositionControllerInput, double>> linearPositionController;
+        const std::shared_ptr<Controller<PositionControllerInput, double>> angularPositionController;
+        const std::shared_ptr<SlipDetector> slipDetector;
+        const std::shared_ptr<PowerBudget> powerBudget;
+        const std::shared_ptr<WallRelocalizer> relocalizer;
+        const std::shared_ptr<Controller<DriveVelocityInput, DriveVoltages>> driveVelocityController;
+        const ChassisRates rates;
+        const std::shared_ptr<DisturbanceObserver> disturbanceObserver;
+        const int motionDivider; /** velocity updates per motion update */
+        int ticks = 0; /** velocity updates since the start of the motion */
+        ChassisSpeeds speeds = {}; /** output of the last motion update */
+        Time speedsTime = 0_sec; /** time of the last motion update */
+        double leftEffort = 0; /** effort last commanded to the left drive, from -1 to 1 */
+        double rightEffort = 0; /** effort last commanded to the right drive, from -1 to 1 */
         std::unique_ptr<Motion> motion;
         std::optional<pros::Task> task;
 };
\ No newline at end of file
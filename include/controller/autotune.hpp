@@ -0,0 +1,133 @@
+#pragma once
+
+#include "controller/pid.hpp"
+#include <optional>
+#include <ostream>
+#include <vector>
+
+/**
+ * @brief rules which turn the ultimate gain and period of a loop into PID gains
+ *
+ * We use a regular enum instead of an enum class for consistency with #SysIdTest
+ */
+enum TuningRule {
+    TUNING_ZIEGLER_NICHOLS = 0, /** fast, with about 25% overshoot. Kp = 0.6 Ku, Ti = Tu / 2, Td = Tu / 8 */
+    TUNING_TYREUS_LUYBEN = 1, /** slower and more robust than Ziegler-Nichols. Kp = Ku / 2.2, Ti = 2.2 Tu,
+                                 Td = Tu / 6.3 */
+    TUNING_CONSERVATIVE = 2 /** Ziegler-Nichols without overshoot. Kp = 0.2 Ku, Ti = Tu / 2, Td = Tu / 3 */
+};
+
+/**
+ * @brief the ultimate gain and period of a loop, measured with relay feedback
+ *
+ */
+struct RelayResult {
+        double ultimateGain = 0; /** gain at which the loop oscillates, in output units per error unit */
+        Time ultimatePeriod = 0_sec; /** period of the oscillation at the ultimate gain */
+        double amplitude = 0; /** amplitude of the oscillation of the error */
+        double bias = 0; /** output the relay oscillated around, which holds the loop at its target */
+        double periodSpread = 0; /** (longest period - shortest period) / mean period of the measured cycles. Large
+                                    values mean the oscillation didn't settle, and the result can't be trusted */
+        int cycles = 0; /** how many cycles were measured */
+};
+
+/**
+ * @brief results of autotuning a loop
+ *
+ */
+struct AutotuneResult {
+        RelayResult relay; /** the measured ultimate gain and period */
+        PIDGains gains; /** gains proposed from them */
+};
+
+/**
+ * @brief relay feedback, which makes a loop oscillate at its ultimate period
+ *
+ * The output switches between bias + amplitude and bias - amplitude whenever the error crosses the hysteresis band,
+ * so the loop settles into a limit cycle at the frequency where its phase lag is 180 degrees. The ultimate gain is
+ * 4 * amplitude / (pi * sqrt(a^2 - hysteresis^2)), where a is the amplitude of the error.
+ *
+ * The error is only sampled when the relay is updated, so the sampled peaks of the error fall short of the real ones.
+ * Each peak is interpolated with a parabola through the largest sample and its neighbours, which keeps the amplitude,
+ * and so the ultimate gain, from depending on where the samples land.
+ *
+ * Loops that need a constant output to hold their target, like velocity loops, oscillate asymmetrically unless the
+ * bias matches that output. The bias is corrected at the end of every cycle from the time spent on each side of the
+ * relay, so it doesn't have to be known. The first cycles are discarded while the bias and the oscillation settle.
+ */
+class RelayFeedback {
+    public:
+        /**
+         * @brief Construct a new Relay Feedback object
+         *
+         * @param amplitude how far the output switches from the bias
+         * @param hysteresis half the width of the band the error has to leave before the relay switches. Should
+         * be a few times the noise of the measurement. Defaults to 0
+         * @param cycles how many cycles to measure. Defaults to 4
+         * @param warmupCycles how many cycles to discard first. Defaults to 2
+         * @param bias initial output the relay oscillates around. Defaults to 0
+         */
+        RelayFeedback(double amplitude, double hysteresis = 0, int cycles = 4, int warmupCycles = 2, double bias = 0);
+        /**
+         * @brief calculate the output of the relay
+         *
+         * @param error target - measurement
+         * @param time the current time
+         * @return double the output
+         */
+        double update(double error, Time time);
+        /**
+         * @brief Get whether enough cycles have been measured
+         *
+         * @return true every cycle has been measured
+         * @return false the relay is still running
+         */
+        bool isDone() const;
+        /**
+         * @brief Get the measured ultimate gain and period
+         *
+         * @return std::optional<RelayResult> the result, or std::nullopt if no cycles have been measured yet
+         */
+        std::optional<RelayResult> getResult() const;
+        /**
+         * @brief discard every measurement, and start again from the initial bias
+         *
+         */
+        void reset();
+    private:
+        const double amplitude;
+        const double hysteresis;
+        const int cycles;
+        const int warmupCycles;
+        const double initialBias;
+        double bias;
+        std::optional<bool> high; /** whether the output is above the bias, unset before the first update */
+        std::optional<Time> lastRise; /** when the output last switched high, unset before the first full cycle */
+        Time lastFall = 0_sec; /** when the output last switched low */
+        double maxError = -INFINITY; /** largest error since the last rise */
+        double minError = INFINITY; /** smallest error since the last rise */
+        std::optional<double> prevError; /** error of the last update */
+        std::optional<double> prevPrevError; /** error of the update before that */
+        int completedCycles = 0;
+        std::vector<Time> periods; /** periods of the measured cycles */
+        std::vector<double> amplitudes; /** amplitudes of the error of the measured cycles */
+};
+
+/**
+ * @brief propose PID gains for a loop
+ *
+ * The gains are in the units of #PIDGains, so the integral and derivative are in seconds. kS is left at 0, see
+ * Chassis::autotune()
+ *
+ * @param result the ultimate gain and period of the loop
+ * @param rule the tuning rule, see #TuningRule
+ * @return PIDGains the proposed gains
+ */
+PIDGains proposeGains(const RelayResult& result, int rule);
+/**
+ * @brief write an autotune result, one value per line as "name value"
+ *
+ * @param stream the stream to write to
+ * @param result the result
+ */
+void writeAutotuneResult(std::ostream& stream, const AutotuneResult& result);
@@ -1,29 +1,63 @@
 #pragma once
 
+#include "timer.hpp"
+#include <optional>
+
 /**
  * @brief Abstract controller class
  *
  * This is used to allow the user to define their own controllers to be used
  * with LemLib. It's templated to allow for any input/output type.
  *
+ * Controllers are stepped with the time since the previous update. Callers that know the time step, like a fixed
+ * rate loop or a simulation, pass it to update(input, dt). Otherwise update(input) measures it with the clock the
+ * controller was constructed with. Implementations only implement update(input, dt), and add
+ * `using Controller::update;` so the overload measuring time stays visible.
+ *
  * @tparam in the type of the input
  * @tparam out the type of the output
  */
 template <typename In, typename Out> class Controller {
     public:
+        /**
+         * @brief Construct a new Controller object
+         *
+         * @param clock the clock used to measure the time between updates. Defaults to Timer::now
+         */
+        Controller(Clock clock = Timer::now)
+            : clock(clock) {}
+
+        /**
+         * @brief Update the controller, measuring the time since the last update with the controller's clock
+         *
+         * The first update after construction or reset() has a time step of 0
+         *
+         * @param in the input to the controller
+         *
+         * @return out the output of the controller
+         */
+        virtual Out update(In input) {
+            const Time now = clock();
+            const Time dt = lastTime ? now - *lastTime : 0_sec;
+            lastTime = now;
+            return update(input, dt);
+        }
+
         /**
          * @brief Update the controller
          *
          * @param in the input to the controller
+         * @param dt the time since the last update. 0 if this is the first update
          *
          * @return out the output of the controller
          */
-        virtual Out update(In input) = 0;
+        virtual Out update(In input, Time dt) = 0;
 
         /**
          * @brief Reset the controller
          *
-         * This is used to reset the controller to some initial state.
+         * This is used to reset the controller to some initial state. Implementations should call
+         * resetClock(), so the next update doesn't measure the time since the previous run
          */
         virtual void reset() = 0;
 
@@ -32,4 +66,13 @@ template <typename In, typename Out> class Controller {
          *
          */
         virtual ~Controller() {}
+    protected:
+        /**
+         * @brief forget the time of the last update, so the next update has a time step of 0
+         *
+         */
+        void resetClock() { lastTime = std::nullopt; }
+    private:
+        Clock clock; /** clock used to measure the time between updates */
+        std::optional<Time> lastTime; /** the time of the last update measured with the clock */
 };
@@ -0,0 +1,113 @@
+#pragma once
+
+#include "controller/lqr.hpp"
+#include <array>
+
+/**
+ * @brief settings of #DisturbanceObserver
+ *
+ */
+struct DisturbanceSettings {
+        Time timeConstant = 15_ms; /** time constant of the filter on the estimate. Shorter reacts faster, but lets
+                                      through more of the noise of the velocities */
+        Time delay = 10_ms; /** time between commanding a voltage and the motors applying it */
+        double compensation = 1; /** fraction of the estimated force the velocity controllers cancel, 0 to only
+                                    detect pushes */
+        double maxCompensation = 6; /** largest compensation of a side, in volts */
+        double pushThreshold = 2; /** estimated force on a side for the robot to be pushed, in volts */
+        Time pushTime = 15_ms; /** how long the force has to exceed the threshold before a push is reported */
+};
+
+/**
+ * @brief per-tick output of the disturbance observer
+ *
+ */
+struct DisturbanceSignal {
+        double leftForce = 0; /** estimated external force on the left wheels, in volts. Positive is forwards */
+        double rightForce = 0; /** estimated external force on the right wheels, in volts. Positive is forwards */
+        bool pushed = false; /** whether something is pushing the robot, or the robot is pushing against something */
+};
+
+/**
+ * @brief Disturbance observer of the drivetrain
+ *
+ * Predicts the wheel velocities of each tick from the velocities and voltages of the last tick with the identified
+ * model of the drivetrain, see driveModel(). Whatever the model doesn't explain is an external force, like a robot
+ * pushing or a wall, so the difference between the prediction and the measurement is turned back into the voltage
+ * which would have caused it. The estimate is low pass filtered, since the difference of velocities is noisy.
+ *
+ * The chassis adds getCompensation() to the output of its velocity controllers, which cancels the force within a few
+ * ticks instead of waiting for the position error to build up, and reports pushes with Chassis::getDisturbance().
+ * The compensation is limited, so the robot doesn't stall its motors pushing against a wall.
+ *
+ * If the model is invalid, for example if a kA is 0, the estimate is always 0.
+ */
+class DisturbanceObserver {
+    public:
+        /**
+         * @brief Construct a new Disturbance Observer object
+         *
+         * @param linear feedforward gains of a side driving straight
+         * @param angular feedforward gains of a side turning in place
+         * @param settings the settings of the observer
+         * @param period the time between updates, which should be the velocity period of #ChassisRates. Defaults to
+         * 10 ms, its default
+         */
+        DisturbanceObserver(FeedforwardGains linear, FeedforwardGains angular, DisturbanceSettings settings = {},
+                            Time period = 10_ms);
+        /**
+         * @brief Construct a new Disturbance Observer object from the results of a characterization
+         *
+         * The linear gains are the average of the left and right sides
+         *
+         * @param result the results of Chassis::characterize() or readSysIdResult()
+         * @param settings the settings of the observer
+         * @param period the time between updates, which should be the velocity period of #ChassisRates. Defaults to
+         * 10 ms, its default
+         */
+        DisturbanceObserver(const SysIdResult& result, DisturbanceSettings settings = {}, Time period = 10_ms);
+        /**
+         * @brief update the observer
+         *
+         * This should be called once per period, which the chassis does when it owns the observer
+         *
+         * @param leftVelocity measured velocity of the left wheels, in meters per second
+         * @param rightVelocity measured velocity of the right wheels, in meters per second
+         * @param leftVoltage voltage commanded to the left drive since the last update, in volts
+         * @param rightVoltage voltage commanded to the right drive since the last update, in volts
+         * @return DisturbanceSignal
+         */
+        DisturbanceSignal update(double leftVelocity, double rightVelocity, double leftVoltage, double rightVoltage);
+        /**
+         * @brief Get the signal calculated on the last update
+         *
+         * @return DisturbanceSignal
+         */
+        DisturbanceSignal getSignal() const;
+        /**
+         * @brief Get the voltage which cancels the estimated force
+         *
+         * @return DriveVoltages the voltage to add to each side, in volts
+         */
+        DriveVoltages getCompensation() const;
+        /**
+         * @brief reset the observer
+         *
+         * This should be called whenever the drive encoders are reset
+         */
+        void reset();
+    private:
+        const FeedforwardGains linear;
+        const DisturbanceSettings settings;
+        const double filterGain; /** weight of the newest estimate in the low pass filter */
+        const int delayTicks; /** updates between commanding a voltage and the motors applying it */
+        const int pushTicks; /** updates the force has to exceed the threshold for */
+        Matrix<2, 2> discreteA;
+        Matrix<2, 2> discreteB;
+        Matrix<2, 2> inverseB; /** turns a velocity change into the voltage causing it. 0 if the model is invalid */
+        std::array<DriveVoltages, 16> voltages = {}; /** voltages commanded on the last updates, oldest overwritten */
+        int updates = 0;
+        std::optional<std::pair<double, double>> prevVelocity;
+        int aboveTicks = 0; /** consecutive updates the force has exceeded the threshold */
+        DisturbanceSignal signal;
+};
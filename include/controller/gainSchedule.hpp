@@ -0,0 +1,277 @@
+#pragma once
+
+#include "controller/pid.hpp"
+#include "controller/vapid.hpp"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <functional>
+#include <memory>
+#include <vector>
+
+/**
+ * @brief variables gains can be scheduled by
+ *
+ * We use a regular enum instead of an enum class for consistency with #TuningRule
+ */
+enum ScheduleVariable { SCHEDULE_SPEED = 0, SCHEDULE_BATTERY = 1, SCHEDULE_HEADING_ERROR = 2 };
+
+/**
+ * @brief the operating point of the robot, which selects the gains of a scheduled controller
+ *
+ */
+struct OperatingPoint {
+        double speed = 0; /** magnitude of the velocity, in meters per second */
+        double battery = 12; /** battery voltage, in volts */
+        double headingError = 0; /** magnitude of the heading error, in the units of the controller */
+};
+
+/**
+ * @brief evenly spaced breakpoints of a variable of a #GainTable
+ *
+ * The breakpoints are evenly spaced, so finding the ones around a value is a division instead of a search. Values
+ * outside of the range use the gains of the nearest end
+ */
+struct Breakpoints {
+        double min = 0; /** the first breakpoint */
+        double max = 0; /** the last breakpoint */
+        size_t count = 1; /** number of breakpoints. 1 to not schedule by the variable */
+};
+
+/**
+ * @brief Get the battery voltage
+ *
+ * The voltage is read at most once per tick of #SensorCache, so every scheduled controller of an update shares it
+ *
+ * @return double the voltage reported by VEXos, in volts
+ */
+double batteryVoltage();
+
+/**
+ * @brief Get the operating point of a velocity controller: the magnitude of its measured velocity, and the battery
+ *
+ * @param input the input of the controller, in meters per second
+ * @return OperatingPoint
+ */
+OperatingPoint velocityOperatingPoint(const VelocityControllerInput& input);
+
+/**
+ * @brief Get the operating point of a heading controller: the magnitude of its error, and the battery
+ *
+ * @param input the input of the controller
+ * @return OperatingPoint
+ */
+OperatingPoint headingOperatingPoint(const PositionControllerInput& input);
+
+/**
+ * @brief table of gain sets over a grid of operating points, interpolated between them
+ *
+ * The grid has a set of gains at every combination of the breakpoints of the speed, the battery voltage and the
+ * heading error. Looking up an operating point interpolates between the 8 sets around it, so it takes the same time
+ * no matter how large the table is.
+ *
+ * @tparam K number of gains in a set
+ */
+template <size_t K> class GainTable {
+    public:
+        using Gains = std::array<double, K>;
+
+        /**
+         * @brief Construct a new Gain Table object
+         *
+         * @param speed breakpoints of the speed
+         * @param battery breakpoints of the battery voltage
+         * @param headingError breakpoints of the heading error
+         * @param gains the gains of every point, until they're set
+         */
+        GainTable(Breakpoints speed, Breakpoints battery, Breakpoints headingError, Gains gains = {})
+            : axes({axis(speed), axis(battery), axis(headingError)}),
+              table(axes[0].count * axes[1].count * axes[2].count, gains) {}
+
+        /**
+         * @brief set the gains of a point of the grid. Indices out of range are ignored
+         *
+         * @param speed index of the speed breakpoint
+         * @param battery index of the battery breakpoint
+         * @param headingError index of the heading error breakpoint
+         * @param gains the gains
+         */
+        void set(size_t speed, size_t battery, size_t headingError, Gains gains) {
+            if (speed >= axes[0].count || battery >= axes[1].count || headingError >= axes[2].count) return;
+            table[index(speed, battery, headingError)] = gains;
+        }
+
+        /**
+         * @brief Get a breakpoint
+         *
+         * @param variable the variable, see #ScheduleVariable
+         * @param index index of the breakpoint
+         * @return double the value of the breakpoint
+         */
+        double getBreakpoint(int variable, size_t index) const {
+            const Axis& axis = axes[variable];
+            return axis.min + index * axis.step;
+        }
+
+        /**
+         * @brief Get the gains at an operating point
+         *
+         * @param point the operating point
+         * @return Gains the gains, interpolated between the points of the grid around it
+         */
+        Gains lookup(OperatingPoint point) const {
+            const std::array<double, 3> values = {point.speed, point.battery, point.headingError};
+            std::array<size_t, 3> lower;
+            std::array<double, 3> fraction;
+            for (size_t i = 0; i < 3; i++) {
+                const Axis& axis = axes[i];
+                if (axis.count == 1) {
+                    lower[i] = 0;
+                    fraction[i] = 0;
+                    continue;
+                }
+                const double position = std::clamp((values[i] - axis.min) / axis.step, 0.0, double(axis.count - 1));
+                lower[i] = std::min(size_t(position), axis.count - 2);
+                fraction[i] = position - lower[i];
+            }
+            Gains gains = {};
+            // weight the corners of the cell around the point
+            for (size_t corner = 0; corner < 8; corner++) {
+                double weight = 1;
+                std::array<size_t, 3> indices;
+                for (size_t i = 0; i < 3; i++) {
+                    const bool upper = corner & (1 << i);
+                    weight *= upper ? fraction[i] : 1 - fraction[i];
+                    indices[i] = lower[i] + (upper ? 1 : 0);
+                }
+                if (weight == 0) continue;
+                const Gains& set = table[index(indices[0], indices[1], indices[2])];
+                for (size_t k = 0; k < K; k++) gains[k] += weight * set[k];
+            }
+            return gains;
+        }
+    private:
+        struct Axis {
+                double min;
+                double step; /** distance between breakpoints */
+                size_t count;
+        };
+
+        static Axis axis(Breakpoints breakpoints) {
+            const size_t count = std::max<size_t>(breakpoints.count, 1);
+            if (count == 1 || breakpoints.max <= breakpoints.min) return {breakpoints.min, 1, 1};
+            return {breakpoints.min, (breakpoints.max - breakpoints.min) / (count - 1), count};
+        }
+
+        size_t index(size_t speed, size_t battery, size_t headingError) const {
+            return (speed * axes[1].count + battery) * axes[2].count + headingError;
+        }
+
+        const std::array<Axis, 3> axes;
+        std::vector<Gains> table;
+};
+
+/**
+ * @brief wrapper which schedules the gains of any controller by the operating point of the robot
+ *
+ * One set of gains is a compromise: gains which are stiff at low speed oscillate at high speed, and gains tuned on a
+ * full battery are soft on a low one. Before every update, the wrapper finds the operating point of the input,
+ * looks up its gains in the table, and applies them to the controller. The wrapper is a controller with the same
+ * input and output, so it can be passed to #Chassis in place of the controller it wraps.
+ *
+ * Lookups take constant time and don't allocate, so the wrapper can run in the chassis loop. See schedulePID() and
+ * scheduleVAPID() for the controllers of this project.
+ *
+ * @tparam In the type of the input
+ * @tparam Out the type of the output
+ * @tparam K number of gains in a set
+ */
+template <typename In, typename Out, size_t K> class GainScheduled : public Controller<In, Out> {
+    public:
+        using Gains = typename GainTable<K>::Gains;
+
+        /**
+         * @brief Construct a new Gain Scheduled object
+         *
+         * @param controller the controller to schedule
+         * @param table the gains at each operating point
+         * @param apply function which sets the gains of the controller
+         * @param operatingPoint function which finds the operating point of an input. It can read other state too,
+         * like the velocity of the robot
+         * @param clock the clock used to measure the time between updates. Defaults to Timer::now
+         */
+        GainScheduled(std::shared_ptr<Controller<In, Out>> controller, GainTable<K> table,
+                      std::function<void(const Gains&)> apply, std::function<OperatingPoint(const In&)> operatingPoint,
+                      Clock clock = Timer::now)
+            : Controller<In, Out>(clock),
+              controller(controller),
+              table(std::move(table)),
+              apply(apply),
+              operatingPoint(operatingPoint) {}
+
+        using Controller<In, Out>::update;
+
+        /**
+         * @brief schedule the gains, then update the controller
+         *
+         * @param input the input of the controller
+         * @param dt the time since the last update
+         * @return Out the output of the controller
+         */
+        Out update(In input, Time dt) override {
+            gains = table.lookup(operatingPoint(input));
+            apply(gains);
+            return controller->update(input, dt);
+        }
+
+        /**
+         * @brief reset the controller
+         *
+         */
+        void reset() override {
+            controller->reset();
+            this->resetClock();
+        }
+
+        /**
+         * @brief Get the gains applied by the last update
+         *
+         * @return Gains
+         */
+        Gains getGains() const { return gains; }
+    private:
+        const std::shared_ptr<Controller<In, Out>> controller;
+        const GainTable<K> table;
+        const std::function<void(const Gains&)> apply;
+        const std::function<OperatingPoint(const In&)> operatingPoint;
+        Gains gains = {};
+};
+
+/**
+ * @brief schedule the gains of a PID controller
+ *
+ * @param pid the controller
+ * @param table gain sets of kP, kI, kD and kS
+ * @param operatingPoint function which finds the operating point of an input. Defaults to headingOperatingPoint()
+ * @return std::shared_ptr<GainScheduled<PositionControllerInput, double, 4>> the scheduled controller
+ */
+template <unsigned Features>
+std::shared_ptr<GainScheduled<PositionControllerInput, double, 4>>
+schedulePID(std::shared_ptr<PID<Features>> pid, GainTable<4> table,
+            std::function<OperatingPoint(const PositionControllerInput&)> operatingPoint = headingOperatingPoint) {
+    return std::make_shared<GainScheduled<PositionControllerInput, double, 4>>(
+        pid, std::move(table), [pid](const std::array<double, 4>& g) { pid->setGains({g[0], g[1], g[2], g[3]}); },
+        operatingPoint);
+}
+
+/**
+ * @brief schedule the gains of a VAPID controller
+ *
+ * @param vapid the controller
+ * @param table gain sets of kV, kA, kP, kI and kD. kS stays the one the controller was constructed with
+ * @param operatingPoint function which finds the operating point of an input. Defaults to velocityOperatingPoint()
+ * @return std::shared_ptr<GainScheduled<VelocityControllerInput, double, 5>> the scheduled controller
+ */
+std::shared_ptr<GainScheduled<VelocityControllerInput, double, 5>>
+scheduleVAPID(std::shared_ptr<VAPID> vapid, GainTable<5> table,
+              std::function<OperatingPoint(const VelocityControllerInput&)> operatingPoint = velocityOperatingPoint);
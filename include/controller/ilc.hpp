@@ -0,0 +1,152 @@
+#pragma once
+
+#include "units/units.hpp"
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief settings of #ILC
+ *
+ */
+struct ILCSettings {
+        Time binWidth = 50_ms; /** time covered by each entry of the correction table */
+        double positionGain = 80; /** volts learned per meter of position error of a side */
+        double velocityGain = 5; /** volts learned per meter per second of velocity error of a side */
+        Time lead = 30_ms; /** the error this long after a time corrects the voltage at that time, since the robot
+                              takes time to respond to a voltage */
+        double forgetting = 0.02; /** fraction of the correction forgotten every run, so noise doesn't accumulate */
+        double maxCorrection = 3; /** largest correction of a side, in volts */
+        Length maxRunError = 6_in; /** runs with a larger position error aren't learned from, for example a collision */
+        std::string prefix = "/usd/ilc_"; /** save() writes the table to prefix + hash + ".txt", empty to not save it */
+};
+
+/**
+ * @brief iterative learning control of a repeated trajectory
+ *
+ * Errors which repeat every time the robot follows the same trajectory, like a bump in the field or a scrubbing
+ * wheel, can't be predicted by the model, so feedback only corrects them after they happen. The learning controller
+ * records the error of each side of the drivetrain over a run, and after the run adds a correction to the voltage of
+ * each side at each time of the trajectory, so the next run applies it before the error happens:
+ *
+ * correction(t) += positionGain * positionError(t + lead) + velocityGain * velocityError(t + lead)
+ *
+ * The table is smoothed and decays a little after every run, so errors which don't repeat average out. save() writes
+ * the table to the SD card, named after Trajectory::hash(), so it carries over between runs of the program and is
+ * discarded when the trajectory changes.
+ *
+ * A motion which supports learning adds correction() to its feedforward, calls record() every update, and learn()
+ * when it reaches the end of the trajectory. A run which is interrupted isn't learned from. Only #MPCMotion supports
+ * it, since the corrections are voltages: #RamseteMotion outputs velocity targets, and has no voltage feedforward to
+ * correct or measured wheel velocities to record. The
+ * motion runs on the chassis task, which can't wait for the SD card, so learn() doesn't save the table. Call save()
+ * from the task which started the motion, once it's done.
+ */
+class ILC {
+    public:
+        /**
+         * @brief Construct a new ILC object, and load the saved table of the trajectory if there is one
+         *
+         * @param hash the hash of the trajectory, from Trajectory::hash()
+         * @param duration the duration of the trajectory
+         * @param settings the settings of the learning controller
+         */
+        ILC(uint32_t hash, Time duration, ILCSettings settings = {});
+        /**
+         * @brief Get the correction of both sides at a time, interpolated between the entries of the table
+         *
+         * @param time time since the start of the trajectory
+         * @return std::pair<double, double> the correction of the left and right sides, in volts
+         */
+        std::pair<double, double> correction(Time time) const;
+        /**
+         * @brief record the error of both sides during a run
+         *
+         * Errors are the reference minus the measurement, so a side which is behind has a positive error
+         *
+         * @param time time since the start of the trajectory
+         * @param leftPosition position error of the left side along the trajectory, in meters
+         * @param rightPosition position error of the right side along the trajectory, in meters
+         * @param leftVelocity velocity error of the left side, in meters per second
+         * @param rightVelocity velocity error of the right side, in meters per second
+         */
+        void record(Time time, double leftPosition, double rightPosition, double leftVelocity, double rightVelocity);
+        /**
+         * @brief update the table with the errors recorded since the last call
+         *
+         * This only changes the table in memory, see save()
+         *
+         * @return true the run was learned from
+         * @return false the run was rejected because nothing was recorded or its error was too large
+         */
+        bool learn();
+        /**
+         * @brief save the table to the path of the settings, if it has learned since it was loaded or last saved
+         *
+         * This blocks until the SD card is written, so it shouldn't be called from the chassis task. It shouldn't be
+         * called while a motion is learning with the table either, so call it after the motion is done
+         *
+         * @return true the table was saved, or there was nothing new to save
+         * @return false the table couldn't be written
+         */
+        bool save();
+        /**
+         * @brief forget the recorded errors without learning from them
+         *
+         */
+        void discard();
+        /**
+         * @brief Get how many runs have been learned from, including the runs of the saved table
+         *
+         * @return int
+         */
+        int getRuns() const;
+        /**
+         * @brief Get the RMS position error of the last run learned from, or rejected
+         *
+         * @return Length
+         */
+        Length getLastError() const;
+        /**
+         * @brief Get the path the table is saved to
+         *
+         * @return std::string the path, or an empty string if the table isn't saved
+         */
+        std::string getPath() const;
+        /**
+         * @brief write the table, with the hash and bin width so a mismatched table isn't loaded
+         *
+         * @param stream the stream to write to
+         */
+        void write(std::ostream& stream) const;
+        /**
+         * @brief read a table written by write()
+         *
+         * @param stream the stream to read from
+         * @return true the table was read
+         * @return false the table is for a different trajectory or bin width, or is incomplete, and was ignored
+         */
+        bool read(std::istream& stream);
+    private:
+        struct Bin {
+                double left = 0; /** correction of the left side, in volts */
+                double right = 0; /** correction of the right side, in volts */
+                // errors recorded during the current run
+                double leftError = 0;
+                double rightError = 0;
+                int samples = 0;
+        };
+
+        const uint32_t hash;
+        const ILCSettings settings;
+        std::vector<Bin> bins;
+        int runs = 0;
+        bool unsaved = false; /** whether the table has learned since it was loaded or last saved */
+        double squaredError = 0; /** sum of the squared position errors of the current run */
+        double maxError = 0; /** largest position error of the current run, in meters */
+        int samples = 0; /** samples of the current run */
+        Length lastError = 0_m;
+};
@@ -0,0 +1,200 @@
+#pragma once
+
+#include "controller/controller.hpp"
+#include "controller/matrix.hpp"
+#include "controller/sysid.hpp"
+#include <optional>
+#include <utility>
+
+/**
+ * @brief input struct for controllers of both sides of the drivetrain
+ *
+ * Velocities are linear velocities of the wheels in meters per second, and accelerations are in meters per second
+ * squared
+ */
+struct DriveVelocityInput {
+        const double leftTargetAcceleration;
+        const double rightTargetAcceleration;
+        const double leftTargetVelocity;
+        const double rightTargetVelocity;
+        const double leftVelocity;
+        const double rightVelocity;
+};
+
+/**
+ * @brief output struct for controllers of both sides of the drivetrain
+ *
+ */
+struct DriveVoltages {
+        double left; /** left drive voltage, in volts */
+        double right; /** right drive voltage, in volts */
+};
+
+/**
+ * @brief continuous linear model of the wheel velocities of a differential drivetrain
+ *
+ * The state is the linear velocity of the left and right wheels, and the input is the voltage of each side. Driving
+ * straight and turning in place have separate gains, since turning accelerates the moment of inertia of the robot
+ * instead of its mass, so a voltage on one side also accelerates the other. Static friction isn't linear, so it's
+ * left out. The angular gains are in wheel velocities, like the ones of Chassis::characterize()
+ *
+ * @param linear feedforward gains of a side driving straight. kA has to be positive
+ * @param angular feedforward gains of a side turning in place. kA has to be positive
+ * @return std::pair<Matrix<2, 2>, Matrix<2, 2>> the system matrix A and the input matrix B of x' = Ax + Bu
+ */
+std::pair<Matrix<2, 2>, Matrix<2, 2>> driveModel(const FeedforwardGains& linear, const FeedforwardGains& angular);
+
+/**
+ * @brief static friction of the sides of a differential drivetrain, which driveModel() leaves out
+ *
+ * The friction is the kS of the linear gains driving straight, the kS of the angular gains turning in place, and a
+ * mix of them in between, by how much of the speed of the wheels is turning
+ *
+ * @param linear feedforward gains of a side driving straight
+ * @param angular feedforward gains of a side turning in place
+ * @param velocity linear velocity of the robot, in meters per second
+ * @param turn velocity of the wheels from turning, in meters per second. Positive turns counterclockwise
+ * @return double the magnitude of the friction of each side, in volts
+ */
+double driveFriction(const FeedforwardGains& linear, const FeedforwardGains& angular, double velocity, double turn);
+
+/**
+ * @brief discretize a continuous linear model with a zero order hold
+ *
+ * The model is x' = Ax + Bu. The discrete model is x[k+1] = Ad x[k] + Bd u[k], with u held constant for a period
+ *
+ * @param a the continuous system matrix
+ * @param b the continuous input matrix
+ * @param period the time between updates
+ * @return std::pair<Matrix<States, States>, Matrix<States, Inputs>> Ad and Bd
+ */
+template <size_t States, size_t Inputs>
+std::pair<Matrix<States, States>, Matrix<States, Inputs>> discretize(const Matrix<States, States>& a,
+                                                                     const Matrix<States, Inputs>& b, Time period) {
+    // the exponential of [[A, B], [0, 0]] * T is [[Ad, Bd], [0, I]]
+    Matrix<States + Inputs, States + Inputs> augmented;
+    for (size_t i = 0; i < States; i++) {
+        for (size_t j = 0; j < States; j++) augmented(i, j) = a(i, j) * to_sec(period);
+        for (size_t j = 0; j < Inputs; j++) augmented(i, States + j) = b(i, j) * to_sec(period);
+    }
+    const Matrix<States + Inputs, States + Inputs> exponential = matrixExp(augmented);
+    std::pair<Matrix<States, States>, Matrix<States, Inputs>> result;
+    for (size_t i = 0; i < States; i++) {
+        for (size_t j = 0; j < States; j++) result.first(i, j) = exponential(i, j);
+        for (size_t j = 0; j < Inputs; j++) result.second(i, j) = exponential(i, States + j);
+    }
+    return result;
+}
+
+/**
+ * @brief calculate the gain of a discrete linear quadratic regulator
+ *
+ * Solves the discrete algebraic Riccati equation by iterating it until it converges, which is slow but simple and
+ * reliable for small systems. Call it once, not every update. The control law is u = -Kx, or u = K(r - x) to track
+ * a reference.
+ *
+ * @param a the discrete system matrix
+ * @param b the discrete input matrix
+ * @param q the cost of the state
+ * @param r the cost of the input
+ * @param maxIterations how many iterations to try before giving up. Defaults to 10000
+ * @return std::optional<Matrix<Inputs, States>> the gain K, or std::nullopt if the equation didn't converge
+ */
+template <size_t States, size_t Inputs>
+std::optional<Matrix<Inputs, States>> lqrGain(const Matrix<States, States>& a, const Matrix<States, Inputs>& b,
+                                              const Matrix<States, States>& q, const Matrix<Inputs, Inputs>& r,
+                                              int maxIterations = 10000) {
+    Matrix<States, States> p = q;
+    for (int i = 0; i < maxIterations; i++) {
+        const Matrix<Inputs, States> bp = b.transpose() * p;
+        const std::optional<Matrix<Inputs, Inputs>> s = inverse(r + bp * b);
+        if (!s) return std::nullopt;
+        const Matrix<Inputs, States> k = *s * bp * a;
+        const Matrix<States, States> next = q + a.transpose() * p * (a - b * k);
+        const double change = (next - p).maxAbs();
+        p = next;
+        if (change <= 1e-10 * std::max(1.0, p.maxAbs())) return k;
+    }
+    return std::nullopt;
+}
+
+/**
+ * @brief cost weights of #DriveLQR, with Bryson's rule
+ *
+ * Each weight is the largest acceptable value of its quantity, and the cost is the square of the quantity divided by
+ * the square of the weight. Lowering the velocity error makes the controller more aggressive, and lowering the
+ * voltage makes it gentler.
+ */
+struct LQRWeights {
+        double maxVelocityError = 0.1; /** acceptable velocity error of a side, in meters per second */
+        double maxVoltage = 12; /** acceptable voltage correction of a side, in volts */
+};
+
+/**
+ * @brief Linear quadratic regulator of the velocities of both sides of the drivetrain
+ *
+ * The model of the drivetrain comes from the characterized feedforward gains, see driveModel(). A voltage on one side
+ * also accelerates the other, and the regulator accounts for this coupling, where two independent #VAPID
+ * controllers fight each other over it.
+ *
+ * The output is the feedforward voltage of the targets, plus the LQR correction K(target - velocity). The gain is
+ * calculated once, when the controller is constructed, for a fixed period, so updates only do a 2x2 matrix product.
+ * The angular gains are in wheel velocities, so the track width isn't needed.
+ *
+ * If the model is invalid, for example if a kA is 0, the gain is 0 and the controller only applies feedforward.
+ */
+class DriveLQR : public Controller<DriveVelocityInput, DriveVoltages> {
+    public:
+        /**
+         * @brief Construct a new Drive LQR object
+         *
+         * @param linear feedforward gains of a side driving straight
+         * @param angular feedforward gains of a side turning in place
+         * @param weights the cost weights. Defaults to 0.1 meters per second and 12 volts
+         * @param period the time between updates the gain is calculated for, which should be the velocity period of
+         * #ChassisRates. Defaults to 10 ms, its default
+         * @param clock the clock used to measure the time between updates. Defaults to Timer::now
+         */
+        DriveLQR(FeedforwardGains linear, FeedforwardGains angular, LQRWeights weights = {}, Time period = 10_ms,
+                 Clock clock = Timer::now);
+        /**
+         * @brief Construct a new Drive LQR object from the results of a characterization
+         *
+         * The linear gains are the average of the left and right sides
+         *
+         * @param result the results of Chassis::characterize() or readSysIdResult()
+         * @param weights the cost weights. Defaults to 0.1 meters per second and 12 volts
+         * @param period the time between updates the gain is calculated for, which should be the velocity period of
+         * #ChassisRates. Defaults to 10 ms, its default
+         * @param clock the clock used to measure the time between updates. Defaults to Timer::now
+         */
+        DriveLQR(const SysIdResult& result, LQRWeights weights = {}, Time period = 10_ms, Clock clock = Timer::now);
+        using Controller::update;
+        /**
+         * @brief update the controller
+         *
+         * The time step is ignored, since the gain is calculated for a fixed period
+         *
+         * @param input the targets and velocities of both sides
+         * @param dt the time since the last update
+         * @return DriveVoltages the voltages of both sides
+         */
+        DriveVoltages update(DriveVelocityInput input, Time dt) override;
+        /**
+         * @brief reset any persistent state in the controller
+         *
+         * The controller has no state besides its clock
+         */
+        void reset() override;
+        /**
+         * @brief Get the gain of the regulator
+         *
+         * @return Matrix<2, 2> volts of the left and right sides per meter per second of error of the left and right
+         * sides
+         */
+        Matrix<2, 2> getGain() const;
+    private:
+        const FeedforwardGains linear;
+        const FeedforwardGains angular;
+        Matrix<2, 2> gain; /** the LQR gain, rows are the voltages and columns the velocity errors */
+};
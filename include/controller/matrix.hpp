@@ -0,0 +1,204 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <optional>
+#include <utility>
+
+/**
+ * @brief fixed size matrix of doubles
+ *
+ * Only meant for the small matrices of state space controllers. The size is part of the type and the elements are
+ * stored inline, so nothing allocates and the compiler can unroll the loops
+ *
+ * @tparam Rows number of rows
+ * @tparam Cols number of columns
+ */
+template <size_t Rows, size_t Cols> struct Matrix {
+        std::array<std::array<double, Cols>, Rows> data {}; /** elements, indexed by row then column */
+
+        double& operator()(size_t row, size_t col) { return data[row][col]; }
+
+        double operator()(size_t row, size_t col) const { return data[row][col]; }
+
+        /**
+         * @brief Get the identity matrix
+         *
+         * @return Matrix
+         */
+        static Matrix identity() {
+            static_assert(Rows == Cols, "only square matrices have an identity");
+            Matrix result;
+            for (size_t i = 0; i < Rows; i++) result(i, i) = 1;
+            return result;
+        }
+
+        /**
+         * @brief Get a diagonal matrix
+         *
+         * @param diagonal the elements of the diagonal
+         * @return Matrix
+         */
+        static Matrix diagonal(const std::array<double, Rows>& diagonal) {
+            static_assert(Rows == Cols, "only square matrices have a diagonal");
+            Matrix result;
+            for (size_t i = 0; i < Rows; i++) result(i, i) = diagonal[i];
+            return result;
+        }
+
+        Matrix<Cols, Rows> transpose() const {
+            Matrix<Cols, Rows> result;
+            for (size_t i = 0; i < Rows; i++)
+                for (size_t j = 0; j < Cols; j++) result(j, i) = data[i][j];
+            return result;
+        }
+
+        Matrix operator+(const Matrix& other) const {
+            Matrix result;
+            for (size_t i = 0; i < Rows; i++)
+                for (size_t j = 0; j < Cols; j++) result(i, j) = data[i][j] + other(i, j);
+            return result;
+        }
+
+        Matrix operator-(const Matrix& other) const {
+            Matrix result;
+            for (size_t i = 0; i < Rows; i++)
+                for (size_t j = 0; j < Cols; j++) result(i, j) = data[i][j] - other(i, j);
+            return result;
+        }
+
+        Matrix operator*(double scalar) const {
+            Matrix result;
+            for (size_t i = 0; i < Rows; i++)
+                for (size_t j = 0; j < Cols; j++) result(i, j) = data[i][j] * scalar;
+            return result;
+        }
+
+        template <size_t Other> Matrix<Rows, Other> operator*(const Matrix<Cols, Other>& other) const {
+            Matrix<Rows, Other> result;
+            for (size_t i = 0; i < Rows; i++)
+                for (size_t k = 0; k < Cols; k++)
+                    for (size_t j = 0; j < Other; j++) result(i, j) += data[i][k] * other(k, j);
+            return result;
+        }
+
+        /**
+         * @brief Get the largest magnitude of any element
+         *
+         * @return double
+         */
+        double maxAbs() const {
+            double result = 0;
+            for (const auto& row : data)
+                for (double element : row) result = std::max(result, std::abs(element));
+            return result;
+        }
+};
+
+/**
+ * @brief invert a square matrix with Gauss-Jordan elimination
+ *
+ * @param matrix the matrix
+ * @return std::optional<Matrix<N, N>> the inverse, or std::nullopt if the matrix is singular
+ */
+template <size_t N> std::optional<Matrix<N, N>> inverse(Matrix<N, N> matrix) {
+    Matrix<N, N> result = Matrix<N, N>::identity();
+    for (size_t col = 0; col < N; col++) {
+        // pivot on the largest element, so small pivots don't amplify rounding errors
+        size_t pivot = col;
+        for (size_t row = col + 1; row < N; row++)
+            if (std::abs(matrix(row, col)) > std::abs(matrix(pivot, col))) pivot = row;
+        if (std::abs(matrix(pivot, col)) < 1e-12) return std::nullopt;
+        std::swap(matrix.data[col], matrix.data[pivot]);
+        std::swap(result.data[col], result.data[pivot]);
+        const double scale = 1 / matrix(col, col);
+        for (size_t j = 0; j < N; j++) {
+            matrix(col, j) *= scale;
+            result(col, j) *= scale;
+        }
+        for (size_t row = 0; row < N; row++) {
+            if (row == col) continue;
+            const double factor = matrix(row, col);
+            for (size_t j = 0; j < N; j++) {
+                matrix(row, j) -= factor * matrix(col, j);
+                result(row, j) -= factor * result(col, j);
+            }
+        }
+    }
+    return result;
+}
+
+/**
+ * @brief calculate the matrix exponential with scaling and squaring
+ *
+ * The matrix is scaled down until its elements are small, exponentiated with a Taylor series, and squared back up
+ *
+ * @param matrix the matrix
+ * @return Matrix<N, N> e to the power of the matrix
+ */
+template <size_t N> Matrix<N, N> matrixExp(const Matrix<N, N>& matrix) {
+    int squarings = 0;
+    double norm = matrix.maxAbs() * N;
+    while (norm > 0.5) {
+        norm /= 2;
+        squarings++;
+    }
+    const Matrix<N, N> scaled = matrix * std::pow(0.5, squarings);
+    Matrix<N, N> result = Matrix<N, N>::identity();
+    Matrix<N, N> term = Matrix<N, N>::identity();
+    for (int k = 1; k <= 12; k++) {
+        term = term * scaled * (1.0 / k);
+        result = result + term;
+    }
+    for (int i = 0; i < squarings; i++) result = result * result;
+    return result;
+}
+
+/**
+ * @brief factor a symmetric positive definite matrix into L * L^T with the Cholesky decomposition
+ *
+ * @param matrix the matrix
+ * @return std::optional<Matrix<N, N>> the lower triangular factor L, or std::nullopt if the matrix isn't positive
+ * definite
+ */
+template <size_t N> std::optional<Matrix<N, N>> cholesky(const Matrix<N, N>& matrix) {
+    Matrix<N, N> l;
+    for (size_t j = 0; j < N; j++) {
+        double diagonal = matrix(j, j);
+        for (size_t k = 0; k < j; k++) diagonal -= l(j, k) * l(j, k);
+        if (diagonal <= 0) return std::nullopt;
+        l(j, j) = std::sqrt(diagonal);
+        for (size_t i = j + 1; i < N; i++) {
+            double sum = matrix(i, j);
+            for (size_t k = 0; k < j; k++) sum -= l(i, k) * l(j, k);
+            l(i, j) = sum / l(j, j);
+        }
+    }
+    return l;
+}
+
+/**
+ * @brief solve L * L^T * x = b, with the factor calculated by cholesky()
+ *
+ * @param l the lower triangular factor
+ * @param b the right hand side
+ * @return Matrix<N, 1> x
+ */
+template <size_t N> Matrix<N, 1> choleskySolve(const Matrix<N, N>& l, const Matrix<N, 1>& b) {
+    // forward substitution with L, then back substitution with L^T
+    Matrix<N, 1> y;
+    for (size_t i = 0; i < N; i++) {
+        double sum = b(i, 0);
+        for (size_t k = 0; k < i; k++) sum -= l(i, k) * y(k, 0);
+        y(i, 0) = sum / l(i, i);
+    }
+    Matrix<N, 1> x;
+    for (size_t i = N; i-- > 0;) {
+        double sum = y(i, 0);
+        for (size_t k = i + 1; k < N; k++) sum -= l(k, i) * x(k, 0);
+        x(i, 0) = sum / l(i, i);
+    }
+    return x;
+}
@@ -0,0 +1,194 @@
+#pragma once
+
+#include "controller/controller.hpp"
+#include <algorithm>
+#include <cmath>
+#include <optional>
+
+/**
+ * @brief input struct for position controllers
+ *
+ * Angular controllers should use unbounded angles, like the rotation of the IMU, so the error doesn't jump when the
+ * angle wraps
+ */
+struct PositionControllerInput {
+        const double target;
+        const double measurement;
+};
+
+/**
+ * @brief optional features of the PID controller
+ *
+ * Features are combined with bitwise or, and selected at compile time. A disabled feature is compiled out of
+ * update(), so it costs nothing in the control loop. We use a regular enum instead of an enum class so features can
+ * be combined without casts.
+ */
+enum PIDFeature : unsigned {
+    PID_NONE = 0,
+    PID_ANTI_WINDUP = 1 << 0, /** stop integrating while the output is clamped and the error would wind it further */
+    PID_DERIVATIVE_ON_MEASUREMENT = 1 << 1, /** differentiate the measurement instead of the error, so a change of
+                                               the target doesn't kick the output */
+    PID_DERIVATIVE_FILTER = 1 << 2, /** low-pass filter the derivative, which amplifies sensor noise */
+    PID_OUTPUT_CLAMP = 1 << 3, /** limit the magnitude of the output */
+    PID_SLEW = 1 << 4, /** limit how fast the output changes */
+    PID_INTEGRAL_ZONE = 1 << 5, /** only integrate close to the target, and clear the integral outside */
+    PID_STATIC_FEEDFORWARD = 1 << 6, /** add kS in the direction of the error, to overcome static friction */
+    PID_ALL = (1 << 7) - 1
+};
+
+/**
+ * @brief gains of the PID controller
+ *
+ * The integral and derivative are calculated in seconds
+ */
+struct PIDGains {
+        double kP = 0; /** proportional gain */
+        double kI = 0; /** integral gain */
+        double kD = 0; /** derivative gain */
+        double kS = 0; /** static friction feedforward, used with PID_STATIC_FEEDFORWARD */
+};
+
+/**
+ * @brief settings of the optional features of the PID controller
+ *
+ * Settings of features that aren't enabled are ignored
+ */
+struct PIDSettings {
+        double maxOutput = 12; /** maximum magnitude of the output, used with PID_OUTPUT_CLAMP and PID_ANTI_WINDUP */
+        double maxSlew = 120; /** maximum change of the output per second, used with PID_SLEW */
+        double integralZone = INFINITY; /** the integral is only accumulated while the magnitude of the error is
+                                           less than this, used with PID_INTEGRAL_ZONE */
+        Time derivativeFilter = 20_ms; /** time constant of the derivative filter, used with PID_DERIVATIVE_FILTER */
+        double staticDeadband = 0; /** kS is only added while the magnitude of the error is more than this, so the
+                                      output doesn't chatter at the target. Used with PID_STATIC_FEEDFORWARD */
+};
+
+/**
+ * @brief Positional PID controller
+ *
+ * The output is kP * error + integral + kD * derivative, plus the features selected by the template parameter. The
+ * integral accumulates kI * error * dt, so changing kI, for example with #GainScheduled, only changes how fast it
+ * grows from then on instead of making the output jump. Features are applied in this order:
+ * 1. the integral zone decides whether the error is integrated
+ * 2. the derivative is taken of the error or the measurement, and filtered
+ * 3. kS is added in the direction of the error
+ * 4. the output is clamped. With anti windup, the integral step is undone if the output is clamped and the error
+ *    has the same sign as the output. A clear by the integral zone isn't undone
+ * 5. the change of the output is limited
+ *
+ * @tparam Features the enabled features, see #PIDFeature. Defaults to all of them
+ */
+template <unsigned Features = PID_ALL> class PID : public Controller<PositionControllerInput, double> {
+    public:
+        /**
+         * @brief Construct a new PID object
+         *
+         * @param gains the gains of the controller
+         * @param settings the settings of the enabled features
+         * @param clock the clock used to measure the time between updates. Defaults to Timer::now
+         */
+        PID(PIDGains gains, PIDSettings settings = {}, Clock clock = Timer::now)
+            : Controller(clock),
+              gains(gains),
+              settings(settings) {}
+
+        using Controller::update;
+
+        /**
+         * @brief update the controller
+         *
+         * @param input the target and the measurement
+         * @param dt the time since the last update
+         * @return double the output of the controller
+         */
+        double update(PositionControllerInput input, Time dt) override {
+            const double error = input.target - input.measurement;
+            const double seconds = to_sec(dt);
+            // integrate the error with the trapezoidal rule, scaled by the gain it's integrated with
+            double step = 0;
+            if (lastError) step = gains.kI * seconds * (*lastError + error) / 2;
+            integral += step;
+            if constexpr (Features & PID_INTEGRAL_ZONE) {
+                // nothing is integrated outside the zone, so anti windup has no step to undo
+                if (std::abs(error) >= settings.integralZone) {
+                    integral = 0;
+                    step = 0;
+                }
+            }
+            // differentiate the error, or the measurement, which has the opposite sign
+            double derivative = 0;
+            if constexpr (Features & PID_DERIVATIVE_ON_MEASUREMENT) {
+                if (lastMeasurement && seconds > 0) derivative = -(input.measurement - *lastMeasurement) / seconds;
+            } else {
+                if (lastError && seconds > 0) derivative = (error - *lastError) / seconds;
+            }
+            if constexpr (Features & PID_DERIVATIVE_FILTER) {
+                // first order low-pass filter, which is exact for any time step. The filter holds its output if no
+                // time passed, which also keeps alpha from being 0 / 0 when there's no filter
+                if (seconds > 0) {
+                    const double alpha = 1 - std::exp(-seconds / to_sec(settings.derivativeFilter));
+                    filteredDerivative += alpha * (derivative - filteredDerivative);
+                }
+                derivative = filteredDerivative;
+            }
+            lastError = error;
+            lastMeasurement = input.measurement;
+            double output = gains.kP * error + integral + gains.kD * derivative;
+            if constexpr (Features & PID_STATIC_FEEDFORWARD) {
+                if (std::abs(error) > settings.staticDeadband) output += std::copysign(gains.kS, error);
+            }
+            if constexpr (Features & (PID_OUTPUT_CLAMP | PID_ANTI_WINDUP)) {
+                const double clamped = std::clamp(output, -settings.maxOutput, settings.maxOutput);
+                // conditional integration: integrating more would only push the output further into saturation
+                if constexpr (Features & PID_ANTI_WINDUP) {
+                    if (clamped != output && (error > 0) == (output > 0)) {
+                        output -= step;
+                        integral -= step;
+                    }
+                }
+                if constexpr (Features & PID_OUTPUT_CLAMP) output = clamped;
+            }
+            if constexpr (Features & PID_SLEW) {
+                const double maxChange = settings.maxSlew * seconds;
+                output = std::clamp(output, lastOutput - maxChange, lastOutput + maxChange);
+            }
+            lastOutput = output;
+            return output;
+        }
+
+        /**
+         * @brief reset any persistent state in the controller
+         *
+         * The output is slewed from 0 after a reset
+         */
+        void reset() override {
+            integral = 0;
+            filteredDerivative = 0;
+            lastOutput = 0;
+            lastError = std::nullopt;
+            lastMeasurement = std::nullopt;
+            resetClock();
+        }
+
+        /**
+         * @brief Set the gains of the controller
+         *
+         * @param gains the new gains
+         */
+        void setGains(PIDGains gains) { this->gains = gains; }
+
+        /**
+         * @brief Get the gains of the controller
+         *
+         * @return PIDGains
+         */
+        PIDGains getGains() const { return gains; }
+    private:
+        PIDGains gains;
+        const PIDSettings settings;
+        double integral = 0; /** integral of kI * error, in units of the output */
+        double filteredDerivative = 0; /** output of the derivative filter */
+        double lastOutput = 0; /** the last output, for slew limiting */
+        std::optional<double> lastError; /** the last error, unset before the first update */
+        std::optional<double> lastMeasurement; /** the last measurement, unset before the first update */
+};
@@ -0,0 +1,149 @@
+#pragma once
+
+#include "controller/matrix.hpp"
+#include <algorithm>
+#include <cmath>
+
+/**
+ * @brief settings of #QPSolver
+ *
+ */
+struct QPSettings {
+        int maxIterations = 50; /** the solver stops after this many iterations, even if it hasn't converged */
+        double tolerance = 1e-3; /** the solver stops when the residuals are smaller than this */
+        double rho = 0.1; /** step size of the constraints. Larger values enforce the constraints faster, and
+                             smaller values minimize the cost faster */
+        double sigma = 1e-6; /** regularization, so the problem is strictly convex */
+        double alpha = 1.6; /** over-relaxation, from 0 to 2 */
+};
+
+/**
+ * @brief statistics of a solve
+ *
+ */
+struct QPResult {
+        int iterations = 0;
+        double primalResidual = 0; /** how far the solution violates the constraints */
+        double dualResidual = 0; /** how far the solution is from optimal */
+        bool converged = false; /** whether both residuals are within the tolerance */
+};
+
+/**
+ * @brief solver of small quadratic programs with the alternating direction method of multipliers
+ *
+ * Minimizes 1/2 x^T P x + q^T x subject to lower <= A x <= upper, with the same iteration as OSQP. Every solve
+ * factors P + sigma I + rho A^T A once, and then each iteration is a pair of triangular solves and a projection onto
+ * the bounds. The solution and the multipliers of the previous solve are the starting point of the next one, so a
+ * problem which changes a little between solves, like a receding horizon solved every update, starts close to its
+ * solution.
+ *
+ * All the memory is in the solver, so solving never allocates. Rows of A should have similar scales, since they
+ * share a step size.
+ *
+ * @tparam N number of variables
+ * @tparam M number of constraints
+ */
+template <size_t N, size_t M> class QPSolver {
+    public:
+        /**
+         * @brief Construct a new QP Solver object
+         *
+         * @param settings the settings of the solver
+         */
+        QPSolver(QPSettings settings = {})
+            : settings(settings) {}
+
+        /**
+         * @brief solve a problem, starting from the solution and multipliers of the last solve
+         *
+         * @param p the cost matrix. Has to be symmetric positive semidefinite
+         * @param q the linear cost
+         * @param a the constraint matrix
+         * @param lower the lower bounds of the constraints
+         * @param upper the upper bounds of the constraints
+         * @return QPResult statistics of the solve. The solution is in #solution
+         */
+        QPResult solve(const Matrix<N, N>& p, const Matrix<N, 1>& q, const Matrix<M, N>& a,
+                       const Matrix<M, 1>& lower, const Matrix<M, 1>& upper) {
+            // factor the matrix of the linear system every iteration solves
+            for (size_t i = 0; i < N; i++) {
+                for (size_t j = 0; j <= i; j++) {
+                    double sum = p(i, j);
+                    for (size_t k = 0; k < M; k++) sum += settings.rho * a(k, i) * a(k, j);
+                    kkt(i, j) = sum;
+                    kkt(j, i) = sum;
+                }
+                kkt(i, i) += settings.sigma;
+            }
+            const std::optional<Matrix<N, N>> l = cholesky(kkt);
+            if (!l) return {};
+            factor = *l;
+            // start from the last solution, moved inside the bounds
+            for (size_t k = 0; k < M; k++) {
+                double sum = 0;
+                for (size_t j = 0; j < N; j++) sum += a(k, j) * solution(j, 0);
+                constrained(k, 0) = std::clamp(sum, lower(k, 0), upper(k, 0));
+            }
+            QPResult result;
+            for (result.iterations = 1; result.iterations <= settings.maxIterations; result.iterations++) {
+                // minimize the augmented Lagrangian over x
+                for (size_t i = 0; i < N; i++) {
+                    double sum = settings.sigma * solution(i, 0) - q(i, 0);
+                    for (size_t k = 0; k < M; k++)
+                        sum += a(k, i) * (settings.rho * constrained(k, 0) - multipliers(k, 0));
+                    rhs(i, 0) = sum;
+                }
+                const Matrix<N, 1> next = choleskySolve(factor, rhs);
+                // relax, then project onto the bounds and update the multipliers
+                for (size_t i = 0; i < N; i++)
+                    solution(i, 0) = settings.alpha * next(i, 0) + (1 - settings.alpha) * solution(i, 0);
+                result.primalResidual = 0;
+                for (size_t k = 0; k < M; k++) {
+                    double sum = 0;
+                    for (size_t j = 0; j < N; j++) sum += a(k, j) * next(j, 0);
+                    const double relaxed = settings.alpha * sum + (1 - settings.alpha) * constrained(k, 0);
+                    const double projected =
+                        std::clamp(relaxed + multipliers(k, 0) / settings.rho, lower(k, 0), upper(k, 0));
+                    multipliers(k, 0) += settings.rho * (relaxed - projected);
+                    constrained(k, 0) = projected;
+                }
+                // residuals of the optimality conditions: Ax = z, and Px + q + A^T y = 0
+                for (size_t k = 0; k < M; k++) {
+                    double sum = 0;
+                    for (size_t j = 0; j < N; j++) sum += a(k, j) * solution(j, 0);
+                    result.primalResidual = std::max(result.primalResidual, std::abs(sum - constrained(k, 0)));
+                }
+                result.dualResidual = 0;
+                for (size_t i = 0; i < N; i++) {
+                    double sum = q(i, 0);
+                    for (size_t j = 0; j < N; j++) sum += p(i, j) * solution(j, 0);
+                    for (size_t k = 0; k < M; k++) sum += a(k, i) * multipliers(k, 0);
+                    result.dualResidual = std::max(result.dualResidual, std::abs(sum));
+                }
+                if (result.primalResidual < settings.tolerance && result.dualResidual < settings.tolerance) {
+                    result.converged = true;
+                    break;
+                }
+            }
+            result.iterations = std::min(result.iterations, settings.maxIterations);
+            return result;
+        }
+
+        /**
+         * @brief forget the last solution, so the next solve starts from 0
+         *
+         */
+        void reset() {
+            solution = {};
+            multipliers = {};
+        }
+
+        Matrix<N, 1> solution; /** solution of the last solve, and the starting point of the next */
+        Matrix<M, 1> multipliers; /** Lagrange multipliers of the constraints of the last solve */
+    private:
+        const QPSettings settings;
+        Matrix<N, N> kkt; /** P + sigma I + rho A^T A */
+        Matrix<N, N> factor; /** Cholesky factor of kkt */
+        Matrix<M, 1> constrained; /** A x, projected onto the bounds */
+        Matrix<N, 1> rhs;
+};
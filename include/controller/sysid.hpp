@@ -0,0 +1,131 @@
+#pragma once
+
+#include "units/Angle.hpp"
+#include <istream>
+#include <optional>
+#include <ostream>
+#include <vector>
+
+/**
+ * @brief characterization tests of the drivetrain
+ *
+ * We use a regular enum instead of an enum class for consistency with #EncoderStatus
+ */
+enum SysIdTest {
+    SYSID_QUASISTATIC_LINEAR = 0, /** slow voltage ramp driving straight, so acceleration is negligible */
+    SYSID_DYNAMIC_LINEAR = 1, /** voltage step driving straight, so acceleration dominates */
+    SYSID_QUASISTATIC_ANGULAR = 2, /** slow voltage ramp turning in place */
+    SYSID_DYNAMIC_ANGULAR = 3 /** voltage step turning in place */
+};
+
+/**
+ * @brief a sample recorded during a characterization test
+ *
+ * Voltages are the voltages applied since the previous sample, so they are what caused the measured velocity
+ */
+struct SysIdSample {
+        int test; /** the test the sample was recorded in, see #SysIdTest */
+        int run; /** index of the run the sample was recorded in. Each direction of a test is a separate run, and the
+                    robot rests between runs, so differences are never taken across runs */
+        Time time;
+        Voltage leftVoltage;
+        Voltage rightVoltage;
+        LinearVelocity leftVelocity;
+        LinearVelocity rightVelocity;
+        Angle heading; /** heading of the robot, used to measure the effective track width */
+        LinearAcceleration leftAcceleration = 0_mps2; /** calculated from the velocities, see computeAccelerations() */
+        LinearAcceleration rightAcceleration = 0_mps2; /** calculated from the velocities, see computeAccelerations() */
+};
+
+/**
+ * @brief feedforward gains of a side of the drivetrain
+ *
+ * The voltage needed to reach a velocity and acceleration is kS * sign(velocity) + kV * velocity + kA * acceleration,
+ * with velocities in meters per second and voltages in volts
+ */
+struct FeedforwardGains {
+        double kS = 0; /** voltage to overcome static friction */
+        double kV = 0; /** volts per meter per second */
+        double kA = 0; /** volts per meter per second squared */
+        double rSquared = 0; /** fraction of the variance of the voltage explained by the fit, from 0 to 1 */
+};
+
+/**
+ * @brief results of characterizing the drivetrain
+ *
+ */
+struct SysIdResult {
+        FeedforwardGains left; /** left side, driving straight */
+        FeedforwardGains right; /** right side, driving straight */
+        FeedforwardGains angular; /** both sides turning in place, in wheel velocities. kA includes the robot's
+                                     moment of inertia, so it differs from the linear kA */
+        Length trackWidth = 0_m; /** effective track width, which is wider than the measured one due to scrub */
+};
+
+/**
+ * @brief calculate the acceleration of every sample by differentiating the velocities
+ *
+ * Accelerations are central differences over a few samples of the same run, which filters the noise of the
+ * velocity measurement without delaying it. Samples at either end of a run are differenced over fewer samples
+ *
+ * @param samples the samples, in the order they were recorded
+ * @param window how many samples before and after each sample the difference is taken over. Defaults to 2
+ */
+void computeAccelerations(std::vector<SysIdSample>& samples, int window = 2);
+/**
+ * @brief fit the feedforward gains of a side with least squares
+ *
+ * Samples with a velocity below the threshold are skipped, since static friction makes their voltage unpredictable
+ *
+ * @param samples the samples, with accelerations calculated
+ * @param left whether to fit the left side or the right side
+ * @param angular whether to fit the angular tests or the linear tests
+ * @param minVelocity samples slower than this are skipped. Defaults to 0.02 meters per second
+ * @return std::optional<FeedforwardGains> the gains, or std::nullopt if there aren't enough samples
+ */
+std::optional<FeedforwardGains> fitFeedforward(const std::vector<SysIdSample>& samples, bool left, bool angular,
+                                               LinearVelocity minVelocity = 0.02_mps);
+/**
+ * @brief fit every gain and the track width
+ *
+ * Accelerations have to be calculated first, see computeAccelerations(). Gains that couldn't be fit are 0
+ *
+ * @param samples the samples of every test
+ * @param minVelocity samples slower than this are skipped. Defaults to 0.02 meters per second
+ * @return SysIdResult
+ */
+SysIdResult fitSysId(const std::vector<SysIdSample>& samples, LinearVelocity minVelocity = 0.02_mps);
+/**
+ * @brief write samples as CSV, with a header
+ *
+ * Values are in seconds, volts, meters per second, radians and meters per second squared. The run is the second
+ * column
+ *
+ * @param stream the stream to write to
+ * @param samples the samples
+ */
+void writeSysIdSamples(std::ostream& stream, const std::vector<SysIdSample>& samples);
+/**
+ * @brief read samples written by writeSysIdSamples()
+ *
+ * Files written before the run was recorded have no run column. Their runs are numbered from where the test changes
+ * or the samples pause, since the robot rests between runs
+ *
+ * @param stream the stream to read from
+ * @return std::vector<SysIdSample> the samples. Lines that can't be parsed are skipped
+ */
+std::vector<SysIdSample> readSysIdSamples(std::istream& stream);
+/**
+ * @brief write a result, one gain per line as "name value"
+ *
+ * @param stream the stream to write to
+ * @param result the result
+ */
+void writeSysIdResult(std::ostream& stream, const SysIdResult& result);
+/**
+ * @brief read a result written by writeSysIdResult()
+ *
+ * @param stream the stream to read from
+ * @return std::optional<SysIdResult> the result, or std::nullopt if any gain is missing
+ */
+std::optional<SysIdResult> readSysIdResult(std::istream& stream);
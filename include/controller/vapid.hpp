@@ -1,7 +1,7 @@
 #pragma once
 
 #include "controller/controller.hpp"
-#include "timer.hpp"
+#include "controller/sysid.hpp"
 #include <optional>
 
 /**
@@ -29,15 +29,35 @@ class VAPID : public Controller<VelocityControllerInput, double> {
          * @param kP proportional feedback gain
          * @param kI integral feedback gain
          * @param kD derivative feedback gain
+         * @param clock the clock used to measure the time between updates. Defaults to Timer::now
          */
-        VAPID(double kV, double kA, double kP, double kI, double kD);
+        VAPID(double kV, double kA, double kP, double kI, double kD, Clock clock = Timer::now);
+        /**
+         * @brief Construct a new VAPID object with characterized feedforward gains
+         *
+         * Velocities are in meters per second and the output is in volts, the units #Chassis uses, so the gains of
+         * a side from Chassis::characterize() or readSysIdResult() can be used directly
+         *
+         * @param feedforward the feedforward gains
+         * @param kP proportional feedback gain
+         * @param kI integral feedback gain
+         * @param kD derivative feedback gain
+         * @param clock the clock used to measure the time between updates. Defaults to Timer::now
+         */
+        VAPID(FeedforwardGains feedforward, double kP, double kI, double kD, Clock clock = Timer::now);
+        using Controller::update;
         /**
          * @brief update the controller
          *
+         * The integral and derivative are calculated in seconds. The integral accumulates kI * error * dt, so
+         * changing kI doesn't make the output jump. The error isn't integrated while the output is beyond the 12
+         * volts the motors can apply in the direction of the error, so the integral doesn't wind up
+         *
          * @param input the input to the controller
+         * @param dt the time since the last update
          * @return double the output of the controller
          */
-        double update(VelocityControllerInput input) override;
+        double update(VelocityControllerInput input, Time dt) override;
         /**
          * @brief reset any persistent state in the controller
          *
@@ -54,10 +74,9 @@ class VAPID : public Controller<VelocityControllerInput, double> {
          */
         void setGains(double kV, double kA, double kP, double kI, double kD);
     private:
-        std::optional<Timer> timer; /** timer for calculating derivative and integral */
-        std::optional<uint32_t> lastTime; /** last time the controller was updated */
-        double integral = 0; /** integral value of the controller */
-        std::optional<double> lastError = 0; /** last error of the controller */
+        double integral = 0; /** integral of kI * error, in volts */
+        std::optional<double> lastError; /** last error of the controller */
+        double kS = 0; /** static friction feedforward gain, applied in the direction of the target velocity */
         double kV; /** velocity feedforward gain */
         double kA; /** acceleration feedforward gain */
         double kP; /** proportional feedback gain */
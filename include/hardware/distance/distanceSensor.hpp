@@ -0,0 +1,45 @@
+#pragma once
+
+#include "hardware/sensorCache.hpp"
+#include "units/units.hpp"
+#include <optional>
+
+/**
+ * @brief V5 distance sensor abstraction
+ *
+ * Readings are cached per tick, see #SensorCache
+ */
+class DistanceSensor {
+    public:
+        /**
+         * @brief Construct a new Distance Sensor object
+         *
+         * @param port the port of the distance sensor
+         */
+        DistanceSensor(int port);
+        /**
+         * @brief Get the distance to the object in front of the sensor
+         *
+         * @return std::optional<Length> the distance, or std::nullopt if no object was detected or the sensor
+         * could not be read
+         */
+        std::optional<Length> getDistance();
+        /**
+         * @brief Get the confidence of the distance reading
+         *
+         * The confidence is only meaningful for objects more than 200mm away. It is 63 for closer objects
+         *
+         * @return int from 0 to 63, or 0 if the sensor could not be read
+         */
+        int getConfidence();
+        /**
+         * @brief Get the port of the sensor
+         *
+         * @return int
+         */
+        int getPort() const;
+    private:
+        const int port;
+        CachedReading<int32_t> distanceReading; /** cached distance reading, in millimeters */
+        CachedReading<int32_t> confidenceReading; /** cached confidence reading */
+};
@@ -0,0 +1,130 @@
+#pragma once
+
+#include "hardware/encoder/encoder.hpp"
+#include "hardware/encoder/velocityEstimator.hpp"
+#include "hardware/sensorCache.hpp"
+
+/**
+ * @brief Legacy ADI optical shaft encoder, inherits from Encoder
+ *
+ * The encoder counts 360 ticks per rotation. It has no velocity measurement of its own, so velocity is estimated
+ * from the positions read, see #VelocityEstimator. The encoder is read once per tick no matter how many values are
+ * requested, see #SensorCache.
+ *
+ * The ADI can't tell whether an encoder is plugged in, so a disconnected encoder reads as a stationary one.
+ */
+class ADIEncoder : public Encoder {
+    public:
+        /**
+         * @brief Construct a new ADI Encoder object
+         *
+         * @param topPort the port the top wire is plugged into, from 'A' to 'H'. Must be A, C, E or G
+         * @param bottomPort the port the bottom wire is plugged into, the port after the top port
+         * @param reversed whether the encoder is reversed. Defaults to false
+         * @param gearRatio the gear ratio (teeth of driven gear / teeth of driving gear). Defaults to 1.0
+         */
+        ADIEncoder(char topPort, char bottomPort, bool reversed = false, float gearRatio = 1.0);
+        /**
+         * @brief calibrate the encoder
+         *
+         * This will zero the encoder
+         */
+        void calibrate() override;
+        /**
+         * @brief Get the status of the encoder
+         *
+         * @return int ENCODER_CALIBRATED if the encoder was configured, ENCODER_UNKNOWN_ERROR if the ports are
+         * invalid
+         */
+        int getStatus() override;
+        /**
+         * @brief tare the encoder
+         *
+         * This will zero the encoder
+         */
+        void tare() override;
+        /**
+         * @brief Get the unbounded angle measured by the encoder
+         *
+         * @return Angle the angle measured by the encoder
+         */
+        Angle getPosition() override;
+        /**
+         * @brief Set the unbounded angle of the encoder
+         *
+         * @param angle the angle to set the encoder to
+         */
+        void setPosition(Angle angle) override;
+        /**
+         * @brief Get the bounded angle measured by the encoder
+         *
+         * @return Angle the angle measured by the encoder, between 0 and 1 rotation
+         */
+        Angle getAngle() override;
+        /**
+         * @brief Get the angular velocity measured by the encoder
+         *
+         * This is the slope of the positions read in the last few ticks, so the encoder has to be read every tick
+         * for the estimate to be current. Odometry does this by reading the position every update
+         *
+         * @return AngularVelocity the velocity measured by the encoder
+         */
+        AngularVelocity getVelocity() override;
+        /**
+         * @brief Get the unbounded position of the encoder in ticks
+         *
+         * @return int64_t the position in ticks of the encoder
+         */
+        int64_t getTicks() override;
+        /**
+         * @brief Get the angle of a single tick, including the gear ratio
+         *
+         * @return Angle 1 degree times the gear ratio
+         */
+        Angle getTickAngle() override;
+        /**
+         * @brief get whether the encoder is reversed or not
+         *
+         * @return true the encoder is reversed
+         * @return false the encoder is not reversed
+         */
+        bool getReversed() override;
+        /**
+         * @brief set whether the encoder should be reversed or not
+         *
+         * This inverts the position measured so far as well as subsequent changes
+         *
+         * @param reversed whether the encoder should be reversed or not
+         */
+        void setReversed(bool reversed) override;
+        /**
+         * @brief Get the gear ratio of the encoder
+         *
+         * @return float teeth of driven gear / teeth of driving gear
+         */
+        float getGearRatio() override;
+        /**
+         * @brief Set the gear ratio of the encoder
+         *
+         * This rescales the position measured so far as well as subsequent changes
+         *
+         * @param gearRatio teeth of driven gear / teeth of driving gear
+         */
+        void setGearRatio(float gearRatio) override;
+    private:
+        /**
+         * @brief read the count of the encoder, and add it to the velocity estimate
+         *
+         * @return int64_t the position in ticks, with the encoder's direction. The last position if the encoder
+         * can't be read
+         */
+        int64_t readTicks();
+        const int32_t encoder; /** handle of the encoder returned by PROS, PROS_ERR if the ports are invalid */
+        float gearRatio; /** gear ratio. teeth of driven gear / teeth of driving gear */
+        Angle tickAngle; /** angle of a single tick, including the gear ratio */
+        bool reversed; /** whether the encoder is reversed */
+        int64_t lastTicks = 0; /** the last position read from the encoder, in ticks with the encoder's direction */
+        int64_t offset = 0; /** added to the encoder's count to get the encoder's position, in ticks */
+        CachedReading<int64_t> positionReading; /** cached position reading, in ticks */
+        VelocityEstimator<> velocityEstimator; /** estimates velocity from the positions read, in ticks */
+};
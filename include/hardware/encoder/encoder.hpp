@@ -1,6 +1,7 @@
 #pragma once
 
 #include "units/Angle.hpp"
+#include <cstdint>
 
 /**
  * @brief enum to represent the status of the encoder
@@ -78,6 +79,33 @@ class Encoder {
          * @return Angle
          */
         virtual Angle getAngle() = 0;
+        /**
+         * @brief Get the angular velocity measured by the encoder
+         *
+         * Implementations should use a hardware velocity measurement if one is available. Encoders
+         * without a hardware rate can estimate it with a #VelocityEstimator.
+         *
+         * @return AngularVelocity the velocity measured by the encoder
+         */
+        virtual AngularVelocity getVelocity() = 0;
+        /**
+         * @brief Get the unbounded position of the encoder in ticks
+         *
+         * Ticks are the native resolution of the encoder, counted in 64 bits so they never wrap. The difference
+         * between two tick counts is exact, unlike the difference between two positions, which loses precision
+         * as the position grows. The default implementation converts getPosition() to ticks
+         *
+         * @return int64_t the position in ticks. Multiply by getTickAngle() to convert to an angle
+         */
+        virtual int64_t getTicks();
+        /**
+         * @brief Get the angle of a single tick, including the gear ratio
+         *
+         * The default implementation returns 0.01 degrees
+         *
+         * @return Angle
+         */
+        virtual Angle getTickAngle();
         /**
          * @brief get whether the encoder is reversed or not
          *
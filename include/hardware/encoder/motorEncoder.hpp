@@ -0,0 +1,140 @@
+#pragma once
+
+#include "hardware/encoder/encoder.hpp"
+#include "hardware/motor/motorGroup.hpp"
+#include <memory>
+
+/**
+ * @brief Integrated encoder of a V5 motor, inherits from Encoder
+ *
+ * This lets odometry run off the drive motors when the robot has no tracking wheels. The encoder counts ticks of the
+ * cartridge output, so its resolution depends on the cartridge: 1800 ticks per rotation for red, 900 for green and
+ * 300 for blue. The encoder reads a motor of the drive's motor group instead of creating its own, so every reading
+ * comes from the same telemetry snapshot the drive uses, and the motor is read once per tick no matter how many
+ * values are requested, see #SensorCache.
+ *
+ * Taring or setting the position of the encoder only changes the encoder, not the motor, so it doesn't affect
+ * anything else using the motor's position.
+ */
+class MotorEncoder : public Encoder {
+    public:
+        /**
+         * @brief Construct a new Motor Encoder object
+         *
+         * The cartridge and gear ratio are those of the motor group, and the encoder has the direction of the motor
+         *
+         * @param motors the motor group the motor is in
+         * @param index the index of the motor in the group. Defaults to 0, the first motor
+         */
+        MotorEncoder(std::shared_ptr<MotorGroup> motors, size_t index = 0);
+        /**
+         * @brief calibrate the encoder
+         *
+         * This will zero the encoder
+         */
+        void calibrate() override;
+        /**
+         * @brief Get the status of the encoder
+         *
+         * @return int ENCODER_CALIBRATED if the motor can be read, ENCODER_UNKNOWN_ERROR otherwise, or if the group
+         * has no motor at the index
+         */
+        int getStatus() override;
+        /**
+         * @brief tare the encoder
+         *
+         * This will zero the encoder
+         */
+        void tare() override;
+        /**
+         * @brief Get the unbounded angle measured by the encoder
+         *
+         * @return Angle the angle measured by the encoder
+         */
+        Angle getPosition() override;
+        /**
+         * @brief Set the unbounded angle of the encoder
+         *
+         * @param angle the angle to set the encoder to
+         */
+        void setPosition(Angle angle) override;
+        /**
+         * @brief Get the bounded angle measured by the encoder
+         *
+         * @return Angle the angle measured by the encoder, between 0 and 1 rotation
+         */
+        Angle getAngle() override;
+        /**
+         * @brief Get the angular velocity measured by the encoder
+         *
+         * This uses the velocity measured by the motor itself
+         *
+         * @return AngularVelocity the velocity measured by the encoder
+         */
+        AngularVelocity getVelocity() override;
+        /**
+         * @brief Get the unbounded position of the encoder in ticks
+         *
+         * The motor reports its position as a double, so the tick count never wraps
+         *
+         * @return int64_t the position in ticks of the cartridge output
+         */
+        int64_t getTicks() override;
+        /**
+         * @brief Get the angle of a single tick, including the gear ratio
+         *
+         * @return Angle a rotation divided by the ticks per rotation of the cartridge, times the gear ratio
+         */
+        Angle getTickAngle() override;
+        /**
+         * @brief get whether the encoder is reversed or not
+         *
+         * @return true the encoder is reversed
+         * @return false the encoder is not reversed
+         */
+        bool getReversed() override;
+        /**
+         * @brief set whether the encoder should be reversed or not
+         *
+         * This inverts the position measured so far as well as subsequent changes
+         *
+         * @param reversed whether the encoder should be reversed or not
+         */
+        void setReversed(bool reversed) override;
+        /**
+         * @brief Get the gear ratio of the encoder
+         *
+         * @return float teeth of driven gear / teeth of driving gear
+         */
+        float getGearRatio() override;
+        /**
+         * @brief Set the gear ratio of the encoder
+         *
+         * This rescales the position measured so far as well as subsequent changes
+         *
+         * @param gearRatio teeth of driven gear / teeth of driving gear
+         */
+        void setGearRatio(float gearRatio) override;
+    private:
+        /**
+         * @brief Get the motor the encoder reads
+         *
+         * @return Motor* nullptr if the group has no motor at the index
+         */
+        Motor* getMotor();
+        /**
+         * @brief read the position of the cartridge output from the motor
+         *
+         * @return int64_t the position in ticks, with the encoder's direction. The last position if the motor
+         * can't be read
+         */
+        int64_t readTicks();
+        const std::shared_ptr<MotorGroup> motors; /** the motor group the motor is in */
+        const size_t index; /** index of the motor in the group */
+        const Angle cartridgeTick; /** angle of a tick of the cartridge output */
+        float gearRatio; /** gear ratio. teeth of driven gear / teeth of driving gear */
+        Angle tickAngle; /** angle of a single tick, including the gear ratio */
+        bool reversed = false; /** whether the encoder is reversed, on top of the port being negative */
+        int64_t lastTicks = 0; /** the last position read from the motor, in ticks with the encoder's direction */
+        int64_t offset = 0; /** added to the motor's position to get the encoder's position, in ticks */
+};
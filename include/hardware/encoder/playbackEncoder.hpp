@@ -0,0 +1,52 @@
+#pragma once
+
+#include "hardware/encoder/encoder.hpp"
+#include "hardware/sensorLog.hpp"
+#include "timer.hpp"
+#include <memory>
+
+/**
+ * @brief Encoder which plays back values recorded by #RecordingEncoder
+ *
+ * Every read returns the value recorded at or before the current time, so the log plays back at the speed of the
+ * clock. On the host the clock is virtual, so a log plays back as fast as the code reading it can run. Reads of a
+ * field before its first recorded value return 0.
+ *
+ * Writes are ignored: the recorded values already include the effect of the writes made while recording, so
+ * the code being played back should make the same writes at the same times.
+ */
+class PlaybackEncoder : public Encoder {
+    public:
+        /**
+         * @brief Construct a new Playback Encoder object
+         *
+         * @param log the log to play back
+         * @param id the id the encoder was recorded with
+         * @param clock the time values are looked up at. Defaults to Timer::now(), tools replaying logs without the
+         * simulation pass their own
+         */
+        PlaybackEncoder(std::shared_ptr<SensorLogReader> log, int id, Clock clock = Timer::now);
+        void calibrate() override;
+        int getStatus() override;
+        void tare() override;
+        Angle getPosition() override;
+        void setPosition(Angle angle) override;
+        Angle getAngle() override;
+        AngularVelocity getVelocity() override;
+        bool getReversed() override;
+        void setReversed(bool reversed) override;
+        float getGearRatio() override;
+        void setGearRatio(float gearRatio) override;
+    private:
+        /**
+         * @brief Get the recorded value of a field at the current time
+         *
+         * @param field the field, see #EncoderField
+         * @param fallback the value to return if the field hasn't been recorded yet
+         * @return double
+         */
+        double get(int field, double fallback = 0);
+        const std::shared_ptr<SensorLogReader> log;
+        const int id;
+        const Clock clock;
+};
@@ -0,0 +1,39 @@
+#pragma once
+
+#include "hardware/encoder/encoder.hpp"
+#include "hardware/sensorLog.hpp"
+#include <memory>
+
+/**
+ * @brief Encoder decorator which records every value read from another encoder
+ *
+ * Values are forwarded unchanged, and written to a sensor log with the time they were read. The log can be played
+ * back with #PlaybackEncoder. Writes to the encoder are forwarded but not recorded, since the values read after
+ * them already include their effect.
+ */
+class RecordingEncoder : public Encoder {
+    public:
+        /**
+         * @brief Construct a new Recording Encoder object
+         *
+         * @param encoder the encoder to record
+         * @param log the log to record to, which can be shared with other sensors
+         * @param id the id of the encoder in the log, from 0 to 15. Every sensor in a log needs a unique id
+         */
+        RecordingEncoder(std::shared_ptr<Encoder> encoder, std::shared_ptr<SensorLogWriter> log, int id);
+        void calibrate() override;
+        int getStatus() override;
+        void tare() override;
+        Angle getPosition() override;
+        void setPosition(Angle angle) override;
+        Angle getAngle() override;
+        AngularVelocity getVelocity() override;
+        bool getReversed() override;
+        void setReversed(bool reversed) override;
+        float getGearRatio() override;
+        void setGearRatio(float gearRatio) override;
+    private:
+        const std::shared_ptr<Encoder> encoder;
+        const std::shared_ptr<SensorLogWriter> log;
+        const int id;
+};
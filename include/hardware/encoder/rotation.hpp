@@ -1,6 +1,7 @@
 #pragma once
 
 #include "hardware/encoder/encoder.hpp"
+#include "hardware/sensorCache.hpp"
 #include "pros/rotation.hpp"
 
 /**
@@ -73,6 +74,31 @@ class Rotation : public Encoder {
          * @return Angle
          */
         Angle getAngle() override;
+        /**
+         * @brief Get the angular velocity measured by the encoder
+         *
+         * This uses the velocity measured by the rotation sensor itself, so it does not suffer from
+         * the quantization of differentiating the position
+         *
+         * @return AngularVelocity the velocity measured by the encoder
+         */
+        AngularVelocity getVelocity() override;
+        /**
+         * @brief Get the unbounded position of the encoder in ticks
+         *
+         * The rotation sensor counts centidegrees in 32 bits, which wraps after about 59,650 rotations. The change
+         * in the count is accumulated in 64 bits every time the sensor is read, so the count never wraps as long as
+         * the sensor is read at least once every 59,650 rotations
+         *
+         * @return int64_t the position in centidegrees of the sensor
+         */
+        int64_t getTicks() override;
+        /**
+         * @brief Get the angle of a single tick, including the gear ratio
+         *
+         * @return Angle 0.01 degrees times the gear ratio
+         */
+        Angle getTickAngle() override;
         /**
          * @brief get whether the encoder is reversed or not
          *
@@ -109,5 +135,24 @@ class Rotation : public Encoder {
         void setGearRatio(float gearRatio) override;
     private:
         const std::unique_ptr<pros::Rotation> sensor; /** unique ptr to the rotation sensor */
+        /**
+         * @brief accumulate a raw position reading into the 64 bit tick count
+         *
+         * @param raw the position reported by the sensor, in centidegrees
+         * @return int64_t the tick count
+         */
+        int64_t accumulate(int32_t raw);
+        /**
+         * @brief set the 64 bit tick count, after the sensor's position is written
+         *
+         * @param ticks the new tick count
+         */
+        void resetTicks(int64_t ticks);
         float gearRatio; /** gear ratio. teeth of driven gear / teeth of driving gear */
+        Angle tickAngle; /** angle of a single tick, including the gear ratio */
+        int64_t ticks = 0; /** accumulated position, in centidegrees */
+        int32_t lastRaw = 0; /** the last position reported by the sensor, in centidegrees */
+        CachedReading<int64_t> positionReading; /** cached position reading, in centidegrees */
+        CachedReading<int32_t> angleReading; /** cached angle reading, in centidegrees */
+        CachedReading<int32_t> velocityReading; /** cached velocity reading, in centidegrees per second */
 };
@@ -0,0 +1,80 @@
+#pragma once
+
+#include "units/Angle.hpp"
+#include <array>
+
+/**
+ * @brief Least-squares velocity estimator
+ *
+ * Estimates velocity as the slope of the least-squares line through the last N timestamped position
+ * samples. Fitting a line over a window instead of differencing the last two samples averages out the
+ * quantization of the position measurement, which dominates at low speeds. Samples are stored in a fixed
+ * size ring buffer, so adding samples and estimating velocity never allocates.
+ *
+ * @tparam N the number of samples in the window
+ */
+template <int N = 8> class VelocityEstimator {
+        static_assert(N >= 2, "VelocityEstimator needs at least 2 samples to estimate velocity");
+    public:
+        /**
+         * @brief add a sample to the window
+         *
+         * Samples with the same timestamp as the latest sample replace it, so the estimator can be fed
+         * every time the position is read.
+         *
+         * @param time the time the sample was taken
+         * @param position the position measured at that time
+         */
+        void addSample(Time time, Angle position) {
+            if (count > 0 && times[newest] == time.val()) {
+                positions[newest] = position.val();
+                return;
+            }
+            newest = (newest + 1) % N;
+            times[newest] = time.val();
+            positions[newest] = position.val();
+            if (count < N) count++;
+        }
+
+        /**
+         * @brief Get the estimated velocity
+         *
+         * @return AngularVelocity the slope of the least-squares line through the samples in the window. 0 if
+         * there are less than 2 samples
+         */
+        AngularVelocity getVelocity() const {
+            if (count < 2) return 0;
+            // times and positions are taken relative to the newest sample to preserve precision
+            double meanT = 0;
+            double meanX = 0;
+            for (int i = 0; i < count; i++) {
+                const int j = (newest - i + N) % N;
+                meanT += times[j] - times[newest];
+                meanX += positions[j] - positions[newest];
+            }
+            meanT /= count;
+            meanX /= count;
+            double sTX = 0;
+            double sTT = 0;
+            for (int i = 0; i < count; i++) {
+                const int j = (newest - i + N) % N;
+                const double t = times[j] - times[newest] - meanT;
+                sTX += t * (positions[j] - positions[newest] - meanX);
+                sTT += t * t;
+            }
+            return (sTT == 0) ? 0 : sTX / sTT;
+        }
+
+        /**
+         * @brief clear all samples
+         *
+         * This should be called whenever the position is changed by something other than motion, e.g when the
+         * encoder is tared
+         */
+        void reset() { count = 0; }
+    private:
+        std::array<double, N> times {}; /** sample times, in seconds */
+        std::array<double, N> positions {}; /** sample positions, in radians */
+        int newest = 0; /** index of the newest sample */
+        int count = 0; /** number of samples in the window */
+};
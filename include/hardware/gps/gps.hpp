@@ -0,0 +1,61 @@
+#pragma once
+
+#include "units/Pose.hpp"
+
+/**
+ * @brief GPSStatus enum
+ *
+ * This enum is used to represent the status of a generic GPS (absolute position sensor)
+ *
+ * We use an enum instead of an enum class for consistency with #IMUStatus, so implementations can define additional
+ * status codes greater than the highest one defined here
+ */
+enum GPSStatus { GPS_READY = 0, GPS_CALIBRATING = 1, GPS_UNKNOWN_ERROR = 2 };
+
+/**
+ * @class GPS
+ *
+ * @brief Abstract GPS class
+ *
+ * A GPS measures the absolute pose of the robot on the field. Positions are in field coordinates, and the heading is
+ * a standard angle like the heading of odometry
+ */
+class GPS {
+    public:
+        /**
+         * @brief Initialize the GPS, non-blocking
+         *
+         */
+        virtual void calibrate() = 0;
+        /**
+         * @brief Get the Status of the GPS
+         *
+         * @return int see #GPSStatus for possible return values
+         */
+        virtual int getStatus() = 0;
+        /**
+         * @brief Get the pose of the tracking center measured by the GPS
+         *
+         * The pose is only meaningful if the status is #GPS_READY
+         *
+         * @return units::Pose
+         */
+        virtual units::Pose getPose() = 0;
+        /**
+         * @brief Get the error of the position, as reported by the GPS
+         *
+         * @return Length the root mean square error of the position
+         */
+        virtual Length getError() = 0;
+        /**
+         * @brief Set the pose of the GPS
+         *
+         * @param pose the new pose
+         */
+        virtual void setPose(units::Pose pose) = 0;
+        /**
+         * @brief Destroy the GPS object
+         *
+         */
+        virtual ~GPS();
+};
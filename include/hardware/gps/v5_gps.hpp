@@ -0,0 +1,54 @@
+#pragma once
+
+#include "hardware/gps/gps.hpp"
+#include "hardware/sensorCache.hpp"
+#include "pros/gps.h"
+
+class V5GPS : public GPS {
+    public:
+        /**
+         * @brief Construct a new V5GPS object
+         *
+         * @param port the port the GPS is connected to
+         * @param xOffset offset of the GPS to the right of the tracking center. Defaults to 0
+         * @param yOffset offset of the GPS forwards from the tracking center. Defaults to 0
+         */
+        V5GPS(int port, Length xOffset = 0_m, Length yOffset = 0_m);
+        /**
+         * @brief Initialize the GPS, non-blocking
+         *
+         * This sets the offset of the sensor, so it reports the pose of the tracking center
+         */
+        virtual void calibrate() override;
+        /**
+         * @brief Get the Status of the GPS
+         *
+         * @return int see #GPSStatus for possible return values
+         */
+        virtual int getStatus() override;
+        /**
+         * @brief Get the pose of the tracking center measured by the GPS
+         *
+         * @return units::Pose
+         */
+        virtual units::Pose getPose() override;
+        /**
+         * @brief Get the error of the position, as reported by the GPS
+         *
+         * @return Length the root mean square error of the position
+         */
+        virtual Length getError() override;
+        /**
+         * @brief Set the pose of the GPS
+         *
+         * @param pose the new pose
+         */
+        virtual void setPose(units::Pose pose) override;
+    private:
+        const int port;
+        const Length xOffset;
+        const Length yOffset;
+        CachedReading<int> statusReading; /** cached status, see #GPSStatus */
+        CachedReading<double> errorReading; /** cached error reading, in meters */
+        CachedReading<pros::gps_status_s_t> poseReading; /** cached position in meters and yaw in compass degrees */
+};
@@ -0,0 +1,95 @@
+#pragma once
+
+#include "units/units.hpp"
+#include <optional>
+
+/**
+ * @brief enum to represent the health of a sensor
+ *
+ * We use a regular enum instead of an enum class for consistency with #EncoderStatus and #IMUStatus
+ */
+enum SensorHealth {
+    SENSOR_HEALTHY = 0, /** the sensor is working as expected */
+    SENSOR_DISCONNECTED = 1, /** the sensor reported that it is disconnected or not functioning */
+    SENSOR_STUCK = 2, /** the sensor stopped changing while the reference kept moving */
+    SENSOR_JUMPED = 3 /** the sensor reported a change that is not physically plausible */
+};
+
+/**
+ * @brief Sensor health monitor
+ *
+ * Checks the change measured by a sensor every tick for disconnection, stuck values, and implausible jumps.
+ * Stuck values and jumps are detected against an independent reference when one is available, for example
+ * the drive motor encoders for a tracking wheel.
+ *
+ * Once a fault is detected it is latched until reset() is called, as the sensor's accumulated measurement
+ * can no longer be trusted.
+ *
+ * @tparam Q the type of quantity measured by the sensor
+ */
+template <isQuantity Q> class HealthMonitor {
+    public:
+        /**
+         * @brief Construct a new Health Monitor object
+         *
+         * @param maxDelta the maximum plausible change in a single tick
+         * @param maxDiscrepancy the maximum plausible difference between the sensor and the reference in a single
+         * tick
+         * @param stuckThreshold the minimum change of the reference in a tick for the sensor to be expected to change
+         * @param stuckTicks how many consecutive ticks the sensor has to not change while the reference is moving to
+         * be considered stuck
+         */
+        HealthMonitor(Q maxDelta, Q maxDiscrepancy, Q stuckThreshold, int stuckTicks)
+            : maxDelta(maxDelta),
+              maxDiscrepancy(maxDiscrepancy),
+              stuckThreshold(stuckThreshold),
+              stuckTicks(stuckTicks) {}
+
+        /**
+         * @brief check the health of the sensor
+         *
+         * This should be called once per tick
+         *
+         * @param connected whether the sensor reports that it is connected and functioning
+         * @param delta the change measured by the sensor since the last tick
+         * @param referenceDelta the change measured by the reference since the last tick, if there is one
+         * @return int the health of the sensor. See #SensorHealth
+         */
+        int update(bool connected, Q delta, std::optional<Q> referenceDelta = std::nullopt) {
+            if (health != SENSOR_HEALTHY) return health; // faults are latched
+            if (!connected) return health = SENSOR_DISCONNECTED;
+            // NaN fails every comparison, so check that the delta is within bounds instead of out of bounds
+            if (!(units::abs(delta) <= maxDelta)) return health = SENSOR_JUMPED;
+            if (referenceDelta) {
+                if (units::abs(delta - *referenceDelta) > maxDiscrepancy) return health = SENSOR_JUMPED;
+                // the sensor is stuck if it doesn't change at all while the reference is moving
+                if (delta.val() == 0 && units::abs(*referenceDelta) > stuckThreshold) stuckCount++;
+                else stuckCount = 0;
+                if (stuckCount >= stuckTicks) return health = SENSOR_STUCK;
+            }
+            return health;
+        }
+
+        /**
+         * @brief Get the health of the sensor
+         *
+         * @return int see #SensorHealth
+         */
+        int getHealth() const { return health; }
+
+        /**
+         * @brief clear any latched fault
+         *
+         */
+        void reset() {
+            health = SENSOR_HEALTHY;
+            stuckCount = 0;
+        }
+    private:
+        const Q maxDelta; /** maximum plausible change in a single tick */
+        const Q maxDiscrepancy; /** maximum plausible difference between the sensor and the reference in a tick */
+        const Q stuckThreshold; /** minimum change of the reference for the sensor to be expected to change */
+        const int stuckTicks; /** ticks without change before the sensor is considered stuck */
+        int stuckCount = 0; /** consecutive ticks the sensor hasn't changed while the reference moved */
+        int health = SENSOR_HEALTHY; /** the latched health of the sensor */
+};
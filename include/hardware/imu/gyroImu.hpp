@@ -0,0 +1,87 @@
+#pragma once
+
+#include "hardware/imu/v5_imu.hpp"
+#include "pros/rtos.hpp"
+#include <atomic>
+#include <optional>
+
+/**
+ * @brief V5 IMU which integrates heading from the raw gyro rate
+ *
+ * The rotation reported by the V5 IMU is filtered inside the sensor, which makes it lag behind the robot during fast
+ * turns. This class samples the gyro at the fastest data rate of the sensor in its own task, and integrates the
+ * heading itself, so the heading and angular velocity are as fresh as the gyro.
+ *
+ * Integrating a gyro accumulates its bias, so the bias is measured while the robot is still after the sensor
+ * calibrates, and is kept up to date whenever the robot stays still afterwards. Pitch, roll, acceleration and
+ * orientation are read from the sensor like #V5IMU
+ */
+class GyroIMU : public V5IMU {
+    public:
+        /**
+         * @brief Construct a new Gyro IMU object
+         *
+         * @param port the port the IMU is connected to
+         * @param scale multiplier applied to the gyro rate, to correct the scale error of the sensor. Defaults to 1
+         * @param biasTime how long the bias is measured for after the sensor calibrates. Defaults to 1 second
+         */
+        GyroIMU(int port, double scale = 1, Time biasTime = 1_sec);
+        /**
+         * @brief Calibrate the IMU and measure the bias of the gyro, non-blocking
+         *
+         * This starts the sampling task the first time it is called
+         */
+        void calibrate() override;
+        /**
+         * @brief Get the Status of the IMU
+         *
+         * @return int see #IMUStatus for possible return values. The IMU is calibrating until the bias is measured
+         */
+        int getStatus() override;
+        /**
+         * @brief Get the integrated rotation
+         *
+         * @return Angle
+         */
+        Angle getRotation() override;
+        /**
+         * @brief Get the integrated yaw
+         *
+         * The yaw is bounded between -0.5 and 0.5 rotations.
+         *
+         * @return Angle
+         */
+        Angle getYaw() override;
+        /**
+         * @brief Set the integrated yaw
+         *
+         * @param angle the new yaw
+         */
+        void setYaw(Angle angle) override;
+        /**
+         * @brief Get the bias corrected angular velocity around the vertical axis
+         *
+         * @return AngularVelocity counterclockwise positive
+         */
+        AngularVelocity getAngularVelocity() override;
+    private:
+        /**
+         * @brief sample the gyro and integrate the heading. Called by the sampling task
+         *
+         */
+        void sample();
+        const double scale;
+        const Time biasTime;
+        std::optional<pros::Task> task;
+        std::atomic<bool> restart = false; /** set by calibrate() so the task starts measuring the bias again */
+        std::atomic<bool> biasMeasured = false; /** whether the initial bias measurement finished */
+        std::atomic<double> heading = 90; /** integrated heading, in standard degrees */
+        std::atomic<double> rate = 0; /** bias corrected rate, in degrees per second counterclockwise */
+        // state of the sampling task
+        double bias = 0; /** bias of the gyro, in degrees per second */
+        double biasSum = 0; /** sum of the rates sampled while measuring the bias */
+        int biasSamples = 0; /** number of rates sampled while measuring the bias */
+        double filteredRate = 0; /** low pass filtered bias corrected rate, in degrees per second */
+        Time stillTime = 0_sec; /** how long the robot has been still */
+        std::optional<uint64_t> lastMicros; /** when the gyro was last sampled, in microseconds */
+};
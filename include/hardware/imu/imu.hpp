@@ -64,6 +64,14 @@ class IMU {
          * @param angle the new yaw
          */
         virtual void setYaw(Angle angle) = 0;
+        /**
+         * @brief Get the angular velocity around the vertical axis
+         *
+         * Counterclockwise is positive, like the heading of odometry
+         *
+         * @return AngularVelocity
+         */
+        virtual AngularVelocity getAngularVelocity() = 0;
         /**
          * @brief Get the pitch measured by the IMU
          *
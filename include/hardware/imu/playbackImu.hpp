@@ -0,0 +1,55 @@
+#pragma once
+
+#include "hardware/imu/imu.hpp"
+#include "hardware/sensorLog.hpp"
+#include "timer.hpp"
+#include <memory>
+
+/**
+ * @brief IMU which plays back values recorded by #RecordingIMU
+ *
+ * Every read returns the value recorded at or before the current time, so the log plays back at the speed of the
+ * clock. On the host the clock is virtual, so a log plays back as fast as the code reading it can run. Reads of a
+ * field before its first recorded value return 0.
+ *
+ * Writes are ignored: the recorded values already include the effect of the writes made while recording, so
+ * the code being played back should make the same writes at the same times.
+ */
+class PlaybackIMU : public IMU {
+    public:
+        /**
+         * @brief Construct a new Playback IMU object
+         *
+         * @param log the log to play back
+         * @param id the id the IMU was recorded with
+         * @param clock the time values are looked up at. Defaults to Timer::now(), tools replaying logs without the
+         * simulation pass their own
+         */
+        PlaybackIMU(std::shared_ptr<SensorLogReader> log, int id, Clock clock = Timer::now);
+        void calibrate() override;
+        int getStatus() override;
+        Angle getRotation() override;
+        Angle getYaw() override;
+        void setYaw(Angle angle) override;
+        AngularVelocity getAngularVelocity() override;
+        Angle getPitch() override;
+        void setPitch(Angle angle) override;
+        Angle getRoll() override;
+        void setRoll(Angle angle) override;
+        LinearAcceleration getXAcceleration() override;
+        LinearAcceleration getYAcceleration() override;
+        LinearAcceleration getZAcceleration() override;
+        IMUOrientation getOrientation() override;
+    private:
+        /**
+         * @brief Get the recorded value of a field at the current time
+         *
+         * @param field the field, see #IMUField
+         * @param fallback the value to return if the field hasn't been recorded yet
+         * @return double
+         */
+        double get(int field, double fallback = 0);
+        const std::shared_ptr<SensorLogReader> log;
+        const int id;
+        const Clock clock;
+};
@@ -0,0 +1,58 @@
+#pragma once
+
+#include "hardware/imu/imu.hpp"
+#include "hardware/sensorLog.hpp"
+#include <memory>
+
+/**
+ * @brief IMU decorator which records every value read from another IMU
+ *
+ * Values are forwarded unchanged, and written to a sensor log with the time they were read. The log can be played
+ * back with #PlaybackIMU. Writes to the IMU are forwarded but not recorded, since the values read after them
+ * already include their effect.
+ */
+class RecordingIMU : public IMU {
+    public:
+        /**
+         * @brief Construct a new Recording IMU object
+         *
+         * @param imu the IMU to record
+         * @param log the log to record to, which can be shared with other sensors
+         * @param id the id of the IMU in the log, from 0 to 15. Every sensor in a log needs a unique id
+         */
+        RecordingIMU(std::shared_ptr<IMU> imu, std::shared_ptr<SensorLogWriter> log, int id);
+        void calibrate() override;
+        int getStatus() override;
+        Angle getRotation() override;
+        Angle getYaw() override;
+        void setYaw(Angle angle) override;
+        AngularVelocity getAngularVelocity() override;
+        Angle getPitch() override;
+        void setPitch(Angle angle) override;
+        Angle getRoll() override;
+        void setRoll(Angle angle) override;
+        LinearAcceleration getXAcceleration() override;
+        LinearAcceleration getYAcceleration() override;
+        LinearAcceleration getZAcceleration() override;
+        IMUOrientation getOrientation() override;
+    private:
+        /**
+         * @brief record an angle and return it
+         *
+         * @param field the field, see #IMUField
+         * @param angle the angle
+         * @return Angle
+         */
+        Angle record(int field, Angle angle);
+        /**
+         * @brief record an acceleration and return it
+         *
+         * @param field the field, see #IMUField
+         * @param acceleration the acceleration
+         * @return LinearAcceleration
+         */
+        LinearAcceleration record(int field, LinearAcceleration acceleration);
+        const std::shared_ptr<IMU> imu;
+        const std::shared_ptr<SensorLogWriter> log;
+        const int id;
+};
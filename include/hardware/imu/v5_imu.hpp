@@ -1,6 +1,7 @@
 #pragma once
 
 #include "hardware/imu/imu.hpp"
+#include "hardware/sensorCache.hpp"
 #include "pros/imu.hpp"
 
 class V5IMU : public IMU {
@@ -52,6 +53,14 @@ class V5IMU : public IMU {
          * @param angle the new yaw
          */
         virtual void setYaw(Angle angle) override;
+        /**
+         * @brief Get the angular velocity around the vertical axis
+         *
+         * This is the raw rate of the gyro, so it is more responsive than the rate of change of the rotation
+         *
+         * @return AngularVelocity counterclockwise positive
+         */
+        virtual AngularVelocity getAngularVelocity() override;
         /**
          * @brief Get the pitch measured by the IMU
          *
@@ -100,6 +109,13 @@ class V5IMU : public IMU {
          * @return IMUOrientation
          */
         virtual IMUOrientation getOrientation() override;
-    private:
+    protected:
         const std::unique_ptr<pros::Imu> imu; /** pointer to the PROS Imu*/
+    private:
+        CachedReading<double> rotationReading; /** cached rotation reading, in compass degrees */
+        CachedReading<double> yawReading; /** cached yaw reading, in compass degrees */
+        CachedReading<double> pitchReading; /** cached pitch reading, in compass degrees */
+        CachedReading<double> rollReading; /** cached roll reading, in compass degrees */
+        CachedReading<pros::imu_accel_s_t> accelReading; /** cached acceleration reading */
+        CachedReading<pros::imu_gyro_s_t> gyroReading; /** cached gyro reading, in degrees per second */
 };
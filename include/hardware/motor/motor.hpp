@@ -0,0 +1,127 @@
+#pragma once
+
+#include "hardware/sensorCache.hpp"
+#include "units/Angle.hpp"
+
+/**
+ * @brief V5 motor gear cartridges
+ *
+ * The value of each cartridge is its free speed in rpm
+ */
+enum class Cartridge { RED = 100, GREEN = 200, BLUE = 600 };
+
+/**
+ * @brief snapshot of the telemetry of a motor
+ *
+ * All values are measured at the output of the external gear ratio
+ */
+struct MotorTelemetry {
+        Angle position; /** position of the output */
+        AngularVelocity velocity; /** velocity of the output */
+        Voltage voltage; /** voltage applied to the motor */
+        Current current; /** current drawn by the motor */
+        double temperature = 0; /** temperature of the motor, in degrees celsius */
+};
+
+/**
+ * @brief V5 motor abstraction
+ *
+ * Motors speak in unit types and account for their gear cartridge and external gear ratio, so callers don't have
+ * to convert between rpm, millivolts, and encoder units. Telemetry is read in one snapshot per tick, see
+ * #SensorCache.
+ */
+class Motor {
+    public:
+        /**
+         * @brief Construct a new Motor object
+         *
+         * @param port the port of the motor. Use negative to reverse the motor
+         * @param cartridge the gear cartridge of the motor
+         * @param gearRatio the external gear ratio (teeth of driven gear / teeth of driving gear). Defaults to 1.0
+         */
+        Motor(int port, Cartridge cartridge, double gearRatio = 1.0);
+        /**
+         * @brief move the motor with a voltage
+         *
+         * @param voltage the voltage to apply, clamped to +-12 volts
+         */
+        void moveVoltage(Voltage voltage);
+        /**
+         * @brief move the motor with the motor's internal velocity controller
+         *
+         * @param velocity the target velocity of the output
+         */
+        void moveVelocity(AngularVelocity velocity);
+        /**
+         * @brief Get a snapshot of the telemetry of the motor
+         *
+         * The snapshot is read from the motor once per tick, and returned from the cache for the rest of the tick
+         *
+         * @return MotorTelemetry
+         */
+        MotorTelemetry getTelemetry();
+        /**
+         * @brief Get the position of the output
+         *
+         * @return Angle
+         */
+        Angle getPosition();
+        /**
+         * @brief Get the velocity of the output
+         *
+         * @return AngularVelocity
+         */
+        AngularVelocity getVelocity();
+        /**
+         * @brief Get the voltage applied to the motor
+         *
+         * @return Voltage
+         */
+        Voltage getVoltage();
+        /**
+         * @brief Get the current drawn by the motor
+         *
+         * @return Current
+         */
+        Current getCurrent();
+        /**
+         * @brief Get the temperature of the motor
+         *
+         * @return double degrees celsius
+         */
+        double getTemperature();
+        /**
+         * @brief set the position of the output to 0
+         *
+         */
+        void tare();
+        /**
+         * @brief Get the maximum velocity of the output
+         *
+         * @return AngularVelocity the free speed of the cartridge, multiplied by the gear ratio
+         */
+        AngularVelocity getMaxVelocity() const;
+        /**
+         * @brief Get the gear cartridge of the motor
+         *
+         * @return Cartridge
+         */
+        Cartridge getCartridge() const;
+        /**
+         * @brief Get the external gear ratio
+         *
+         * @return double teeth of driven gear / teeth of driving gear
+         */
+        double getGearRatio() const;
+        /**
+         * @brief Get the port of the motor
+         *
+         * @return int the port of the motor, negative if the motor is reversed
+         */
+        int getPort() const;
+    private:
+        int port; /** port of the motor, negative if reversed */
+        Cartridge cartridge; /** gear cartridge of the motor */
+        double gearRatio; /** external gear ratio. teeth of driven gear / teeth of driving gear */
+        CachedReading<MotorTelemetry> telemetry; /** cached telemetry snapshot */
+};
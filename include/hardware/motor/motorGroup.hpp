@@ -0,0 +1,84 @@
+#pragma once
+
+#include "hardware/motor/motor.hpp"
+#include <initializer_list>
+#include <vector>
+
+/**
+ * @brief group of motors which drive the same mechanism
+ *
+ * Every motor in the group shares the same gear cartridge and external gear ratio. The motors are allocated
+ * once when the group is constructed, and reading telemetry or commanding the group never allocates.
+ */
+class MotorGroup {
+    public:
+        /**
+         * @brief Construct a new Motor Group object
+         *
+         * @param ports the ports of the motors. Use negative to reverse a motor
+         * @param cartridge the gear cartridge of the motors
+         * @param gearRatio the external gear ratio (teeth of driven gear / teeth of driving gear). Defaults to 1.0
+         */
+        MotorGroup(std::initializer_list<int> ports, Cartridge cartridge, double gearRatio = 1.0);
+        /**
+         * @brief move every motor in the group with a voltage
+         *
+         * @param voltage the voltage to apply, clamped to +-12 volts
+         */
+        void moveVoltage(Voltage voltage);
+        /**
+         * @brief move every motor in the group with the motors' internal velocity controllers
+         *
+         * @param velocity the target velocity of the output
+         */
+        void moveVelocity(AngularVelocity velocity);
+        /**
+         * @brief Get the average position of the output
+         *
+         * @return Angle
+         */
+        Angle getPosition();
+        /**
+         * @brief Get the average velocity of the output
+         *
+         * @return AngularVelocity
+         */
+        AngularVelocity getVelocity();
+        /**
+         * @brief Get the average voltage applied to the motors
+         *
+         * @return Voltage
+         */
+        Voltage getVoltage();
+        /**
+         * @brief Get the total current drawn by the motors
+         *
+         * @return Current
+         */
+        Current getCurrent();
+        /**
+         * @brief Get the temperature of the hottest motor in the group
+         *
+         * @return double degrees celsius
+         */
+        double getTemperature();
+        /**
+         * @brief set the position of every motor to 0
+         *
+         */
+        void tare();
+        /**
+         * @brief Get the maximum velocity of the output
+         *
+         * @return AngularVelocity
+         */
+        AngularVelocity getMaxVelocity() const;
+        /**
+         * @brief Get the motors in the group
+         *
+         * @return std::vector<Motor>&
+         */
+        std::vector<Motor>& getMotors();
+    private:
+        std::vector<Motor> motors; /** the motors in the group */
+};
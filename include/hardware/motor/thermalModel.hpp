@@ -0,0 +1,171 @@
+#pragma once
+
+#include "hardware/motor/motorGroup.hpp"
+#include "timer.hpp"
+#include <memory>
+#include <optional>
+#include <vector>
+
+/**
+ * @brief parameters of the thermal model of a motor
+ *
+ * The electrical and derating defaults are those of a V5 smart motor. The thermal resistance and capacitance depend
+ * on the robot, like how enclosed the motors are, and their defaults are only placeholders: on the telemetry
+ * generated by host/tools/thermalCheck they never predict a derate which happens at 50 s. Fit them to telemetry
+ * recorded on the robot with thermalCheck --fit, and use the fitted values.
+ */
+struct ThermalParameters {
+        double windingResistance = 1.6; /** resistance of the motor windings, in ohms */
+        double thermalResistance = 3.5; /** thermal resistance between the motor and the air, in degrees C per watt */
+        double thermalCapacitance = 60; /** thermal capacitance of the motor, in joules per degree C */
+        double ambientTemperature = 25; /** temperature of the air around the motor, in degrees C */
+        double observerGain = 0.03; /** fraction of the error between the measured and estimated temperature which
+                                       is corrected per second. The measurement is in steps of 5 degrees C, so the
+                                       estimate has to follow it slowly */
+        double derateTemperature = 55; /** temperature at which the motor starts limiting its current */
+        double derateStep = 5; /** temperature above the last halving of the current limit at which it halves again */
+        int derateSteps = 3; /** how many times the current limit halves before the motor stops */
+};
+
+/**
+ * @brief first order thermal model of a single motor
+ *
+ * The motor heats up with the power lost in its windings (I^2 * R) and cools down proportionally to its
+ * temperature above ambient. The temperature reported by the motor is coarse, so it is used to correct the model's
+ * estimate instead of being used directly.
+ */
+class MotorThermalModel {
+    public:
+        /**
+         * @brief Construct a new Motor Thermal Model object
+         *
+         * @param parameters the parameters of the model, with the thermal resistance and capacitance fitted to the
+         * motor, see #ThermalParameters
+         */
+        MotorThermalModel(ThermalParameters parameters);
+        /**
+         * @brief update the model
+         *
+         * @param current the current drawn by the motor
+         * @param measuredTemperature the temperature reported by the motor, in degrees C
+         * @param dt the time since the last update
+         */
+        void update(Current current, double measuredTemperature, Time dt);
+        /**
+         * @brief Get the estimated temperature of the motor
+         *
+         * @return double degrees C
+         */
+        double getTemperature() const;
+        /**
+         * @brief Get the temperature the motor will reach if it draws a current for a period of time
+         *
+         * @param current the current drawn by the motor
+         * @param time how long the current is drawn for
+         * @return double degrees C
+         */
+        double predictTemperature(Current current, Time time) const;
+        /**
+         * @brief Get how long the motor can draw a current before it starts limiting its current
+         *
+         * @param current the current drawn by the motor
+         * @return std::optional<Time> the time until the motor derates, or std::nullopt if it never will
+         */
+        std::optional<Time> getTimeToDerate(Current current) const;
+        /**
+         * @brief Get the maximum current the motor can draw for a period of time without derating
+         *
+         * @param time how long the current is drawn for
+         * @return Current
+         */
+        Current getSustainableCurrent(Time time) const;
+        /**
+         * @brief Get the fraction of the motor's current limit available at the estimated temperature
+         *
+         * The motor halves its current limit at the derate temperature, and halves it again every derate step after
+         * that until it has halved it derate steps times, where it stops. For the V5 motor that's 55C, 60C, 65C and
+         * 70C
+         *
+         * @return double from 0 to 1
+         */
+        double getCurrentLimitScale() const;
+        /**
+         * @brief reset the estimated temperature
+         *
+         * @param temperature the new estimated temperature, in degrees C
+         */
+        void reset(double temperature);
+    private:
+        /**
+         * @brief Get the thermal time constant of the motor
+         *
+         * @return double seconds
+         */
+        double getTimeConstant() const;
+        /**
+         * @brief Get the temperature the motor settles at if it draws a current indefinitely
+         *
+         * @param current the current drawn by the motor
+         * @return double degrees C
+         */
+        double getSteadyStateTemperature(Current current) const;
+        const ThermalParameters parameters;
+        std::optional<double> temperature; /** estimated temperature, in degrees C */
+};
+
+/**
+ * @brief predictive power budget for one or more motor groups
+ *
+ * Keeps a thermal model of every motor, and calculates how much of the current drawn in the last few seconds the
+ * motors can keep drawing until the end of a period (like a skills run) without any of them derating. Motions can
+ * scale their maximum velocity by the budget to slow down slightly before the motors throttle, instead of losing
+ * much more torque after they do.
+ */
+class PowerBudget {
+    public:
+        /**
+         * @brief Construct a new Power Budget object
+         *
+         * The budget is only as good as the thermal model, so fit its parameters first:
+         * 1. log the current and temperature of every drive motor during a few skills runs, see host/tools/thermalCheck
+         * 2. run thermalCheck --fit on the log, and check the fitted model predicts when the motors derated
+         * 3. set the fitted thermal resistance and capacitance in the parameters
+         *
+         * @param groups the motor groups to budget
+         * @param duration how long the motors need to last, for example 60 seconds for a skills run
+         * @param parameters the parameters of the thermal model of each motor, fitted like above
+         */
+        PowerBudget(std::vector<std::shared_ptr<MotorGroup>> groups, Time duration, ThermalParameters parameters);
+        /**
+         * @brief start the budget period
+         *
+         * This should be called at the start of the run the motors need to last for. The chassis does this when the
+         * robot is enabled, if it owns the budget
+         */
+        void start();
+        /**
+         * @brief update the thermal models and the budget
+         *
+         * This should be called once per tick, which the chassis does when it owns the budget
+         */
+        void update();
+        /**
+         * @brief Get the power budget
+         *
+         * @return double the factor to scale the maximum velocity by, from 0 to 1
+         */
+        double getBudget() const;
+        /**
+         * @brief Get the thermal models of the motors, in the same order as the motors in the groups
+         *
+         * @return const std::vector<MotorThermalModel>&
+         */
+        const std::vector<MotorThermalModel>& getModels() const;
+    private:
+        const std::vector<std::shared_ptr<MotorGroup>> groups;
+        std::vector<MotorThermalModel> models;
+        std::vector<double> averageCurrents; /** low pass filtered current of every motor, in amps */
+        Timer timer; /** time left in the budget period */
+        std::optional<Time> lastTime; /** the time of the last update */
+        double budget = 1;
+};
@@ -0,0 +1,87 @@
+#pragma once
+
+#include <cstdint>
+
+/**
+ * @brief Per-tick sensor read cache
+ *
+ * Hardware abstractions read each device at most once per tick, so every consumer in a tick
+ * (odometry, motions, logging) sees the same sample. A new tick starts every time invalidate()
+ * is called, which the chassis does at the start of each update. Until invalidate() is called
+ * for the first time, caching is disabled and every read goes straight to the device.
+ */
+class SensorCache {
+    public:
+        /**
+         * @brief start a new tick, invalidating every cached reading
+         *
+         */
+        static void invalidate();
+        /**
+         * @brief Get the current tick
+         *
+         * @return uint32_t the current tick. 0 if caching has not been enabled yet
+         */
+        static uint32_t getTick();
+        /**
+         * @brief record that device calls were made
+         *
+         * This is called by hardware abstractions every time they read from a device
+         *
+         * @param calls how many device calls were made. Defaults to 1
+         */
+        static void recordDeviceCall(int calls = 1);
+        /**
+         * @brief Get the number of device calls made since the current tick started
+         *
+         * @return int
+         */
+        static int getDeviceCalls();
+        /**
+         * @brief Get the number of device calls made during the previous tick
+         *
+         * @return int
+         */
+        static int getLastTickDeviceCalls();
+};
+
+/**
+ * @brief a single cached device reading
+ *
+ * The reading is refreshed the first time it is requested in a tick, and returned from the
+ * cache for the rest of the tick.
+ *
+ * @tparam T the type of the raw reading
+ */
+template <typename T> class CachedReading {
+    public:
+        /**
+         * @brief Get the reading, reading from the device if the cached value is stale
+         *
+         * @param read function which reads the value from the device
+         * @param calls how many device calls read makes. Defaults to 1
+         * @return T the cached reading
+         */
+        template <typename F> T get(F read, int calls = 1) {
+            const uint32_t now = SensorCache::getTick();
+            // tick 0 means caching is disabled
+            if (!valid || now == 0 || now != tick) {
+                value = read();
+                SensorCache::recordDeviceCall(calls);
+                tick = now;
+                valid = true;
+            }
+            return value;
+        }
+
+        /**
+         * @brief invalidate the cached reading
+         *
+         * This should be called whenever the device is written to, so the next read reflects the write
+         */
+        void invalidate() { valid = false; }
+    private:
+        T value {}; /** the cached value */
+        uint32_t tick = 0; /** the tick the value was read on */
+        bool valid = false; /** whether the cached value is valid */
+};
@@ -0,0 +1,152 @@
+#pragma once
+
+#include "units/units.hpp"
+#include <array>
+#include <cstdint>
+#include <istream>
+#include <memory>
+#include <optional>
+#include <ostream>
+#include <vector>
+
+/**
+ * @brief fields of an encoder which are recorded in a sensor log
+ *
+ * We use a regular enum instead of an enum class for consistency with #EncoderStatus
+ */
+enum EncoderField {
+    ENCODER_FIELD_STATUS = 0,
+    ENCODER_FIELD_POSITION = 1, /** radians */
+    ENCODER_FIELD_ANGLE = 2, /** radians */
+    ENCODER_FIELD_VELOCITY = 3, /** radians per second */
+    ENCODER_FIELD_REVERSED = 4,
+    ENCODER_FIELD_GEAR_RATIO = 5
+};
+
+/**
+ * @brief fields of an IMU which are recorded in a sensor log
+ *
+ * We use a regular enum instead of an enum class for consistency with #IMUStatus
+ */
+enum IMUField {
+    IMU_FIELD_STATUS = 0,
+    IMU_FIELD_ROTATION = 1, /** radians */
+    IMU_FIELD_YAW = 2, /** radians */
+    IMU_FIELD_PITCH = 3, /** radians */
+    IMU_FIELD_ROLL = 4, /** radians */
+    IMU_FIELD_X_ACCELERATION = 5, /** meters per second squared */
+    IMU_FIELD_Y_ACCELERATION = 6, /** meters per second squared */
+    IMU_FIELD_Z_ACCELERATION = 7, /** meters per second squared */
+    IMU_FIELD_ORIENTATION = 8,
+    IMU_FIELD_ANGULAR_VELOCITY = 9 /** radians per second */
+};
+
+/**
+ * @brief Get the channel a field of a sensor is recorded on
+ *
+ * A log holds up to 16 sensors with up to 16 fields each
+ *
+ * @param sensor the id of the sensor, from 0 to 15
+ * @param field the field, see #EncoderField and #IMUField
+ * @return uint8_t
+ */
+constexpr uint8_t sensorChannel(int sensor, int field) { return ((sensor & 0xF) << 4) | (field & 0xF); }
+
+/**
+ * @brief a recorded sensor value
+ *
+ */
+struct SensorSample {
+        Time time; /** the time the value was read */
+        double value; /** the value, in the units of the field */
+};
+
+/**
+ * @brief writes sensor values to a compact binary stream
+ *
+ * The stream starts with a 4 byte magic number and a version byte, followed by 17 byte records: the channel (1 byte),
+ * the time in microseconds since the program started (8 bytes) and the value (8 byte double), all little endian. A
+ * value is only written when it changes, so reading a sensor several times per tick doesn't grow the log. Records are
+ * buffered in memory and written in chunks, so logging to the SD card doesn't stall the control loop on every read.
+ */
+class SensorLogWriter {
+    public:
+        /**
+         * @brief Construct a new Sensor Log Writer object
+         *
+         * @param stream the stream to write to, for example an std::ofstream to a file on the SD card
+         * @param bufferSize how many bytes are buffered before they are written to the stream. Defaults to 4096
+         */
+        SensorLogWriter(std::unique_ptr<std::ostream> stream, size_t bufferSize = 4096);
+        /**
+         * @brief record a value, timestamped with the current time
+         *
+         * @param channel the channel to record the value on, see sensorChannel()
+         * @param value the value
+         */
+        void write(uint8_t channel, double value);
+        /**
+         * @brief write the buffered records to the stream
+         *
+         */
+        void flush();
+        /**
+         * @brief Destroy the Sensor Log Writer object, flushing the buffered records
+         *
+         */
+        ~SensorLogWriter();
+    private:
+        const std::unique_ptr<std::ostream> stream;
+        const size_t bufferSize;
+        std::vector<char> buffer; /** records which haven't been written to the stream yet */
+        std::array<std::optional<double>, 256> lastValues; /** the last value written on every channel */
+};
+
+/**
+ * @brief reads a stream written by #SensorLogWriter
+ *
+ * The whole log is loaded into memory, so values can be looked up at any time in O(log n). Logs of the first version
+ * of the format, which stored the time in 4 bytes, are read too, and their times are unwrapped where they overflowed
+ */
+class SensorLogReader {
+    public:
+        /**
+         * @brief Construct a new Sensor Log Reader object
+         *
+         * @param stream the stream to read from
+         */
+        SensorLogReader(std::istream& stream);
+        /**
+         * @brief Get whether the stream was a valid sensor log
+         *
+         * @return true the stream was valid, possibly ending with a truncated record which was ignored
+         * @return false the stream didn't start with the header of a sensor log, so no samples were read
+         */
+        bool isValid() const;
+        /**
+         * @brief Get every sample recorded on a channel, in the order they were recorded
+         *
+         * @param channel the channel, see sensorChannel()
+         * @return const std::vector<SensorSample>&
+         */
+        const std::vector<SensorSample>& getSamples(uint8_t channel) const;
+        /**
+         * @brief Get the value of a channel at a point in time
+         *
+         * @param channel the channel, see sensorChannel()
+         * @param time the time
+         * @return std::optional<double> the last value recorded at or before the time, or std::nullopt if there is
+         * none
+         */
+        std::optional<double> getValue(uint8_t channel, Time time) const;
+        /**
+         * @brief Get the time of the last record in the log
+         *
+         * @return Time
+         */
+        Time getEndTime() const;
+    private:
+        std::array<std::vector<SensorSample>, 256> channels;
+        bool valid = false;
+        Time endTime = 0_sec;
+};
@@ -19,6 +19,35 @@ class TrackingWheel {
          * @return Length
          */
         Length getDistance();
+        /**
+         * @brief Get the position of the tracking wheel's encoder in ticks
+         *
+         * Odometry should calculate deltas from ticks and convert them with getDistancePerTick(), since the
+         * difference between tick counts is exact no matter how far the wheel has traveled
+         *
+         * @return int64_t
+         */
+        int64_t getTicks();
+        /**
+         * @brief Get the distance the tracking wheel travels per tick of its encoder
+         *
+         * The distance is calculated once and only recalculated if the encoder's tick angle changes
+         *
+         * @return Length
+         */
+        Length getDistancePerTick();
+        /**
+         * @brief Get the linear velocity of the tracking wheel
+         *
+         * @return LinearVelocity
+         */
+        LinearVelocity getVelocity();
+        /**
+         * @brief Get the status of the tracking wheel's encoder
+         *
+         * @return int see #EncoderStatus
+         */
+        int getStatus();
         /**
          * @brief Get the offset of the tracking wheel
          *
@@ -40,4 +69,6 @@ class TrackingWheel {
         const std::shared_ptr<Encoder> encoder;
         const Length radius;
         const Length offset;
+        Angle tickAngle = 0_stRad; /** the tick angle the distance per tick was calculated with */
+        Length distancePerTick = 0_m;
 };
\ No newline at end of file
@@ -0,0 +1,99 @@
+#pragma once
+
+#include "controller/autotune.hpp"
+#include "hardware/motor/motorGroup.hpp"
+#include "motion/motion.hpp"
+#include <memory>
+#include <optional>
+#include <string>
+
+/**
+ * @brief loops of the chassis which can be autotuned
+ *
+ * We use a regular enum instead of an enum class for consistency with #TuningRule
+ */
+enum AutotuneLoop {
+    AUTOTUNE_LINEAR_POSITION = 0, /** distance driven, in meters. Tunes the linear position controller */
+    AUTOTUNE_ANGULAR_POSITION = 1, /** heading, in radians. Tunes the angular position controller */
+    AUTOTUNE_WHEEL_VELOCITY = 2 /** velocity of the wheels, in meters per second. Tunes the velocity controllers */
+};
+
+/**
+ * @brief settings of the autotuner
+ *
+ */
+struct AutotuneSettings {
+        int rule = TUNING_TYREUS_LUYBEN; /** the tuning rule, see #TuningRule */
+        Voltage relayVoltage = 4_volt; /** how far the relay switches the voltage. Larger voltages measure more
+                                          reliably, but move the robot further */
+        double hysteresis = 0; /** smallest hysteresis of the relay, in meters, radians or meters per second */
+        Time noiseTime = 500_ms; /** how long the noise of the loop is measured for with the robot still, before the
+                                    relay starts */
+        double noiseHysteresis = 3; /** the hysteresis is at least this many standard deviations of the noise, so
+                                       noise can't switch the relay */
+        double kS = 0; /** static friction of a side, in volts, from Chassis::characterize(). It's cancelled while a
+                          position loop oscillates, and becomes the kS of the proposed gains */
+        LinearVelocity velocityTarget = 1_mps; /** velocity the wheel velocity loop oscillates around */
+        double rampRate = 6; /** how fast the voltage ramps up to reach the velocity target before the relay
+                                starts, in volts per second */
+        int cycles = 4; /** how many cycles to measure */
+        int warmupCycles = 2; /** how many cycles to discard first */
+        Time timeout = 10_sec; /** the autotuner gives up after this long */
+        std::string resultPath = "/usd/autotune.txt"; /** where the result is written, empty to skip */
+};
+
+/**
+ * @brief open loop motion which puts a loop of the chassis into relay oscillation
+ *
+ * The motion first holds the robot still to measure the noise of the loop, and widens the hysteresis of the relay
+ * above it.
+ * Position loops oscillate around the pose the motion started at, driving straight or turning in place. The wheel
+ * velocity loop drives straight, ramping the voltage up until the wheels reach the velocity target and then
+ * oscillating around it, so it needs room to drive for the whole test. The voltage at the end of the ramp is the
+ * initial bias of the relay, which then corrects it.
+ *
+ * Static friction opposes the motion of a position loop like a second relay, which makes the loop look more stable
+ * than it is once the position controller cancels the friction with kS. So while a position loop oscillates, kS is
+ * added in the direction each side moves.
+ *
+ * The motion stops when the relay has measured every cycle, or when it times out.
+ */
+class AutotuneMotion : public Motion {
+    public:
+        /**
+         * @brief Construct a new Autotune Motion object
+         *
+         * @param loop the loop to oscillate, see #AutotuneLoop
+         * @param leftDrive the left drive, to measure its velocity
+         * @param rightDrive the right drive, to measure its velocity
+         * @param wheelDiameter the diameter of the drive wheels
+         * @param settings the settings of the autotuner
+         * @param result set to the result when every cycle has been measured, and left unset if the motion times out
+         */
+        AutotuneMotion(int loop, std::shared_ptr<MotorGroup> leftDrive, std::shared_ptr<MotorGroup> rightDrive,
+                       Length wheelDiameter, AutotuneSettings settings,
+                       std::shared_ptr<std::optional<RelayResult>> result);
+        /**
+         * @brief update the relay, and calculate the voltage to apply
+         *
+         * @param pose the current pose of the robot
+         * @return ChassisSpeeds the open loop power of each side
+         */
+        ChassisSpeeds update(units::Pose pose) override;
+    private:
+        const int loop;
+        const std::shared_ptr<MotorGroup> leftDrive;
+        const std::shared_ptr<MotorGroup> rightDrive;
+        const Length wheelDiameter;
+        const AutotuneSettings settings;
+        const std::shared_ptr<std::optional<RelayResult>> result;
+        std::optional<RelayFeedback> relay; /** unset until the noise is measured, and the velocity loop reaches its
+                                               target */
+        std::optional<double> hysteresis; /** hysteresis of the relay, unset until the noise is measured */
+        std::optional<Time> rampStart; /** when the velocity loop started ramping up, unset before */
+        double noiseSum = 0; /** sum of the errors measured while the robot is still */
+        double noiseSquares = 0; /** sum of the squares of the errors measured while the robot is still */
+        int noiseSamples = 0; /** number of errors measured while the robot is still */
+        std::optional<Time> startTime; /** when the test started, unset before the first update */
+        std::optional<units::Pose> startPose; /** where the test started, unset before the first update */
+};
@@ -0,0 +1,70 @@
+#pragma once
+
+#include "controller/sysid.hpp"
+#include "hardware/motor/motorGroup.hpp"
+#include "motion/motion.hpp"
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+/**
+ * @brief settings of the drivetrain characterization
+ *
+ */
+struct SysIdSettings {
+        double rampRate = 0.25; /** how fast the voltage ramps up in the quasistatic tests, in volts per second */
+        Voltage maxVoltage = 7_volt; /** voltage the quasistatic tests stop at, and the voltage of the dynamic steps */
+        Time dynamicDuration = 2_sec; /** how long the dynamic steps last */
+        Length maxDistance = 2_m; /** linear tests stop when the robot has driven this far, so it doesn't crash */
+        Time restTime = 1_sec; /** how long the robot rests between tests, so it starts every test stationary */
+        std::string samplesPath = "/usd/sysid_samples.csv"; /** where the samples are written, empty to skip */
+        std::string resultPath = "/usd/sysid.txt"; /** where the result is written, empty to skip */
+};
+
+/**
+ * @brief open loop motion which runs a single characterization test
+ *
+ * Quasistatic tests ramp the voltage slowly, so the robot never accelerates much and kS and kV can be measured.
+ * Dynamic tests apply a voltage step, so the robot accelerates hard and kA can be measured. Linear tests drive
+ * straight, and angular tests turn in place counterclockwise, or clockwise when reversed.
+ *
+ * A sample is recorded every update, with the voltage applied since the previous update.
+ */
+class CharacterizationMotion : public Motion {
+    public:
+        /**
+         * @brief Construct a new Characterization Motion object
+         *
+         * @param test the test to run, see #SysIdTest
+         * @param run the index of the run, recorded in every sample so runs can be told apart
+         * @param reversed whether to drive backwards, or turn clockwise
+         * @param leftDrive the left drive, to measure its velocity
+         * @param rightDrive the right drive, to measure its velocity
+         * @param wheelDiameter the diameter of the drive wheels
+         * @param settings the settings of the characterization
+         * @param samples the samples are appended to this
+         */
+        CharacterizationMotion(int test, int run, bool reversed, std::shared_ptr<MotorGroup> leftDrive,
+                               std::shared_ptr<MotorGroup> rightDrive, Length wheelDiameter, SysIdSettings settings,
+                               std::shared_ptr<std::vector<SysIdSample>> samples);
+        /**
+         * @brief record a sample, and calculate the voltage to apply next
+         *
+         * @param pose the current pose of the robot
+         * @return ChassisSpeeds the open loop power of each side
+         */
+        ChassisSpeeds update(units::Pose pose) override;
+    private:
+        const int test;
+        const int run;
+        const bool reversed;
+        const std::shared_ptr<MotorGroup> leftDrive;
+        const std::shared_ptr<MotorGroup> rightDrive;
+        const Length wheelDiameter;
+        const SysIdSettings settings;
+        const std::shared_ptr<std::vector<SysIdSample>> samples;
+        std::optional<Time> startTime; /** when the test started, unset before the first update */
+        std::optional<units::Pose> startPose; /** where the test started, unset before the first update */
+        Voltage lastVoltage = 0_volt; /** magnitude of the voltage applied on the last update */
+};
@@ -8,6 +8,9 @@
  *
  * @brief represents the left and right velocity of the drivetrain, or the left and right power percentage of the
  * drivetrain
+ *
+ * Velocity targets can come with the acceleration of the target. The velocity controllers use it as feedforward, and
+ * #Chassis uses it to move the target between updates of the motion
  */
 struct ChassisSpeeds {
         bool velocity = false; /** whether the requested response from the drivetrain should use voltage controllers or
@@ -16,6 +19,8 @@ struct ChassisSpeeds {
         LinearVelocity rightVelocity; /** right drive linear velocity */
         double leftPwr; /** left drive percentage */
         double rightPwr; /** right drive percentage */
+        LinearAcceleration leftAcceleration = 0_mps2; /** left drive linear acceleration, with velocity targets */
+        LinearAcceleration rightAcceleration = 0_mps2; /** right drive linear acceleration, with velocity targets */
 };
 
 /**
@@ -0,0 +1,114 @@
+#pragma once
+
+#include "controller/ilc.hpp"
+#include "controller/lqr.hpp"
+#include "controller/qp.hpp"
+#include "hardware/motor/motorGroup.hpp"
+#include "motion/motion.hpp"
+#include "motion/trajectory.hpp"
+#include <memory>
+#include <optional>
+
+/**
+ * @brief number of steps the model predictive controller looks ahead
+ *
+ * The size of the problem it solves every update grows with the cube of this, so it's fixed at compile time
+ */
+constexpr size_t MPC_HORIZON = 10;
+
+/**
+ * @brief settings of #MPCMotion
+ *
+ * The weights follow Bryson's rule: each is the largest acceptable value of its quantity
+ */
+struct MPCSettings {
+        Time step = 30_ms; /** time between the steps of the horizon, so it looks MPC_HORIZON * step ahead */
+        double maxVoltage = 12; /** largest voltage of a side, in volts */
+        LinearAcceleration maxAcceleration = 4_mps2; /** largest acceleration of a side */
+        Length maxAlongTrackError = 2_in; /** weight of the position error along the trajectory */
+        Length maxCrossTrackError = 1_in; /** weight of the position error across the trajectory */
+        Angle maxHeadingError = 5_stDeg; /** weight of the heading error */
+        LinearVelocity maxVelocityError = 0.5_mps; /** weight of the velocity error of a side */
+        double maxVoltageCorrection = 6; /** weight of the correction of the feedforward voltage of a side */
+        QPSettings solver = {}; /** settings of the solver */
+};
+
+/**
+ * @brief model predictive controller which follows a trajectory
+ *
+ * Every update, the controller predicts the error of the robot relative to the trajectory over the horizon, with a
+ * model linearized around the trajectory, and solves a quadratic program for the voltages which minimize it. The
+ * voltages and the accelerations of both sides are constrained over the whole horizon. When the robot can't follow
+ * the trajectory at full speed, it trades off the errors it can correct instead of scaling its outputs after the
+ * fact like Motion::desaturate(). Only the first voltages are applied, and the problem is solved again next update.
+ *
+ * The model of the wheels is driveModel(), from the characterized gains, plus driveFriction() as feedforward, like
+ * #DriveLQR. The solver is warm started from the last solution, and nothing allocates after construction. Use the
+ * benchmark in host/bench/mpcBenchmark.cpp to check the solve time fits in the period of the chassis.
+ *
+ * With a learning controller, the corrections it learned from previous runs of the trajectory are added to the
+ * feedforward, and the errors of this run are recorded so it learns from them when the motion reaches the end. The
+ * motion doesn't save what it learned, since it runs on the chassis task, so call ILC::save() once it's done.
+ *
+ * The heading of the trajectory has to be unbounded like the heading of the odometry, so the error doesn't jump
+ * when either wraps. The motion stops at the end of the trajectory.
+ */
+class MPCMotion : public Motion {
+    public:
+        /**
+         * @brief Construct a new MPC Motion object
+         *
+         * @param trajectory the trajectory to follow. Time 0 is the first update
+         * @param linear feedforward gains of a side driving straight
+         * @param angular feedforward gains of a side turning in place
+         * @param leftDrive the left drive, to measure its velocity
+         * @param rightDrive the right drive, to measure its velocity
+         * @param wheelDiameter the diameter of the drive wheels
+         * @param trackWidth the distance between the left and right wheels
+         * @param settings the settings of the controller
+         * @param learning the learning controller of the trajectory. Defaults to nullptr, for no learning
+         */
+        MPCMotion(Trajectory trajectory, FeedforwardGains linear, FeedforwardGains angular,
+                  std::shared_ptr<MotorGroup> leftDrive, std::shared_ptr<MotorGroup> rightDrive, Length wheelDiameter,
+                  Length trackWidth, MPCSettings settings = {}, std::shared_ptr<ILC> learning = nullptr);
+        /**
+         * @brief solve for the voltages to apply
+         *
+         * @param pose the current pose of the robot
+         * @return ChassisSpeeds the open loop power of each side
+         */
+        ChassisSpeeds update(units::Pose pose) override;
+        /**
+         * @brief Get the statistics of the last solve
+         *
+         * @return QPResult
+         */
+        QPResult getStats() const;
+    private:
+        static constexpr size_t STATES = 5; /** along track, cross track and heading error, and velocity errors */
+        static constexpr size_t VARIABLES = 2 * MPC_HORIZON; /** voltage corrections of both sides every step */
+        static constexpr size_t CONSTRAINTS = 4 * MPC_HORIZON; /** voltages and accelerations of both sides */
+        const Trajectory trajectory;
+        const FeedforwardGains linear;
+        const FeedforwardGains angular;
+        const std::shared_ptr<MotorGroup> leftDrive;
+        const std::shared_ptr<MotorGroup> rightDrive;
+        const Length wheelDiameter;
+        const Length trackWidth;
+        const MPCSettings settings;
+        const std::shared_ptr<ILC> learning;
+        Matrix<2, 2> wheelA; /** discrete model of the wheel velocities over a step */
+        Matrix<2, 2> wheelB;
+        Matrix<2, 2> wheelBInverse;
+        std::optional<Time> startTime; /** when the motion started, unset before the first update */
+        QPResult stats;
+        // the problem is stored here, so it isn't on the stack of the chassis task
+        QPSolver<VARIABLES, CONSTRAINTS> solver;
+        Matrix<VARIABLES, VARIABLES> hessian;
+        Matrix<VARIABLES, 1> gradient;
+        Matrix<CONSTRAINTS, VARIABLES> constraints;
+        Matrix<CONSTRAINTS, 1> lower;
+        Matrix<CONSTRAINTS, 1> upper;
+        Matrix<STATES, VARIABLES> response; /** effect of the corrections on the error at the current step */
+        Matrix<STATES, VARIABLES> lastResponse;
+};
@@ -0,0 +1,50 @@
+#pragma once
+
+#include "motion/motion.hpp"
+#include "motion/trajectory.hpp"
+#include <optional>
+
+/**
+ * @brief settings of #RamseteMotion
+ *
+ */
+struct RamseteSettings {
+        double b = 2; /** aggressiveness of the correction, in radians squared per meter squared. Larger values
+                         correct faster */
+        double zeta = 0.7; /** damping of the correction, from 0 to 1 */
+};
+
+/**
+ * @brief motion which follows a trajectory with the RAMSETE controller
+ *
+ * This is the outer loop of the cascade: it turns the pose error relative to the trajectory into velocity targets of
+ * both sides, with the accelerations of the trajectory as feedforward, and the velocity controllers of #Chassis turn
+ * them into voltages. Unlike #MPCMotion it doesn't need a model of the drivetrain, but it doesn't know the limits of
+ * the motors either, so the trajectory has to respect them.
+ *
+ * The heading of the trajectory has to be unbounded like the heading of the odometry. The motion stops at the end of
+ * the trajectory.
+ */
+class RamseteMotion : public Motion {
+    public:
+        /**
+         * @brief Construct a new Ramsete Motion object
+         *
+         * @param trajectory the trajectory to follow. Time 0 is the first update
+         * @param trackWidth the distance between the left and right wheels
+         * @param settings the settings of the controller
+         */
+        RamseteMotion(Trajectory trajectory, Length trackWidth, RamseteSettings settings = {});
+        /**
+         * @brief calculate the velocity targets
+         *
+         * @param pose the current pose of the robot
+         * @return ChassisSpeeds the velocities and accelerations of both sides
+         */
+        ChassisSpeeds update(units::Pose pose) override;
+    private:
+        const Trajectory trajectory;
+        const Length trackWidth;
+        const RamseteSettings settings;
+        std::optional<Time> startTime; /** when the motion started, unset before the first update */
+};
@@ -0,0 +1,60 @@
+#pragma once
+
+#include "units/Pose.hpp"
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief a point of a trajectory
+ *
+ * The velocities are of the center of the robot, in its own frame
+ */
+struct TrajectoryPoint {
+        Time time; /** time since the start of the trajectory */
+        units::Pose pose; /** pose of the robot, with an unbounded heading */
+        LinearVelocity velocity; /** forwards velocity */
+        AngularVelocity angularVelocity; /** counterclockwise angular velocity */
+};
+
+/**
+ * @brief a reference trajectory, sampled at increasing times
+ *
+ * The trajectory is linearly interpolated between its points, so they should be close enough together for the
+ * robot to drive in straight lines between them
+ */
+class Trajectory {
+    public:
+        /**
+         * @brief Construct a new Trajectory object
+         *
+         * @param points the points, sorted by time. The first point should be at time 0
+         */
+        Trajectory(std::vector<TrajectoryPoint> points);
+        /**
+         * @brief Get the point of the trajectory at a time
+         *
+         * Times before the start or after the end of the trajectory return the first or last point, with its
+         * velocities set to 0 after the end
+         *
+         * @param time time since the start of the trajectory
+         * @return TrajectoryPoint the interpolated point
+         */
+        TrajectoryPoint sample(Time time) const;
+        /**
+         * @brief Get the duration of the trajectory
+         *
+         * @return Time the time of the last point, or 0 if there are no points
+         */
+        Time getDuration() const;
+        /**
+         * @brief Get a hash of the trajectory, to identify it between runs
+         *
+         * The points are rounded to millimeters, milliseconds and milliradians first, so the hash doesn't depend on
+         * floating point noise from generating the same trajectory again
+         *
+         * @return uint32_t the FNV-1a hash of the rounded points
+         */
+        uint32_t hash() const;
+    private:
+        std::vector<TrajectoryPoint> points;
+};
@@ -0,0 +1,139 @@
+#pragma once
+
+#include "odometry/odometry.hpp"
+#include "hardware/gps/gps.hpp"
+#include <memory>
+#include <optional>
+#include <vector>
+
+/**
+ * @brief settings of the GPS fusion filter
+ *
+ */
+struct FusionSettings {
+        Length maxError = 5_cm; /** fixes reporting a larger error are ignored */
+        Time latency = 40_ms; /** how old a fix is when it is read. Fixes are compared to the pose at that time */
+        Time historyLength = 500_ms; /** how long the pose history is. Should be longer than the latency */
+        Time period = 10_ms; /** time between updates. The history holds enough poses for its length at this period,
+                                so updating faster shortens it */
+        Length minNoise = 1_cm; /** the noise of a fix is assumed to be at least this, even if it reports less */
+        Length drift = 1_cm; /** standard deviation of the drift of odometry after traveling 1 meter */
+        Length driftPerSecond = 2_mm; /** standard deviation of the drift of odometry after 1 second, while turning */
+        double gate = 3; /** fixes more than this many standard deviations from the estimate are rejected */
+        int maxRejections = 10; /** after this many consistent fixes in a row are rejected by the gate, the estimate is
+                                   assumed to be wrong instead, and its uncertainty is raised to accept the next fix */
+        Length initialUncertainty = 2_cm; /** standard deviation of the position when the pose is set */
+};
+
+/**
+ * @brief Odometry which fuses absolute GPS fixes with the pose of another odometry
+ *
+ * The wrapped odometry is precise over short distances but drifts, while the GPS doesn't drift but is noisy, slow
+ * and late. This class estimates the offset between the wrapped odometry and the field with a scalar Kalman filter:
+ * - the uncertainty of the offset grows with the distance traveled
+ * - fixes reporting a high error, or too far from the estimate to be plausible, are rejected
+ * - if fixes keep being rejected for being too far but agree with each other, the estimate is assumed to be lost
+ *   and recovers from the GPS
+ * - accepted fixes pull the offset towards them, less the more certain the estimate already is
+ *
+ * Fixes describe where the robot was a moment ago, so each fix is compared to the pose of the wrapped odometry at
+ * the time it was measured, interpolated from a short history. Only the offset is corrected, so the motion since
+ * the fix was measured is kept as the wrapped odometry measured it.
+ *
+ * The heading of the wrapped odometry is used as is, since the IMU is more accurate than the GPS heading
+ */
+class FusedOdom : public Odometry {
+    public:
+        /**
+         * @brief Construct a new Fused Odom object
+         *
+         * @param odometry the odometry to fuse the GPS with
+         * @param gps the GPS
+         * @param settings the settings of the filter
+         */
+        FusedOdom(std::shared_ptr<Odometry> odometry, std::shared_ptr<GPS> gps, FusionSettings settings = {});
+        /**
+         * @brief calibrate the wrapped odometry and the GPS
+         *
+         */
+        void calibrate() override;
+        /**
+         * @brief Update the robot's pose
+         *
+         * @return units::Pose
+         */
+        units::Pose update() override;
+        /**
+         * @brief Set the robot's pose
+         *
+         * @param pose
+         */
+        void setPose(units::Pose pose) override;
+        /**
+         * @brief shift the position of the pose, without changing the heading or resetting any sensors
+         *
+         * @param x the change in x
+         * @param y the change in y
+         */
+        void correctPosition(Length x, Length y) override;
+        /**
+         * @brief Get the standard deviation of the estimated position, on each axis
+         *
+         * @return Length
+         */
+        Length getUncertainty() const;
+        /**
+         * @brief Get how many fixes were rejected since the last calibration
+         *
+         * @return int
+         */
+        int getRejectedFixes() const;
+    private:
+        /**
+         * @brief a pose of the wrapped odometry, and when it was measured
+         *
+         */
+        struct HistoryEntry {
+                Time time;
+                units::Pose pose;
+        };
+
+        /**
+         * @brief Get an entry of the history
+         *
+         * @param index index of the entry, 0 is the oldest
+         * @return const HistoryEntry&
+         */
+        const HistoryEntry& historyAt(size_t index) const;
+        /**
+         * @brief read the GPS, and fuse the fix if it is new and plausible
+         *
+         * @param now the current time
+         */
+        void fuse(Time now);
+        /**
+         * @brief reset the filter, trusting the current pose
+         *
+         */
+        void resetFilter();
+        /**
+         * @brief forget the fixes in a row that were too far from the estimate
+         *
+         */
+        void resetGated();
+        const std::shared_ptr<Odometry> odometry;
+        const std::shared_ptr<GPS> gps;
+        const FusionSettings settings;
+        std::vector<HistoryEntry> history; /** ring buffer of poses of the wrapped odometry, allocated once */
+        size_t historyStart = 0; /** index of the oldest pose in the ring buffer */
+        size_t historySize = 0; /** how many poses are in the ring buffer */
+        Length offsetX = 0_m; /** x offset between the wrapped odometry and the field */
+        Length offsetY = 0_m; /** y offset between the wrapped odometry and the field */
+        Area variance = 0_m2; /** variance of the offset, on each axis */
+        std::optional<units::Pose> lastFix; /** the last fix read, so a fix is only fused once */
+        int rejectedFixes = 0;
+        int gatedInARow = 0; /** how many fixes in a row were too far from the estimate */
+        Length gatedSumX = 0_m; /** sum of the x innovations of the fixes in a row that were too far */
+        Length gatedSumY = 0_m; /** sum of the y innovations of the fixes in a row that were too far */
+        Area gatedSumSquares = 0_m2; /** sum of the squared innovations of the fixes in a row that were too far */
+};
@@ -9,6 +9,15 @@ class Odometry {
         virtual units::Pose update() = 0;
         units::Pose getPose();
         virtual void setPose(units::Pose pose);
+        /**
+         * @brief shift the position of the pose, without changing the heading or resetting any sensors
+         *
+         * This is used to apply small absolute position corrections, for example from distance sensors
+         *
+         * @param x the change in x
+         * @param y the change in y
+         */
+        virtual void correctPosition(Length x, Length y);
         virtual ~Odometry();
     protected:
         units::Pose pose;
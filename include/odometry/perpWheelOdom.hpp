@@ -3,25 +3,54 @@
 #include "odometry/odometry.hpp"
 #include "hardware/trackingWheel.hpp"
 #include "hardware/imu/imu.hpp"
+#include "hardware/healthMonitor.hpp"
+#include <array>
 #include <optional>
+#include <vector>
+
+/**
+ * @brief record of a sensor failing over to a degraded source
+ *
+ */
+struct FailoverEvent {
+        Time time; /** the time the sensor failed */
+        const char* sensor; /** the name of the sensor that failed */
+        int health; /** the health of the sensor when it failed. See #SensorHealth */
+};
 
 /**
  * @brief Odometry implementation using two perpendicular tracking wheels and an IMU
  *
  * This class uses two perpendicular tracking wheels and an IMU to calculate the robot's pose.
+ *
+ * Every sensor is monitored for disconnection, stuck values, and implausible jumps. If a sensor fails, odometry
+ * fails over to a degraded source on the same tick:
+ * - vertical tracking wheel: the drive encoders
+ * - horizontal tracking wheel: assume the robot doesn't move sideways
+ * - IMU: the backup IMU, or the drive encoders if there is no healthy backup IMU
  */
 class PerpWheelOdom : public Odometry {
     public:
         /**
          * @brief Construct a new PerpWheelOdom object
          *
+         * The drive wheels are tracking wheels measuring the drive motor encoders, and their offsets should be the
+         * lateral position of the wheels relative to the tracking center, positive to the left.
+         *
          * @param verticalWheel unique pointer to the vertical tracking wheel
          * @param horizontalWheel unique pointer to the horizontal tracking wheel. Set to nullptr if there is no
          * horizontal tracking wheel
          * @param imu unique pointer to the IMU
+         * @param leftDriveWheel shared pointer to the left drive wheel, used as a reference and fallback. Defaults to
+         * nullptr
+         * @param rightDriveWheel shared pointer to the right drive wheel, used as a reference and fallback. Defaults to
+         * nullptr
+         * @param backupImu shared pointer to a second IMU, used as a reference and fallback. Defaults to nullptr
          */
         PerpWheelOdom(std::shared_ptr<TrackingWheel> verticalWheel, std::shared_ptr<TrackingWheel> horizontalWheel,
-                      std::shared_ptr<IMU> imu);
+                      std::shared_ptr<IMU> imu, std::shared_ptr<TrackingWheel> leftDriveWheel = nullptr,
+                      std::shared_ptr<TrackingWheel> rightDriveWheel = nullptr,
+                      std::shared_ptr<IMU> backupImu = nullptr);
         /**
          * @brief calibrate the tracking wheels and IMU
          *
@@ -36,15 +65,46 @@ class PerpWheelOdom : public Odometry {
         /**
          * @brief Set the robot's pose
          *
+         * The IMU keeps its rotation, and the heading is offset from it from then on
+         *
          * @param pose
          */
         void setPose(units::Pose pose) override;
+        /**
+         * @brief Get the failovers that happened since the last calibration, oldest first
+         *
+         * Only the last 16 are kept, since they're recorded on the chassis task without allocating. This copies them,
+         * so it should be called from another task, like one printing them to the terminal
+         *
+         * @return std::vector<FailoverEvent>
+         */
+        std::vector<FailoverEvent> getFailoverEvents() const;
     private:
+        /**
+         * @brief record a failover event if a sensor just failed
+         *
+         * @param sensor the name of the sensor
+         * @param prevHealth the health of the sensor on the previous tick
+         * @param health the health of the sensor on this tick
+         */
+        void recordFailover(const char* sensor, int prevHealth, int health);
         const std::shared_ptr<TrackingWheel> verticalWheel;
         const std::shared_ptr<TrackingWheel> horizontalWheel;
         const std::shared_ptr<IMU> imu;
-        std::optional<Length> prevVertical;
-        std::optional<Length> prevHorizontal;
+        const std::shared_ptr<TrackingWheel> leftDriveWheel;
+        const std::shared_ptr<TrackingWheel> rightDriveWheel;
+        const std::shared_ptr<IMU> backupImu;
+        std::optional<int64_t> prevVertical; /** previous position of the vertical wheel, in ticks */
+        std::optional<int64_t> prevHorizontal; /** previous position of the horizontal wheel, in ticks */
         std::optional<Angle> prevAngle;
-        units::Pose pose;
-};
\ No newline at end of file
+        std::optional<int64_t> prevLeftDrive; /** previous position of the left drive wheel, in ticks */
+        std::optional<int64_t> prevRightDrive; /** previous position of the right drive wheel, in ticks */
+        std::optional<Angle> prevBackupAngle;
+        Angle headingOffset = 0_stRad; /** the heading minus the rotation measured by the IMU */
+        HealthMonitor<Length> verticalMonitor {10_cm, 5_cm, 5_mm, 10};
+        HealthMonitor<Length> horizontalMonitor {10_cm, 5_cm, 5_mm, 10};
+        HealthMonitor<Angle> imuMonitor {20_stDeg, 5_stDeg, 1_stDeg, 10};
+        HealthMonitor<Angle> backupImuMonitor {20_stDeg, 5_stDeg, 1_stDeg, 10};
+        std::array<FailoverEvent, 16> failoverEvents = {}; /** ring buffer of failovers, oldest overwritten */
+        size_t failoverCount = 0; /** failovers recorded since the last calibration */
+};
@@ -0,0 +1,92 @@
+#pragma once
+
+#include "hardware/trackingWheel.hpp"
+#include "hardware/imu/imu.hpp"
+#include <memory>
+#include <optional>
+
+/**
+ * @brief enum to represent the traction state of the drivetrain
+ *
+ * We use a regular enum instead of an enum class for consistency with #EncoderStatus and #IMUStatus
+ */
+enum TractionState {
+    TRACTION_OK = 0, /** the drive wheels are moving the robot as expected */
+    TRACTION_SLIP = 1, /** the drive wheels are moving faster than the robot, e.g when accelerating too hard */
+    TRACTION_PUSHING = 2, /** the robot is in a pushing contest, or is being pushed */
+    TRACTION_STALLED = 3 /** the drive is powered, but neither the wheels nor the robot are moving */
+};
+
+/**
+ * @brief per-tick output of the slip detector
+ *
+ */
+struct TractionSignal {
+        int state = TRACTION_OK; /** the traction state, see #TractionState */
+        double slipRatio = 0; /** 0 if the wheels have full traction, 1 if the wheels are spinning freely */
+        bool poseUncertain = false; /** whether the pose may be inaccurate because of the contact causing the slip */
+};
+
+/**
+ * @brief Wheel slip and traction loss detector
+ *
+ * Compares the displacement of the drive motors with the displacement of the tracking wheel and the rotation
+ * measured by the IMU every tick to classify slip, pushing contests, and stalls. Readings are low pass filtered
+ * and a state has to persist for a few ticks before it's reported, so a single noisy tick doesn't cut power.
+ */
+class SlipDetector {
+    public:
+        /**
+         * @brief Construct a new Slip Detector object
+         *
+         * @param verticalWheel shared pointer to the vertical tracking wheel
+         * @param imu shared pointer to the IMU
+         * @param trackWidth the distance between the left and right wheels
+         * @param effortThreshold the minimum commanded effort (0 to 1) for the drive to be considered powered.
+         * Defaults to 0.3
+         * @param slipThreshold the minimum slip ratio for the wheels to be considered slipping. Defaults to 0.25
+         */
+        SlipDetector(std::shared_ptr<TrackingWheel> verticalWheel, std::shared_ptr<IMU> imu, Length trackWidth,
+                     double effortThreshold = 0.3, double slipThreshold = 0.25);
+        /**
+         * @brief update the detector
+         *
+         * This should be called once per tick, which the chassis does when it owns the detector
+         *
+         * @param leftDistance the distance traveled by the left drive wheels, measured by the motor encoders
+         * @param rightDistance the distance traveled by the right drive wheels, measured by the motor encoders
+         * @param leftEffort the effort commanded to the left drive, from -1 to 1
+         * @param rightEffort the effort commanded to the right drive, from -1 to 1
+         * @return TractionSignal
+         */
+        TractionSignal update(Length leftDistance, Length rightDistance, double leftEffort, double rightEffort);
+        /**
+         * @brief Get the traction signal calculated on the last update
+         *
+         * @return TractionSignal
+         */
+        TractionSignal getSignal() const;
+        /**
+         * @brief reset the detector
+         *
+         * This should be called whenever the drive encoders or the tracking wheel are reset
+         */
+        void reset();
+    private:
+        const std::shared_ptr<TrackingWheel> verticalWheel;
+        const std::shared_ptr<IMU> imu;
+        const Length trackWidth;
+        const double effortThreshold;
+        const double slipThreshold;
+        std::optional<Length> prevLeft;
+        std::optional<Length> prevRight;
+        std::optional<int64_t> prevTracking; /** previous position of the tracking wheel, in ticks */
+        std::optional<Angle> prevAngle;
+        Length driveDelta = 0_m; /** filtered forward displacement of the drive per tick */
+        Length trackingDelta = 0_m; /** filtered forward displacement of the tracking center per tick */
+        Angle driveAngleDelta = 0_stRad; /** filtered rotation of the drive per tick */
+        Angle imuAngleDelta = 0_stRad; /** filtered rotation measured by the IMU per tick */
+        int candidateState = TRACTION_OK; /** the state detected on the last tick, not yet debounced */
+        int candidateTicks = 0; /** how many consecutive ticks the candidate state has been detected */
+        TractionSignal signal;
+};
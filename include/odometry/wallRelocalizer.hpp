@@ -0,0 +1,96 @@
+#pragma once
+
+#include "hardware/distance/distanceSensor.hpp"
+#include "odometry/odometry.hpp"
+#include <memory>
+#include <vector>
+
+/**
+ * @brief enum to represent the axis a wall is perpendicular to
+ *
+ * We use a regular enum instead of an enum class for consistency with #EncoderStatus and #IMUStatus
+ */
+enum WallAxis {
+    WALL_X = 0, /** the wall is on the line x = position */
+    WALL_Y = 1 /** the wall is on the line y = position */
+};
+
+/**
+ * @brief a straight wall of the field, which distance sensors can measure the position of the robot from
+ *
+ */
+struct Wall {
+        int axis; /** the axis the wall is perpendicular to, see #WallAxis */
+        Length position; /** the position of the wall along its axis */
+};
+
+/**
+ * @brief a distance sensor mounted on the robot
+ *
+ */
+struct MountedDistanceSensor {
+        std::shared_ptr<DistanceSensor> sensor;
+        Length x; /** offset of the sensor to the right of the tracking center */
+        Length y; /** offset of the sensor forwards from the tracking center */
+        Angle angle; /** direction of the beam, relative to the front of the robot. Counterclockwise is positive */
+};
+
+/**
+ * @brief settings of the wall relocalizer
+ *
+ */
+struct RelocalizerSettings {
+        int minConfidence = 40; /** minimum confidence of a distance reading, from 0 to 63 */
+        Length maxRange = 1.2_m; /** maximum distance reading. The sensor's error grows with distance */
+        Angle maxIncidence = 10_stDeg; /** maximum angle between the beam and the normal of the wall */
+        Length maxError = 4_in; /** maximum difference between the reading and the distance odometry expects. Larger
+                                   differences are likely other robots or field elements in front of the wall */
+        double blendGain = 0.2; /** fraction of the remaining correction applied every tick */
+        Length maxStep = 5_mm; /** maximum correction applied in a single tick, on each axis */
+};
+
+/**
+ * @brief corrects odometry drift with distance sensors pointed at the field walls
+ *
+ * Every tick, each sensor that is roughly square to a wall and reads close to the distance odometry expects gives
+ * an absolute measurement of the x or y coordinate of the robot. The difference between the measured and the
+ * odometry coordinate is blended into the pose over several ticks, so a correction never makes the pose jump and
+ * spike the position controllers.
+ *
+ * The pose has to be in the same frame as the walls, so the starting pose should be set in field coordinates.
+ */
+class WallRelocalizer {
+    public:
+        /**
+         * @brief Construct a new Wall Relocalizer object
+         *
+         * @param odometry the odometry to correct
+         * @param sensors the distance sensors on the robot
+         * @param walls the walls of the field. Defaults to a 12 ft field centered on the origin
+         * @param settings the settings of the relocalizer
+         */
+        WallRelocalizer(std::shared_ptr<Odometry> odometry, std::vector<MountedDistanceSensor> sensors,
+                        std::vector<Wall> walls = {{WALL_X, -72_in}, {WALL_X, 72_in}, {WALL_Y, -72_in},
+                                                   {WALL_Y, 72_in}},
+                        RelocalizerSettings settings = {});
+        /**
+         * @brief measure the position of the robot, and apply part of the correction
+         *
+         * This should be called once per tick after odometry is updated, which the chassis does when it owns the
+         * relocalizer
+         */
+        void update();
+        /**
+         * @brief discard any correction which hasn't been applied yet
+         *
+         * This should be called whenever the pose is set
+         */
+        void reset();
+    private:
+        const std::shared_ptr<Odometry> odometry;
+        const std::vector<MountedDistanceSensor> sensors;
+        const std::vector<Wall> walls;
+        const RelocalizerSettings settings;
+        Length pendingX = 0_m; /** correction of the x coordinate which hasn't been applied yet */
+        Length pendingY = 0_m; /** correction of the y coordinate which hasn't been applied yet */
+};
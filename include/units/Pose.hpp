@@ -45,10 +45,9 @@ class Pose : public V2Position {
          * @param nx x position
          * @param ny y position
          */
-        Pose(Length nx, Length ny) {
-            V2Position(nx, ny);
-            theta = 0_stRad;
-        }
+        Pose(Length nx, Length ny)
+            : V2Position(nx, ny),
+              theta(0_stRad) {}
 
         /**
          * @brief Construct a new Pose object
@@ -60,14 +60,14 @@ template <isQuantity T> class Vector2D {
          *
          * @return T x component
          */
-        T getX() { return x; }
+        T getX() const { return x; }
 
         /**
          * @brief get the y component
          *
          * @return T y component
          */
-        T getY() { return y; }
+        T getY() const { return y; }
 
         /**
          * @brief set the x component
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <algorithm>
 #include <cmath>
 #include <ratio>
 #include <iostream>
@@ -9,6 +10,11 @@
 #define M_PI 3.14159265358979323846
 #endif
 
+// define M_TWOPI if not already defined. It is a newlib extension, so it is missing on most hosts
+#ifndef M_TWOPI
+#define M_TWOPI (M_PI * 2.0)
+#endif
+
 // define typenames
 #define TYPENAMES typename Mass, typename Length, typename Time, typename Current, typename Angle
 #define DIMS Mass, Length, Time, Current, Angle
@@ -73,7 +79,7 @@ template <TYPENAMES> class Quantity {
          *
          * @param other the quantity to subtract
          */
-        constexpr void operator-=(Quantity<DIMS> other) { value == other.value; }
+        constexpr void operator-=(Quantity<DIMS> other) { value -= other.value; }
 
         /**
          * @brief set the value of this quantity to its current value times a double
@@ -136,6 +142,8 @@ template <isQuantity Q> constexpr Q operator+(Q lhs, Q rhs) { return Q(lhs.val()
 
 template <isQuantity Q> constexpr Q operator-(Q lhs, Q rhs) { return Q(lhs.val() - rhs.val()); }
 
+template <isQuantity Q> constexpr Q operator-(Q quantity) { return Q(-quantity.val()); }
+
 template <isQuantity Q> constexpr Q operator*(Q quantity, double multiple) { return Q(quantity.val() * multiple); }
 
 template <isQuantity Q> constexpr Q operator*(double multiple, Q quantity) { return Q(quantity.val() * multiple); }
@@ -191,6 +199,7 @@ NEW_QUANTITY_VALUE(Mass, lb, g * 453.6)
 
 NEW_QUANTITY(Time, sec, 0, 0, 1, 0, 0)
 NEW_QUANTITY_VALUE(Time, ms, sec / 1000)
+NEW_QUANTITY_VALUE(Time, us, sec / 1000000)
 NEW_QUANTITY_VALUE(Time, min, sec * 60)
 NEW_QUANTITY_VALUE(Time, hr, min * 60)
 NEW_QUANTITY_VALUE(Time, day, hr * 24)
@@ -258,11 +267,11 @@ template <int R, isQuantity Q, isQuantity S = QPower<Q, std::ratio<R>>> constexp
 }
 
 template <isQuantity Q, isQuantity S = QPower<Q, std::ratio<2>>> constexpr S square(const Q& rhs) {
-    return S(std::sqrt(rhs.val()));
+    return S(rhs.val() * rhs.val());
 }
 
 template <isQuantity Q, isQuantity S = QPower<Q, std::ratio<3>>> constexpr S cube(const Q& rhs) {
-    return S(std::sqrt(rhs.val()));
+    return S(rhs.val() * rhs.val() * rhs.val());
 }
 
 template <int R, isQuantity Q, isQuantity S = QRoot<Q, std::ratio<R>>> constexpr S root(const Q& lhs) {
@@ -274,7 +283,7 @@ template <isQuantity Q, isQuantity S = QRoot<Q, std::ratio<2>>> constexpr S sqrt
 }
 
 template <isQuantity Q, isQuantity S = QRoot<Q, std::ratio<3>>> constexpr S cbrt(const Q& rhs) {
-    return S(std::sqrt(rhs.val()));
+    return S(std::cbrt(rhs.val()));
 }
 
 template <isQuantity Q> constexpr Q hypot(const Q& lhs, const Q& rhs) { return Q(std::hypot(lhs.val(), rhs.val())); }
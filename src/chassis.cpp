@@ -1,100 +1,218 @@
 #include "chassis.hpp"
+#include "hardware/sensorCache.hpp"
 #include "pros/misc.h"
 #include "pros/misc.hpp"
+#include <algorithm>
+#include <fstream>
 
-double avg(std::vector<double> vec) {
-    if (vec.empty()) return 0;
-    double sum = 0;
-    for (const double& val : vec) sum += val;
-    return sum / vec.size();
-}
-
-Chassis::Chassis(const std::shared_ptr<pros::MotorGroup> leftDrive, const std::shared_ptr<pros::MotorGroup> rightDrive,
-                 const std::shared_ptr<Odometry> odometry, const Length trackWidth,
+Chassis::Chassis(const std::shared_ptr<MotorGroup> leftDrive, const std::shared_ptr<MotorGroup> rightDrive,
+                 const std::shared_ptr<Odometry> odometry, const Length trackWidth, const Length wheelDiameter,
                  const std::shared_ptr<Controller<VelocityControllerInput, double>> leftVelocityController,
                  const std::shared_ptr<Controller<VelocityControllerInput, double>> rightVelocityController,
-                 const std::shared_ptr<Controller<double, double>> linearPositionController,
-                 const std::shared_ptr<Controller<double, double>> angularPositionController)
-    : leftDrive(leftDrive),
+                 const std::shared_ptr<Controller<PositionControllerInput, double>> linearPositionController,
+                 const std::shared_ptr<Controller<PositionControllerInput, double>> angularPositionController,
+                 const ChassisOptions options)
+    : trackWidth(trackWidth),
+      wheelDiameter(wheelDiameter),
+      leftDrive(leftDrive),
       rightDrive(rightDrive),
       odometry(odometry),
-      trackWidth(trackWidth),
       leftVelocityController(leftVelocityController),
       rightVelocityController(rightVelocityController),
       linearPositionController(linearPositionController),
-      angularPositionController(angularPositionController) {}
+      angularPositionController(angularPositionController),
+      slipDetector(options.slipDetector),
+      powerBudget(options.powerBudget),
+      relocalizer(options.relocalizer),
+      driveVelocityController(options.driveVelocityController),
+      rates(options.rates),
+      disturbanceObserver(options.disturbanceObserver),
+      motionDivider(std::max(1, int(std::lround(to_sec(rates.motionPeriod) / to_sec(rates.velocityPeriod))))) {}
 
 void Chassis::initialize() {
     odometry->calibrate(); // calibrate odometry
-    // reset the velocity controllers
-    leftVelocityController->reset();
-    rightVelocityController->reset();
+    if (slipDetector != nullptr) slipDetector->reset();
+    if (relocalizer != nullptr) relocalizer->reset();
+    if (disturbanceObserver != nullptr) disturbanceObserver->reset();
+    // reset the velocity controllers. Controllers can be unset until they're tuned
+    if (leftVelocityController != nullptr) leftVelocityController->reset();
+    if (rightVelocityController != nullptr) rightVelocityController->reset();
+    if (driveVelocityController != nullptr) driveVelocityController->reset();
     // start the chassis task, but only if it hasn't been started yet
     if (task == std::nullopt)
         task = pros::Task {[this]() {
+            // wait until a period after the last wake up, so the time update() takes doesn't stretch the period
+            uint32_t wakeTime = pros::millis();
             while (true) {
                 this->update();
-                pros::delay(10);
+                pros::Task::delay_until(&wakeTime, to_ms(rates.velocityPeriod));
             }
         }};
 }
 
 void Chassis::move(std::unique_ptr<Motion> motion) {
     // wait for the previous motion to finish
-    while (motion != nullptr) pros::delay(10);
-    // reset position controllers
-    linearPositionController->reset();
-    angularPositionController->reset();
+    while (this->motion != nullptr) pros::delay(10);
+    // reset position controllers. Open loop motions run without them
+    if (linearPositionController != nullptr) linearPositionController->reset();
+    if (angularPositionController != nullptr) angularPositionController->reset();
     // reset velocity controllers
-    leftVelocityController->reset();
-    rightVelocityController->reset();
+    if (leftVelocityController != nullptr) leftVelocityController->reset();
+    if (rightVelocityController != nullptr) rightVelocityController->reset();
+    if (driveVelocityController != nullptr) driveVelocityController->reset();
+    // update the motion on the next update
+    ticks = 0;
     // set the competition state at the start of the motion
     prevCompState = pros::c::competition_get_status();
     // set the new motion
     this->motion = std::move(motion);
 }
 
+SysIdResult Chassis::characterize(SysIdSettings settings) {
+    auto samples = std::make_shared<std::vector<SysIdSample>>();
+    // each test runs in both directions, so the robot ends up roughly where it started. Every direction is a separate
+    // run, so accelerations aren't differenced across the rest between them
+    int run = 0;
+    for (int test :
+         {SYSID_QUASISTATIC_LINEAR, SYSID_DYNAMIC_LINEAR, SYSID_QUASISTATIC_ANGULAR, SYSID_DYNAMIC_ANGULAR}) {
+        for (bool reversed : {false, true}) {
+            move(std::make_unique<CharacterizationMotion>(test, run++, reversed, leftDrive, rightDrive,
+                                                          wheelDiameter, settings, samples));
+            while (motion != nullptr) pros::delay(10);
+            pros::delay(to_ms(settings.restTime));
+        }
+    }
+    computeAccelerations(*samples);
+    const SysIdResult result = fitSysId(*samples);
+    if (!settings.samplesPath.empty()) {
+        std::ofstream file(settings.samplesPath);
+        writeSysIdSamples(file, *samples);
+    }
+    if (!settings.resultPath.empty()) {
+        std::ofstream file(settings.resultPath);
+        writeSysIdResult(file, result);
+    }
+    return result;
+}
+
+std::optional<AutotuneResult> Chassis::autotune(int loop, AutotuneSettings settings) {
+    auto relayResult = std::make_shared<std::optional<RelayResult>>();
+    move(std::make_unique<AutotuneMotion>(loop, leftDrive, rightDrive, wheelDiameter, settings, relayResult));
+    while (motion != nullptr) pros::delay(10);
+    if (*relayResult == std::nullopt) return std::nullopt;
+    AutotuneResult result = {**relayResult, proposeGains(**relayResult, settings.rule)};
+    // the relay oscillated with the friction of a position loop cancelled, so the controller has to cancel it too
+    if (loop != AUTOTUNE_WHEEL_VELOCITY) result.gains.kS = settings.kS;
+    if (!settings.resultPath.empty()) {
+        std::ofstream file(settings.resultPath);
+        writeAutotuneResult(file, result);
+    }
+    return result;
+}
+
 void Chassis::stopMotion() {
     motion.reset(); // delete the motion
     moveMotors(0, 0); // stop the motors
 }
 
-void Chassis::moveMotors(int left, int right) {
-    leftDrive->move(left);
-    rightDrive->move(right);
+void Chassis::moveMotors(int left, int right) { moveVoltage(left * 12_volt / 127, right * 12_volt / 127); }
+
+void Chassis::moveVoltage(Voltage left, Voltage right) {
+    leftDrive->moveVoltage(left);
+    rightDrive->moveVoltage(right);
+    leftEffort = std::clamp(to_volt(left) / 12, -1.0, 1.0);
+    rightEffort = std::clamp(to_volt(right) / 12, -1.0, 1.0);
+}
+
+void Chassis::moveMotors(std::pair<int, int> powers) { moveMotors(powers.first, powers.second); }
+
+TractionSignal Chassis::getTraction() {
+    if (slipDetector == nullptr) return {};
+    return slipDetector->getSignal();
+}
+
+double Chassis::getPowerBudget() {
+    if (powerBudget == nullptr) return 1;
+    return powerBudget->getBudget();
 }
 
-void Chassis::moveMotors(std::pair<int, int> powers) {
-    leftDrive->move(powers.first);
-    rightDrive->move(powers.second);
+DisturbanceSignal Chassis::getDisturbance() {
+    if (disturbanceObserver == nullptr) return {};
+    return disturbanceObserver->getSignal();
 }
 
 units::Pose Chassis::getPose() { return odometry->getPose(); }
 
-void Chassis::setPose(units::Pose pose) { odometry->setPose(pose); }
+void Chassis::setPose(units::Pose pose) {
+    odometry->setPose(pose);
+    if (relocalizer != nullptr) relocalizer->reset(); // corrections measured before the pose was set are stale
+}
 
 void Chassis::update() {
-    // update odometry
-    const units::Pose pose = odometry->update();
-    // update motion
-    if (motion != nullptr) {
+    // start a new tick, so sensors are only read once per update
+    SensorCache::invalidate();
+    // the velocity controllers take linear velocities in meters per second, and output volts
+    const LinearVelocity leftVelocity = to_radps(leftDrive->getVelocity()) * wheelDiameter / 2 / sec;
+    const LinearVelocity rightVelocity = to_radps(rightDrive->getVelocity()) * wheelDiameter / 2 / sec;
+    // estimate the external force from the voltages commanded since the last update
+    if (disturbanceObserver != nullptr)
+        disturbanceObserver->update(to_mps(leftVelocity), to_mps(rightVelocity), leftEffort * 12, rightEffort * 12);
+    // the outer loop: odometry and the motion
+    if (ticks++ % motionDivider == 0) {
+        // update odometry
+        units::Pose pose = odometry->update();
+        // correct drift with the distance sensors
+        if (relocalizer != nullptr) {
+            relocalizer->update();
+            pose = odometry->getPose();
+        }
+        // update slip detection
+        if (slipDetector != nullptr)
+            slipDetector->update(to_sRad(leftDrive->getPosition()) * wheelDiameter / 2,
+                                 to_sRad(rightDrive->getPosition()) * wheelDiameter / 2, leftEffort, rightEffort);
+        // update the power budget. Its period starts when the robot is enabled, like at the start of a skills run
+        const bool enabled = !(pros::competition::get_status() & COMPETITION_DISABLED);
+        if (powerBudget != nullptr && enabled && !wasEnabled) powerBudget->start();
+        wasEnabled = enabled;
+        if (powerBudget != nullptr) powerBudget->update();
+        // update motion
+        if (motion == nullptr) return;
         // stop the motion if needed
         if (!motion->isRunning() || pros::competition::get_status() != prevCompState) {
             stopMotion();
             return;
         }
-        const ChassisSpeeds speeds = motion->update(pose);
-        // update velocity controllers if needed, reset otherwise and use open loop control
-        if (speeds.velocity) {
-            const double leftOut =
-                leftVelocityController->update({speeds.leftVelocity.val(), avg(leftDrive->get_actual_velocity_all())});
-            const double rightOut = rightVelocityController->update(
-                {speeds.rightVelocity.val(), avg(rightDrive->get_actual_velocity_all())});
-            leftDrive->move(leftOut);
-            rightDrive->move(rightOut);
-        } else {
-            leftDrive->move(speeds.leftPwr * 127);
-            rightDrive->move(speeds.rightPwr * 127);
-        }
+        speeds = motion->update(pose);
+        speedsTime = Timer::now();
+        // open loop outputs are held until the next update of the motion
+        if (!speeds.velocity) moveVoltage(speeds.leftPwr * 12_volt, speeds.rightPwr * 12_volt);
     }
-}
\ No newline at end of file
+    // the inner loop: the velocity controllers
+    if (motion == nullptr || !speeds.velocity) return;
+    // velocity targets can't be followed without velocity controllers
+    const bool sideControllers = leftVelocityController != nullptr && rightVelocityController != nullptr;
+    if (driveVelocityController == nullptr && !sideControllers) {
+        stopMotion();
+        return;
+    }
+    // move the targets along their acceleration since the motion was updated
+    const Time elapsed = std::clamp(Timer::now() - speedsTime, 0_sec, rates.motionPeriod);
+    const LinearVelocity leftTarget = speeds.leftVelocity + speeds.leftAcceleration * elapsed;
+    const LinearVelocity rightTarget = speeds.rightVelocity + speeds.rightAcceleration * elapsed;
+    // cancel the estimated external force
+    const DriveVoltages compensation =
+        disturbanceObserver != nullptr ? disturbanceObserver->getCompensation() : DriveVoltages {0, 0};
+    if (driveVelocityController != nullptr) {
+        // both sides are controlled together, so the coupling between them is accounted for
+        const DriveVoltages out = driveVelocityController->update(
+            {to_mps2(speeds.leftAcceleration), to_mps2(speeds.rightAcceleration), to_mps(leftTarget),
+             to_mps(rightTarget), to_mps(leftVelocity), to_mps(rightVelocity)});
+        moveVoltage(from_volt(out.left + compensation.left), from_volt(out.right + compensation.right));
+    } else {
+        const double leftOut = leftVelocityController->update(
+            {to_mps2(speeds.leftAcceleration), to_mps(leftTarget), to_mps(leftVelocity)});
+        const double rightOut = rightVelocityController->update(
+            {to_mps2(speeds.rightAcceleration), to_mps(rightTarget), to_mps(rightVelocity)});
+        moveVoltage(from_volt(leftOut + compensation.left), from_volt(rightOut + compensation.right));
+    }
+}
@@ -0,0 +1,133 @@
+#include "controller/autotune.hpp"
+#include <algorithm>
+#include <cmath>
+
+RelayFeedback::RelayFeedback(double amplitude, double hysteresis, int cycles, int warmupCycles, double bias)
+    : amplitude(amplitude),
+      hysteresis(hysteresis),
+      cycles(cycles),
+      warmupCycles(warmupCycles),
+      initialBias(bias),
+      bias(bias) {}
+
+// the peak of the parabola through three evenly spaced samples, or the middle sample if it isn't the extreme one
+static double interpolatePeak(double before, double middle, double after) {
+    const double curvature = before - 2 * middle + after;
+    if (curvature == 0) return middle;
+    const double offset = (before - after) / (2 * curvature);
+    if (std::abs(offset) > 1) return middle;
+    return middle - (before - after) * offset / 4;
+}
+
+double RelayFeedback::update(double error, Time time) {
+    maxError = std::max(maxError, error);
+    minError = std::min(minError, error);
+    // the peak of the error is usually between samples, so interpolate it once the sample after it arrives
+    if (prevError && prevPrevError) {
+        if (*prevError >= *prevPrevError && *prevError >= error && *prevError >= maxError)
+            maxError = std::max(maxError, interpolatePeak(*prevPrevError, *prevError, error));
+        if (*prevError <= *prevPrevError && *prevError <= error && *prevError <= minError)
+            minError = std::min(minError, interpolatePeak(*prevPrevError, *prevError, error));
+    }
+    prevPrevError = prevError;
+    prevError = error;
+    // start on the side that moves the error towards 0
+    if (high == std::nullopt) high = error >= 0;
+    if (!*high && error > hysteresis) {
+        high = true;
+        if (lastRise != std::nullopt) {
+            // a full cycle has finished. Correct the bias by how much longer the output was high than low, which
+            // makes the oscillation symmetric
+            const Time period = time - *lastRise;
+            const Time highTime = lastFall - *lastRise;
+            bias += amplitude * to_sec(highTime - (period - highTime)) / to_sec(period);
+            if (++completedCycles > warmupCycles && !isDone()) {
+                periods.push_back(period);
+                amplitudes.push_back((maxError - minError) / 2);
+            }
+        }
+        lastRise = time;
+        maxError = error;
+        minError = error;
+    } else if (*high && error < -hysteresis) {
+        high = false;
+        lastFall = time;
+    }
+    return *high ? bias + amplitude : bias - amplitude;
+}
+
+bool RelayFeedback::isDone() const { return periods.size() >= size_t(cycles); }
+
+std::optional<RelayResult> RelayFeedback::getResult() const {
+    if (periods.empty()) return std::nullopt;
+    Time sum = 0_sec;
+    for (Time period : periods) sum += period;
+    double amplitudeSum = 0;
+    for (double a : amplitudes) amplitudeSum += a;
+    RelayResult result;
+    result.ultimatePeriod = sum / periods.size();
+    result.amplitude = amplitudeSum / amplitudes.size();
+    // the describing function of a relay with hysteresis. The amplitude is always wider than the hysteresis, since
+    // the relay only switches outside of it
+    const double effective = std::sqrt(std::max(result.amplitude * result.amplitude - hysteresis * hysteresis, 1e-12));
+    result.ultimateGain = 4 * amplitude / (M_PI * effective);
+    result.bias = bias;
+    const auto [shortest, longest] = std::minmax_element(periods.begin(), periods.end());
+    result.periodSpread = to_sec(*longest - *shortest) / to_sec(result.ultimatePeriod);
+    result.cycles = periods.size();
+    return result;
+}
+
+void RelayFeedback::reset() {
+    bias = initialBias;
+    high = std::nullopt;
+    lastRise = std::nullopt;
+    lastFall = 0_sec;
+    maxError = -INFINITY;
+    minError = INFINITY;
+    prevError = std::nullopt;
+    prevPrevError = std::nullopt;
+    completedCycles = 0;
+    periods.clear();
+    amplitudes.clear();
+}
+
+PIDGains proposeGains(const RelayResult& result, int rule) {
+    // proportional gain, integral time and derivative time as fractions of the ultimate gain and period
+    double kP;
+    double integralTime;
+    double derivativeTime;
+    switch (rule) {
+        case TUNING_TYREUS_LUYBEN:
+            kP = result.ultimateGain / 2.2;
+            integralTime = 2.2;
+            derivativeTime = 1 / 6.3;
+            break;
+        case TUNING_CONSERVATIVE:
+            kP = 0.2 * result.ultimateGain;
+            integralTime = 0.5;
+            derivativeTime = 1.0 / 3;
+            break;
+        default:
+            kP = 0.6 * result.ultimateGain;
+            integralTime = 0.5;
+            derivativeTime = 0.125;
+            break;
+    }
+    const double period = to_sec(result.ultimatePeriod);
+    if (period <= 0) return {kP, 0, 0, 0};
+    return {kP, kP / (integralTime * period), kP * derivativeTime * period, 0};
+}
+
+void writeAutotuneResult(std::ostream& stream, const AutotuneResult& result) {
+    stream << "ultimateGain " << result.relay.ultimateGain << '\n'
+           << "ultimatePeriod " << to_sec(result.relay.ultimatePeriod) << '\n'
+           << "amplitude " << result.relay.amplitude << '\n'
+           << "bias " << result.relay.bias << '\n'
+           << "periodSpread " << result.relay.periodSpread << '\n'
+           << "cycles " << result.relay.cycles << '\n'
+           << "kP " << result.gains.kP << '\n'
+           << "kI " << result.gains.kI << '\n'
+           << "kD " << result.gains.kD << '\n'
+           << "kS " << result.gains.kS << '\n';
+}
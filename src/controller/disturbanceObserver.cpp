@@ -0,0 +1,76 @@
+#include "controller/disturbanceObserver.hpp"
+#include <algorithm>
+#include <cmath>
+#include <tuple>
+
+DisturbanceObserver::DisturbanceObserver(FeedforwardGains linear, FeedforwardGains angular,
+                                         DisturbanceSettings settings, Time period)
+    : linear(linear),
+      settings(settings),
+      filterGain(1 - std::exp(-to_sec(period) / std::max(to_sec(settings.timeConstant), 1e-6))),
+      delayTicks(std::clamp(int(std::lround(to_sec(settings.delay) / to_sec(period))), 0, int(voltages.size()) - 1)),
+      pushTicks(std::max(1, int(std::lround(to_sec(settings.pushTime) / to_sec(period))))) {
+    if (linear.kA <= 0 || angular.kA <= 0) return;
+    const auto [a, b] = driveModel(linear, angular);
+    std::tie(discreteA, discreteB) = discretize(a, b, period);
+    inverseB = inverse(discreteB).value_or(Matrix<2, 2> {});
+}
+
+// the observer models a symmetric drivetrain, so the linear gains are the average of both sides
+static FeedforwardGains averageSides(const SysIdResult& result) {
+    return {(result.left.kS + result.right.kS) / 2, (result.left.kV + result.right.kV) / 2,
+            (result.left.kA + result.right.kA) / 2, (result.left.rSquared + result.right.rSquared) / 2};
+}
+
+DisturbanceObserver::DisturbanceObserver(const SysIdResult& result, DisturbanceSettings settings, Time period)
+    : DisturbanceObserver(averageSides(result), result.angular, settings, period) {}
+
+DisturbanceSignal DisturbanceObserver::update(double leftVelocity, double rightVelocity, double leftVoltage,
+                                              double rightVoltage) {
+    voltages[updates++ % voltages.size()] = {leftVoltage, rightVoltage};
+    if (prevVelocity == std::nullopt || updates <= delayTicks) {
+        prevVelocity = {leftVelocity, rightVelocity};
+        return signal;
+    }
+    const auto [prevLeft, prevRight] = *prevVelocity;
+    prevVelocity = {leftVelocity, rightVelocity};
+    // the voltage the motors applied since the last update was commanded a delay earlier
+    const DriveVoltages& applied = voltages[(updates - 1 - delayTicks) % voltages.size()];
+    // friction opposes the motion, or holds a side at rest until the voltage overcomes it
+    const auto afterFriction = [&](double voltage, double velocity) {
+        if (velocity != 0) return voltage - std::copysign(linear.kS, velocity);
+        return voltage - std::clamp(voltage, -linear.kS, linear.kS);
+    };
+    Matrix<2, 1> previous;
+    previous.data = {{{prevLeft}, {prevRight}}};
+    Matrix<2, 1> input;
+    input.data = {{{afterFriction(applied.left, prevLeft)}, {afterFriction(applied.right, prevRight)}}};
+    Matrix<2, 1> measured;
+    measured.data = {{{leftVelocity}, {rightVelocity}}};
+    // the force is the voltage which explains the difference between the measurement and the prediction
+    const Matrix<2, 1> force = inverseB * (measured - (discreteA * previous + discreteB * input));
+    signal.leftForce += (force(0, 0) - signal.leftForce) * filterGain;
+    signal.rightForce += (force(1, 0) - signal.rightForce) * filterGain;
+    // debounce the push
+    if (std::max(std::abs(signal.leftForce), std::abs(signal.rightForce)) > settings.pushThreshold) aboveTicks++;
+    else aboveTicks = 0;
+    signal.pushed = aboveTicks >= pushTicks;
+    return signal;
+}
+
+DisturbanceSignal DisturbanceObserver::getSignal() const { return signal; }
+
+DriveVoltages DisturbanceObserver::getCompensation() const {
+    const auto cancel = [&](double force) {
+        return std::clamp(-force * settings.compensation, -settings.maxCompensation, settings.maxCompensation);
+    };
+    return {cancel(signal.leftForce), cancel(signal.rightForce)};
+}
+
+void DisturbanceObserver::reset() {
+    voltages = {};
+    updates = 0;
+    prevVelocity = std::nullopt;
+    aboveTicks = 0;
+    signal = {};
+}
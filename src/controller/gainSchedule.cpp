@@ -0,0 +1,24 @@
+#include "controller/gainSchedule.hpp"
+#include "hardware/sensorCache.hpp"
+#include "pros/misc.hpp"
+
+// every scheduled controller looks up the battery each update, so it's read once per tick
+static CachedReading<int32_t> batteryReading; /** battery voltage, in millivolts */
+
+double batteryVoltage() { return batteryReading.get([] { return pros::battery::get_voltage(); }) / 1000.0; }
+
+OperatingPoint velocityOperatingPoint(const VelocityControllerInput& input) {
+    return {std::abs(input.currentVelocity), batteryVoltage(), 0};
+}
+
+OperatingPoint headingOperatingPoint(const PositionControllerInput& input) {
+    return {0, batteryVoltage(), std::abs(input.target - input.measurement)};
+}
+
+std::shared_ptr<GainScheduled<VelocityControllerInput, double, 5>>
+scheduleVAPID(std::shared_ptr<VAPID> vapid, GainTable<5> table,
+              std::function<OperatingPoint(const VelocityControllerInput&)> operatingPoint) {
+    return std::make_shared<GainScheduled<VelocityControllerInput, double, 5>>(
+        vapid, std::move(table),
+        [vapid](const std::array<double, 5>& g) { vapid->setGains(g[0], g[1], g[2], g[3], g[4]); }, operatingPoint);
+}
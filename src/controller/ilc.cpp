@@ -0,0 +1,128 @@
+#include "controller/ilc.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+
+ILC::ILC(uint32_t hash, Time duration, ILCSettings settings)
+    : hash(hash),
+      settings(settings),
+      bins(size_t(std::max(0.0, std::floor(to_sec(duration) / to_sec(settings.binWidth)))) + 2) {
+    if (settings.prefix.empty()) return;
+    std::ifstream file(getPath());
+    if (file) read(file);
+}
+
+std::pair<double, double> ILC::correction(Time time) const {
+    const double position = std::clamp(to_sec(time) / to_sec(settings.binWidth), 0.0, double(bins.size() - 1));
+    const size_t index = std::min(size_t(position), bins.size() - 2);
+    const double t = position - index;
+    const Bin& before = bins[index];
+    const Bin& after = bins[index + 1];
+    return {before.left + (after.left - before.left) * t, before.right + (after.right - before.right) * t};
+}
+
+void ILC::record(Time time, double leftPosition, double rightPosition, double leftVelocity, double rightVelocity) {
+    squaredError += (leftPosition * leftPosition + rightPosition * rightPosition) / 2;
+    maxError = std::max({maxError, std::abs(leftPosition), std::abs(rightPosition)});
+    samples++;
+    // the error corrects the voltage applied a lead earlier
+    const double position = to_sec(time - settings.lead) / to_sec(settings.binWidth);
+    if (position < -0.5) return;
+    Bin& bin = bins[std::min(size_t(std::lround(position)), bins.size() - 1)];
+    bin.leftError += settings.positionGain * leftPosition + settings.velocityGain * leftVelocity;
+    bin.rightError += settings.positionGain * rightPosition + settings.velocityGain * rightVelocity;
+    bin.samples++;
+}
+
+bool ILC::learn() {
+    if (samples == 0) return false;
+    lastError = from_m(std::sqrt(squaredError / samples));
+    if (maxError > to_m(settings.maxRunError)) {
+        discard();
+        return false;
+    }
+    for (Bin& bin : bins) {
+        if (bin.samples == 0) continue;
+        bin.left += bin.leftError / bin.samples;
+        bin.right += bin.rightError / bin.samples;
+    }
+    // smooth the table, so the correction doesn't excite anything faster than the robot can follow, then forget a
+    // little of it
+    double lastLeft = bins.front().left;
+    double lastRight = bins.front().right;
+    for (size_t i = 0; i < bins.size(); i++) {
+        const Bin& next = bins[std::min(i + 1, bins.size() - 1)];
+        const double left = (lastLeft + 2 * bins[i].left + next.left) / 4 * (1 - settings.forgetting);
+        const double right = (lastRight + 2 * bins[i].right + next.right) / 4 * (1 - settings.forgetting);
+        lastLeft = bins[i].left;
+        lastRight = bins[i].right;
+        bins[i].left = std::clamp(left, -settings.maxCorrection, settings.maxCorrection);
+        bins[i].right = std::clamp(right, -settings.maxCorrection, settings.maxCorrection);
+    }
+    runs++;
+    unsaved = true;
+    discard();
+    return true;
+}
+
+bool ILC::save() {
+    if (!unsaved || settings.prefix.empty()) return true;
+    std::ofstream file(getPath());
+    write(file);
+    if (!file) return false;
+    unsaved = false;
+    return true;
+}
+
+void ILC::discard() {
+    for (Bin& bin : bins) {
+        bin.leftError = 0;
+        bin.rightError = 0;
+        bin.samples = 0;
+    }
+    squaredError = 0;
+    maxError = 0;
+    samples = 0;
+}
+
+int ILC::getRuns() const { return runs; }
+
+Length ILC::getLastError() const { return lastError; }
+
+std::string ILC::getPath() const {
+    if (settings.prefix.empty()) return "";
+    char name[16];
+    std::snprintf(name, sizeof(name), "%08x.txt", unsigned(hash));
+    return settings.prefix + name;
+}
+
+void ILC::write(std::ostream& stream) const {
+    stream << "hash " << hash << '\n'
+           << "binWidth " << to_sec(settings.binWidth) << '\n'
+           << "runs " << runs << '\n'
+           << "bins " << bins.size() << '\n';
+    for (const Bin& bin : bins) stream << bin.left << ' ' << bin.right << '\n';
+}
+
+bool ILC::read(std::istream& stream) {
+    std::string name;
+    uint32_t readHash = 0;
+    double binWidth = 0;
+    int readRuns = 0;
+    size_t size = 0;
+    if (!(stream >> name >> readHash) || name != "hash" || readHash != hash) return false;
+    if (!(stream >> name >> binWidth) || name != "binWidth" || std::abs(binWidth - to_sec(settings.binWidth)) > 1e-6)
+        return false;
+    if (!(stream >> name >> readRuns) || name != "runs") return false;
+    if (!(stream >> name >> size) || name != "bins" || size != bins.size()) return false;
+    std::vector<std::pair<double, double>> corrections(size);
+    for (auto& [left, right] : corrections)
+        if (!(stream >> left >> right)) return false;
+    for (size_t i = 0; i < size; i++) {
+        bins[i].left = corrections[i].first;
+        bins[i].right = corrections[i].second;
+    }
+    runs = readRuns;
+    return true;
+}
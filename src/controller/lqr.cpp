@@ -0,0 +1,68 @@
+#include "controller/lqr.hpp"
+#include <cmath>
+
+std::pair<Matrix<2, 2>, Matrix<2, 2>> driveModel(const FeedforwardGains& linear, const FeedforwardGains& angular) {
+    // driving straight and turning are decoupled, so each side is the sum of both: left = straight - turn, right =
+    // straight + turn
+    const double linearA = -linear.kV / linear.kA;
+    const double angularA = -angular.kV / angular.kA;
+    const double linearB = 1 / linear.kA;
+    const double angularB = 1 / angular.kA;
+    std::pair<Matrix<2, 2>, Matrix<2, 2>> model;
+    model.first.data = {{{(linearA + angularA) / 2, (linearA - angularA) / 2},
+                         {(linearA - angularA) / 2, (linearA + angularA) / 2}}};
+    model.second.data = {{{(linearB + angularB) / 2, (linearB - angularB) / 2},
+                          {(linearB - angularB) / 2, (linearB + angularB) / 2}}};
+    return model;
+}
+
+double driveFriction(const FeedforwardGains& linear, const FeedforwardGains& angular, double velocity, double turn) {
+    const double speed = std::abs(velocity) + std::abs(turn);
+    const double turning = (speed == 0) ? 0 : std::abs(turn) / speed;
+    return linear.kS + (angular.kS - linear.kS) * turning;
+}
+
+DriveLQR::DriveLQR(FeedforwardGains linear, FeedforwardGains angular, LQRWeights weights, Time period, Clock clock)
+    : Controller(clock),
+      linear(linear),
+      angular(angular) {
+    if (linear.kA <= 0 || angular.kA <= 0) return;
+    const auto [a, b] = driveModel(linear, angular);
+    const auto [discreteA, discreteB] = discretize(a, b, period);
+    const double q = 1 / (weights.maxVelocityError * weights.maxVelocityError);
+    const double r = 1 / (weights.maxVoltage * weights.maxVoltage);
+    gain = lqrGain(discreteA, discreteB, Matrix<2, 2>::diagonal({q, q}), Matrix<2, 2>::diagonal({r, r}))
+               .value_or(Matrix<2, 2> {});
+}
+
+// the regulator models a symmetric drivetrain, so the linear gains are the average of both sides
+static FeedforwardGains averageSides(const SysIdResult& result) {
+    return {(result.left.kS + result.right.kS) / 2, (result.left.kV + result.right.kV) / 2,
+            (result.left.kA + result.right.kA) / 2, (result.left.rSquared + result.right.rSquared) / 2};
+}
+
+DriveLQR::DriveLQR(const SysIdResult& result, LQRWeights weights, Time period, Clock clock)
+    : DriveLQR(averageSides(result), result.angular, weights, period, clock) {}
+
+DriveVoltages DriveLQR::update(DriveVelocityInput input, Time dt) {
+    // feedforward, by inverting the model in straight and turning components
+    const double velocity = (input.leftTargetVelocity + input.rightTargetVelocity) / 2;
+    const double turn = (input.rightTargetVelocity - input.leftTargetVelocity) / 2;
+    const double acceleration = (input.leftTargetAcceleration + input.rightTargetAcceleration) / 2;
+    const double turnAcceleration = (input.rightTargetAcceleration - input.leftTargetAcceleration) / 2;
+    const double straight = linear.kV * velocity + linear.kA * acceleration;
+    const double turning = angular.kV * turn + angular.kA * turnAcceleration;
+    const double kS = driveFriction(linear, angular, velocity, turn);
+    const auto friction = [&](double target) { return (target == 0) ? 0 : std::copysign(kS, target); };
+    // feedback
+    const double leftError = input.leftTargetVelocity - input.leftVelocity;
+    const double rightError = input.rightTargetVelocity - input.rightVelocity;
+    const double leftFeedback = gain(0, 0) * leftError + gain(0, 1) * rightError;
+    const double rightFeedback = gain(1, 0) * leftError + gain(1, 1) * rightError;
+    return {straight - turning + friction(input.leftTargetVelocity) + leftFeedback,
+            straight + turning + friction(input.rightTargetVelocity) + rightFeedback};
+}
+
+void DriveLQR::reset() { resetClock(); }
+
+Matrix<2, 2> DriveLQR::getGain() const { return gain; }
@@ -0,0 +1,204 @@
+#include "controller/sysid.hpp"
+#include <array>
+#include <cmath>
+#include <cstdlib>
+#include <sstream>
+#include <string>
+
+// samples of files without a run column which are further apart than this start a new run
+constexpr Time RUN_GAP = 100_ms;
+
+static bool isAngular(int test) { return test == SYSID_QUASISTATIC_ANGULAR || test == SYSID_DYNAMIC_ANGULAR; }
+
+static bool sameRun(const SysIdSample& a, const SysIdSample& b) { return a.test == b.test && a.run == b.run; }
+
+// find the first and last index of the samples of the same run within a window around a sample
+static std::pair<size_t, size_t> runBounds(const std::vector<SysIdSample>& samples, size_t i, int window) {
+    size_t first = i;
+    size_t last = i;
+    while (first > 0 && i - first < size_t(window) && sameRun(samples[first - 1], samples[i])) first--;
+    while (last + 1 < samples.size() && last - i < size_t(window) && sameRun(samples[last + 1], samples[i])) last++;
+    return {first, last};
+}
+
+void computeAccelerations(std::vector<SysIdSample>& samples, int window) {
+    // differentiate a copy, so the accelerations don't depend on the order they are written in
+    const std::vector<SysIdSample> original = samples;
+    for (size_t i = 0; i < samples.size(); i++) {
+        const auto [first, last] = runBounds(original, i, window);
+        const Time dt = original[last].time - original[first].time;
+        if (first == last || dt <= 0_sec) {
+            samples[i].leftAcceleration = 0_mps2;
+            samples[i].rightAcceleration = 0_mps2;
+            continue;
+        }
+        samples[i].leftAcceleration = (original[last].leftVelocity - original[first].leftVelocity) / dt;
+        samples[i].rightAcceleration = (original[last].rightVelocity - original[first].rightVelocity) / dt;
+    }
+}
+
+std::optional<FeedforwardGains> fitFeedforward(const std::vector<SysIdSample>& samples, bool left, bool angular,
+                                               LinearVelocity minVelocity) {
+    // accumulate the normal equations of voltage = kS * sign(v) + kV * v + kA * a
+    std::array<std::array<double, 3>, 3> a {};
+    std::array<double, 3> b {};
+    double sumY = 0;
+    double sumYY = 0;
+    int count = 0;
+    for (const SysIdSample& sample : samples) {
+        if (isAngular(sample.test) != angular) continue;
+        const double v = to_mps(left ? sample.leftVelocity : sample.rightVelocity);
+        if (std::abs(v) < to_mps(minVelocity)) continue;
+        const std::array<double, 3> x = {std::copysign(1.0, v), v,
+                                         to_mps2(left ? sample.leftAcceleration : sample.rightAcceleration)};
+        const double y = to_volt(left ? sample.leftVoltage : sample.rightVoltage);
+        for (int i = 0; i < 3; i++) {
+            for (int j = 0; j < 3; j++) a[i][j] += x[i] * x[j];
+            b[i] += x[i] * y;
+        }
+        sumY += y;
+        sumYY += y * y;
+        count++;
+    }
+    if (count < 3) return std::nullopt;
+    // solve with Cramer's rule, which is plenty accurate for a well conditioned 3x3 system
+    const auto determinant = [](const std::array<std::array<double, 3>, 3>& m) {
+        return m[0][0] * (m[1][1] * m[2][2] - m[1][2] * m[2][1]) - m[0][1] * (m[1][0] * m[2][2] - m[1][2] * m[2][0]) +
+               m[0][2] * (m[1][0] * m[2][1] - m[1][1] * m[2][0]);
+    };
+    const double det = determinant(a);
+    if (std::abs(det) < 1e-12) return std::nullopt;
+    std::array<double, 3> gains;
+    for (int k = 0; k < 3; k++) {
+        std::array<std::array<double, 3>, 3> m = a;
+        for (int i = 0; i < 3; i++) m[i][k] = b[i];
+        gains[k] = determinant(m) / det;
+    }
+    // the residual sum of squares follows from the normal equations: y'y - gains'b
+    const double residual = sumYY - (gains[0] * b[0] + gains[1] * b[1] + gains[2] * b[2]);
+    const double total = sumYY - sumY * sumY / count;
+    const double rSquared = (total > 0) ? 1 - residual / total : 0;
+    return FeedforwardGains {gains[0], gains[1], gains[2], rSquared};
+}
+
+SysIdResult fitSysId(const std::vector<SysIdSample>& samples, LinearVelocity minVelocity) {
+    SysIdResult result;
+    result.left = fitFeedforward(samples, true, false, minVelocity).value_or(FeedforwardGains {});
+    result.right = fitFeedforward(samples, false, false, minVelocity).value_or(FeedforwardGains {});
+    // both sides see the same load while turning in place, so their gains are averaged
+    const std::optional<FeedforwardGains> left = fitFeedforward(samples, true, true, minVelocity);
+    const std::optional<FeedforwardGains> right = fitFeedforward(samples, false, true, minVelocity);
+    if (left && right)
+        result.angular = {(left->kS + right->kS) / 2, (left->kV + right->kV) / 2, (left->kA + right->kA) / 2,
+                          (left->rSquared + right->rSquared) / 2};
+    else result.angular = left.value_or(right.value_or(FeedforwardGains {}));
+    // the effective track width relates the difference of the wheel velocities to the angular velocity:
+    // vRight - vLeft = trackWidth * omega. It's fit with least squares over the angular tests
+    double sumDifference = 0;
+    double sumOmegaSquared = 0;
+    for (size_t i = 0; i < samples.size(); i++) {
+        if (!isAngular(samples[i].test)) continue;
+        const auto [first, last] = runBounds(samples, i, 2);
+        const Time dt = samples[last].time - samples[first].time;
+        if (first == last || dt <= 0_sec) continue;
+        const double omega = to_sRad(samples[last].heading - samples[first].heading) / to_sec(dt);
+        sumDifference += to_mps(samples[i].rightVelocity - samples[i].leftVelocity) * omega;
+        sumOmegaSquared += omega * omega;
+    }
+    if (sumOmegaSquared > 0) result.trackWidth = from_m(sumDifference / sumOmegaSquared);
+    return result;
+}
+
+void writeSysIdSamples(std::ostream& stream, const std::vector<SysIdSample>& samples) {
+    stream << "test,run,time,left voltage,right voltage,left velocity,right velocity,heading,left acceleration,"
+              "right acceleration\n";
+    for (const SysIdSample& s : samples)
+        stream << s.test << ',' << s.run << ',' << to_sec(s.time) << ',' << to_volt(s.leftVoltage) << ','
+               << to_volt(s.rightVoltage) << ',' << to_mps(s.leftVelocity) << ',' << to_mps(s.rightVelocity) << ','
+               << to_sRad(s.heading) << ',' << to_mps2(s.leftAcceleration) << ',' << to_mps2(s.rightAcceleration)
+               << '\n';
+}
+
+std::vector<SysIdSample> readSysIdSamples(std::istream& stream) {
+    std::vector<SysIdSample> samples;
+    std::string line;
+    std::optional<bool> hasRun; // whether the file has a run column, decided by the first sample
+    int inferredRun = 0; // run of files without a run column
+    while (std::getline(stream, line)) {
+        std::array<double, 10> values;
+        std::stringstream fields(line);
+        std::string field;
+        int count = 0;
+        // stop at the first field that isn't a number, which skips the header and damaged lines
+        while (count < 10 && std::getline(fields, field, ',')) {
+            char* end;
+            values[count] = std::strtod(field.c_str(), &end);
+            if (end == field.c_str()) break;
+            count++;
+        }
+        if (hasRun == std::nullopt && (count == 9 || count == 10)) hasRun = count == 10;
+        if (hasRun == std::nullopt || count != (*hasRun ? 10 : 9)) continue;
+        // without a run column every value is one column to the left
+        const double* v = *hasRun ? values.data() + 1 : values.data();
+        SysIdSample sample {int(values[0]), 0, from_sec(v[1]), from_volt(v[2]), from_volt(v[3]), from_mps(v[4]),
+                            from_mps(v[5]), from_sRad(v[6]), from_mps2(v[7]), from_mps2(v[8])};
+        if (*hasRun) {
+            sample.run = int(values[1]);
+        } else {
+            // the robot rests between runs, so a new run starts where the test changes or the samples pause
+            if (!samples.empty() &&
+                (sample.test != samples.back().test || sample.time - samples.back().time > RUN_GAP ||
+                 sample.time < samples.back().time))
+                inferredRun++;
+            sample.run = inferredRun;
+        }
+        samples.push_back(sample);
+    }
+    return samples;
+}
+
+void writeSysIdResult(std::ostream& stream, const SysIdResult& result) {
+    const auto write = [&](const char* name, const FeedforwardGains& gains) {
+        stream << name << ".kS " << gains.kS << '\n'
+               << name << ".kV " << gains.kV << '\n'
+               << name << ".kA " << gains.kA << '\n'
+               << name << ".rSquared " << gains.rSquared << '\n';
+    };
+    write("left", result.left);
+    write("right", result.right);
+    write("angular", result.angular);
+    stream << "trackWidth " << to_m(result.trackWidth) << '\n';
+}
+
+std::optional<SysIdResult> readSysIdResult(std::istream& stream) {
+    SysIdResult result;
+    int found = 0;
+    std::string name;
+    double value;
+    while (stream >> name >> value) {
+        // rSquared is informational, so it isn't required
+        std::array<std::pair<const char*, double*>, 12> fields = {{{"left.kS", &result.left.kS},
+                                                                   {"left.kV", &result.left.kV},
+                                                                   {"left.kA", &result.left.kA},
+                                                                   {"right.kS", &result.right.kS},
+                                                                   {"right.kV", &result.right.kV},
+                                                                   {"right.kA", &result.right.kA},
+                                                                   {"angular.kS", &result.angular.kS},
+                                                                   {"angular.kV", &result.angular.kV},
+                                                                   {"angular.kA", &result.angular.kA},
+                                                                   {"left.rSquared", &result.left.rSquared},
+                                                                   {"right.rSquared", &result.right.rSquared},
+                                                                   {"angular.rSquared", &result.angular.rSquared}}};
+        for (size_t i = 0; i < fields.size(); i++) {
+            if (name != fields[i].first) continue;
+            *fields[i].second = value;
+            if (i < 9) found |= 1 << i;
+        }
+        if (name == "trackWidth") {
+            result.trackWidth = from_m(value);
+            found |= 1 << 9;
+        }
+    }
+    if (found != (1 << 10) - 1) return std::nullopt;
+    return result;
+}
@@ -1,26 +1,58 @@
 #include "controller/vapid.hpp"
-#include "pros/rtos.hpp"
+#include <cmath>
 
-VAPID::VAPID(double kV, double kA, double kP, double kI, double kD)
-    : kV(kV),
+constexpr double MAX_OUTPUT = 12; // the motors saturate at 12 volts
+
+VAPID::VAPID(double kV, double kA, double kP, double kI, double kD, Clock clock)
+    : Controller(clock),
+      kV(kV),
       kA(kA),
       kP(kP),
       kI(kI),
       kD(kD) {}
 
-double VAPID::update(VelocityControllerInput input) {
+VAPID::VAPID(FeedforwardGains feedforward, double kP, double kI, double kD, Clock clock)
+    : Controller(clock),
+      kS(feedforward.kS),
+      kV(feedforward.kV),
+      kA(feedforward.kA),
+      kP(kP),
+      kI(kI),
+      kD(kD) {}
+
+double VAPID::update(VelocityControllerInput input, Time dt) {
     const double error = input.targetVelocity - input.currentVelocity;
     // initialize optional values
     if (lastError == std::nullopt) lastError = error;
-    if (timer == std::nullopt) timer = Timer(UINT32_MAX);
-    if (lastTime == std::nullopt) lastTime = pros::millis();
     const double dError = error - lastError.value();
-    const int dt = timer->getTimePassed() - lastTime.value();
-    const double derivative = (dt == 0) ? 0 : (error - lastError.value()) / dt;
-    integral += dt * (lastError.value() + dError / 2);
+    const double seconds = to_sec(dt);
+    const double derivative = (seconds == 0) ? 0 : dError / seconds;
+    // trapezoidal integration, scaled by the gain it's integrated with so changing kI doesn't move the output
+    const double step = kI * seconds * (lastError.value() + dError / 2);
+    integral += step;
     // update previous values
     lastError = error;
-    lastTime = timer->getTimePassed();
-    // return output
-    return kV * input.targetVelocity + kA * input.targetAcceleration + kP * error + kI * integral + kD * derivative;
-}
\ No newline at end of file
+    const double friction = (input.targetVelocity == 0) ? 0 : std::copysign(kS, input.targetVelocity);
+    double output = friction + kV * input.targetVelocity + kA * input.targetAcceleration + kP * error +
+                    integral + kD * derivative;
+    // conditional integration: while the motors are saturated, integrating more would only wind the integral up
+    if (std::abs(output) > MAX_OUTPUT && (error > 0) == (output > 0)) {
+        integral -= step;
+        output -= step;
+    }
+    return output;
+}
+
+void VAPID::reset() {
+    integral = 0;
+    lastError = std::nullopt;
+    resetClock();
+}
+
+void VAPID::setGains(double kV, double kA, double kP, double kI, double kD) {
+    this->kV = kV;
+    this->kA = kA;
+    this->kP = kP;
+    this->kI = kI;
+    this->kD = kD;
+}
@@ -1,8 +1,15 @@
 #include "devices.hpp"
 #include "odometry/perpWheelOdom.hpp"
+#include "hardware/encoder/motorEncoder.hpp"
 #include "hardware/encoder/rotation.hpp"
 #include "hardware/imu/v5_imu.hpp"
 
+// configure motors
+std::shared_ptr<MotorGroup> leftDrive =
+    std::make_shared<MotorGroup>(std::initializer_list<int> {1, 2}, Cartridge::BLUE, 0.75); // TODO: change ports
+std::shared_ptr<MotorGroup> rightDrive =
+    std::make_shared<MotorGroup>(std::initializer_list<int> {3, 4}, Cartridge::BLUE, 0.75); // TODO: change ports
+
 // configure odometry
 std::shared_ptr<Rotation> verticalEncoder = std::make_shared<Rotation>(5); // TODO: change port
 std::shared_ptr<TrackingWheel> verticalWheel =
@@ -11,18 +18,35 @@ std::shared_ptr<Rotation> horizontalEncoder = std::make_shared<Rotation>(6); //
 std::shared_ptr<TrackingWheel> horizontalWheel =
     std::make_shared<TrackingWheel>(horizontalEncoder, 2.75_in, 0_in); // TODO: configure lengths
 std::shared_ptr<V5IMU> imu = std::make_shared<V5IMU>(7); // TODO: change port
-std::shared_ptr<PerpWheelOdom> odometry = std::make_shared<PerpWheelOdom>(verticalWheel, horizontalWheel, imu);
-
-// configure motors
-std::shared_ptr<pros::MotorGroup> leftDrive(new pros::MotorGroup({1, 2})); // TODO: change ports
-std::shared_ptr<pros::MotorGroup> rightDrive(new pros::MotorGroup({3, 4})); // TODO: change ports
+// the drive encoders are the fallback of the vertical wheel and the IMU. They read the first motor of each side, so
+// the drive motors aren't read twice. Offsets are positive to the left
+std::shared_ptr<TrackingWheel> leftDriveWheel =
+    std::make_shared<TrackingWheel>(std::make_shared<MotorEncoder>(leftDrive), 3.25_in / 2, 6_in);
+std::shared_ptr<TrackingWheel> rightDriveWheel =
+    std::make_shared<TrackingWheel>(std::make_shared<MotorEncoder>(rightDrive), 3.25_in / 2, -6_in);
+// the robot has a single IMU, so the drive encoders are the only heading fallback
+std::shared_ptr<PerpWheelOdom> odometry =
+    std::make_shared<PerpWheelOdom>(verticalWheel, horizontalWheel, imu, leftDriveWheel, rightDriveWheel);
 
 // configure controllers
 std::shared_ptr<Controller<VelocityControllerInput, double>> leftVelocityController; // TODO: implement vel controllers
 std::shared_ptr<Controller<VelocityControllerInput, double>> rightVelocityController; // TODO: implement vel controllers
-std::shared_ptr<Controller<double, double>> linearPositionController; // TODO: implement pos controllers
-std::shared_ptr<Controller<double, double>> angularPositionController; // TODO: implement pos controllers
+// position controllers take meters or radians and output volts. Until their gains are measured on the robot with
+// Chassis::autotune(), they only use the features which are safe untuned: no integral or slew limit, and low gains
+// with a filtered derivative on measurement
+constexpr unsigned UNTUNED_PID = PID_DERIVATIVE_ON_MEASUREMENT | PID_DERIVATIVE_FILTER | PID_OUTPUT_CLAMP;
+std::shared_ptr<Controller<PositionControllerInput, double>> linearPositionController =
+    std::make_shared<PID<UNTUNED_PID>>(PIDGains {30, 0, 3}); // TODO: tune pos controllers
+std::shared_ptr<Controller<PositionControllerInput, double>> angularPositionController =
+    std::make_shared<PID<UNTUNED_PID>>(PIDGains {6, 0, 0.5}); // TODO: tune pos controllers
+
+// configure slip detection
+std::shared_ptr<SlipDetector> slipDetector =
+    std::make_shared<SlipDetector>(verticalWheel, imu, 12_in); // TODO: configure track width
+
+// TODO: configure power budgeting. Fit the thermal parameters of the drive motors to recorded telemetry, see the
+// constructor of PowerBudget, and pass the budget to the chassis
 
 // configure chassis
-Chassis chassis(leftDrive, rightDrive, odometry, 12_in, leftVelocityController, rightVelocityController,
-                linearPositionController, angularPositionController);
+Chassis chassis(leftDrive, rightDrive, odometry, 12_in, 3.25_in, leftVelocityController, rightVelocityController,
+                linearPositionController, angularPositionController, {.slipDetector = slipDetector});
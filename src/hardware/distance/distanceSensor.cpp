@@ -0,0 +1,22 @@
+#include "hardware/distance/distanceSensor.hpp"
+#include "pros/distance.h"
+#include "pros/error.h"
+
+constexpr int32_t NO_OBJECT = 9999; // distance reported by the sensor when it doesn't detect anything, in mm
+
+DistanceSensor::DistanceSensor(int port)
+    : port(port) {}
+
+std::optional<Length> DistanceSensor::getDistance() {
+    const int32_t distance = distanceReading.get([this] { return pros::c::distance_get(port); });
+    if (distance == PROS_ERR || distance >= NO_OBJECT) return std::nullopt;
+    return from_mm(distance);
+}
+
+int DistanceSensor::getConfidence() {
+    const int32_t confidence = confidenceReading.get([this] { return pros::c::distance_get_confidence(port); });
+    if (confidence == PROS_ERR) return 0;
+    return confidence;
+}
+
+int DistanceSensor::getPort() const { return port; }
@@ -0,0 +1,82 @@
+#include "hardware/encoder/adiEncoder.hpp"
+#include "pros/adi.h"
+#include "pros/error.h"
+#include "timer.hpp"
+#include <cmath>
+
+constexpr Angle ADI_TICK = 1 * deg; // resolution of the optical shaft encoder
+
+ADIEncoder::ADIEncoder(char topPort, char bottomPort, bool reversed, float gearRatio)
+    // the direction is applied here instead of by PROS, so it can be changed later
+    : encoder(pros::c::adi_encoder_init(topPort, bottomPort, false)),
+      gearRatio(gearRatio),
+      tickAngle(ADI_TICK * gearRatio),
+      reversed(reversed) {}
+
+void ADIEncoder::calibrate() { tare(); }
+
+int ADIEncoder::getStatus() {
+    if (encoder != PROS_ERR) return ENCODER_CALIBRATED;
+    else return ENCODER_UNKNOWN_ERROR;
+}
+
+void ADIEncoder::tare() {
+    pros::c::adi_encoder_reset(encoder);
+    lastTicks = 0;
+    offset = 0;
+    positionReading.invalidate();
+    velocityEstimator.reset();
+}
+
+Angle ADIEncoder::getPosition() { return getTicks() * tickAngle; }
+
+void ADIEncoder::setPosition(Angle angle) {
+    offset = std::llround((angle / tickAngle).val()) - readTicks();
+    positionReading.invalidate();
+    velocityEstimator.reset();
+}
+
+Angle ADIEncoder::getAngle() {
+    // fmod keeps the sign of the position, so wrap negative angles into the first rotation
+    const Angle angle = units::constrainAngle360(getPosition());
+    return angle < 0_stRad ? angle + rot : angle;
+}
+
+AngularVelocity ADIEncoder::getVelocity() {
+    getTicks();
+    // the estimator works in ticks, so the velocity is scaled the same way as the position
+    return to_radps(velocityEstimator.getVelocity()) * tickAngle / sec;
+}
+
+int64_t ADIEncoder::getTicks() { return positionReading.get([this] { return readTicks(); }) + offset; }
+
+Angle ADIEncoder::getTickAngle() { return tickAngle; }
+
+bool ADIEncoder::getReversed() { return reversed; }
+
+void ADIEncoder::setReversed(bool reversed) {
+    // negate the position measured so far, then read subsequent changes in the new direction
+    if (reversed != this->reversed) {
+        const int64_t ticks = getTicks();
+        this->reversed = reversed;
+        positionReading.invalidate();
+        velocityEstimator.reset();
+        offset = -ticks - readTicks();
+    }
+}
+
+float ADIEncoder::getGearRatio() { return gearRatio; }
+
+void ADIEncoder::setGearRatio(float gearRatio) {
+    this->gearRatio = gearRatio;
+    tickAngle = ADI_TICK * gearRatio;
+}
+
+int64_t ADIEncoder::readTicks() {
+    const int32_t raw = pros::c::adi_encoder_get(encoder);
+    // keep the last count if the encoder can't be read, so the position doesn't jump
+    if (raw == PROS_ERR) return lastTicks;
+    lastTicks = reversed ? -static_cast<int64_t>(raw) : raw;
+    velocityEstimator.addSample(Timer::now(), from_sRad(lastTicks));
+    return lastTicks;
+}
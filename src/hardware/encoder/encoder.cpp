@@ -1,3 +1,8 @@
 #include "hardware/encoder/encoder.hpp"
+#include <cmath>
+
+int64_t Encoder::getTicks() { return std::llround((getPosition() / getTickAngle()).val()); }
+
+Angle Encoder::getTickAngle() { return 0.01 * deg; }
 
 Encoder::~Encoder() {}
@@ -0,0 +1,90 @@
+#include "hardware/encoder/motorEncoder.hpp"
+#include <cmath>
+
+// ticks per rotation of the cartridge output
+static int ticksPerRotation(Cartridge cartridge) {
+    switch (cartridge) {
+        case Cartridge::RED: return 1800;
+        case Cartridge::GREEN: return 900;
+        case Cartridge::BLUE: return 300;
+    }
+    return 900;
+}
+
+// the motor at an index of a group, or nullptr if there is none
+static Motor* motorAt(const std::shared_ptr<MotorGroup>& motors, size_t index) {
+    if (motors == nullptr || index >= motors->getMotors().size()) return nullptr;
+    return &motors->getMotors()[index];
+}
+
+MotorEncoder::MotorEncoder(std::shared_ptr<MotorGroup> motors, size_t index)
+    : motors(motors),
+      index(index),
+      cartridgeTick(rot / (motorAt(motors, index) ? ticksPerRotation(motorAt(motors, index)->getCartridge()) : 900)),
+      gearRatio(motorAt(motors, index) ? motorAt(motors, index)->getGearRatio() : 1),
+      tickAngle(cartridgeTick * gearRatio) {}
+
+void MotorEncoder::calibrate() { tare(); }
+
+int MotorEncoder::getStatus() {
+    // the motor reports infinity for every reading when it can't be read
+    Motor* motor = getMotor();
+    if (motor != nullptr && std::isfinite(to_sRad(motor->getPosition()))) return ENCODER_CALIBRATED;
+    else return ENCODER_UNKNOWN_ERROR;
+}
+
+void MotorEncoder::tare() { offset = -readTicks(); }
+
+Angle MotorEncoder::getPosition() { return getTicks() * tickAngle; }
+
+void MotorEncoder::setPosition(Angle angle) { offset = std::llround((angle / tickAngle).val()) - readTicks(); }
+
+Angle MotorEncoder::getAngle() {
+    // fmod keeps the sign of the position, so wrap negative angles into the first rotation
+    const Angle angle = units::constrainAngle360(getPosition());
+    return angle < 0_stRad ? angle + rot : angle;
+}
+
+AngularVelocity MotorEncoder::getVelocity() {
+    Motor* motor = getMotor();
+    if (motor == nullptr) return 0_radps;
+    // the motor measures the velocity of the output of its own gear ratio
+    const AngularVelocity velocity = motor->getVelocity() / motor->getGearRatio() * gearRatio;
+    return reversed ? -velocity : velocity;
+}
+
+int64_t MotorEncoder::getTicks() { return readTicks() + offset; }
+
+Angle MotorEncoder::getTickAngle() { return tickAngle; }
+
+bool MotorEncoder::getReversed() { return reversed; }
+
+void MotorEncoder::setReversed(bool reversed) {
+    // negate the position measured so far, then read subsequent changes in the new direction
+    if (reversed != this->reversed) {
+        const int64_t ticks = getTicks();
+        this->reversed = reversed;
+        offset = -ticks - readTicks();
+    }
+}
+
+float MotorEncoder::getGearRatio() { return gearRatio; }
+
+void MotorEncoder::setGearRatio(float gearRatio) {
+    this->gearRatio = gearRatio;
+    tickAngle = cartridgeTick * gearRatio;
+}
+
+Motor* MotorEncoder::getMotor() { return motorAt(motors, index); }
+
+int64_t MotorEncoder::readTicks() {
+    Motor* motor = getMotor();
+    if (motor == nullptr) return lastTicks;
+    // the motor measures the position of the output of its own gear ratio, so undo it to get the cartridge output
+    const Angle position = motor->getPosition() / motor->getGearRatio();
+    // keep the last count if the motor can't be read, so the position doesn't jump when it reconnects
+    if (!std::isfinite(to_sRad(position))) return lastTicks;
+    const int64_t ticks = std::llround((position / cartridgeTick).val());
+    lastTicks = reversed ? -ticks : ticks;
+    return lastTicks;
+}
@@ -0,0 +1,32 @@
+#include "hardware/encoder/playbackEncoder.hpp"
+
+PlaybackEncoder::PlaybackEncoder(std::shared_ptr<SensorLogReader> log, int id, Clock clock)
+    : log(log),
+      id(id),
+      clock(clock) {}
+
+void PlaybackEncoder::calibrate() {}
+
+int PlaybackEncoder::getStatus() { return get(ENCODER_FIELD_STATUS, ENCODER_UNKNOWN_ERROR); }
+
+void PlaybackEncoder::tare() {}
+
+Angle PlaybackEncoder::getPosition() { return from_sRad(get(ENCODER_FIELD_POSITION)); }
+
+void PlaybackEncoder::setPosition(Angle angle) {}
+
+Angle PlaybackEncoder::getAngle() { return from_sRad(get(ENCODER_FIELD_ANGLE)); }
+
+AngularVelocity PlaybackEncoder::getVelocity() { return from_radps(get(ENCODER_FIELD_VELOCITY)); }
+
+bool PlaybackEncoder::getReversed() { return get(ENCODER_FIELD_REVERSED); }
+
+void PlaybackEncoder::setReversed(bool reversed) {}
+
+float PlaybackEncoder::getGearRatio() { return get(ENCODER_FIELD_GEAR_RATIO, 1); }
+
+void PlaybackEncoder::setGearRatio(float gearRatio) {}
+
+double PlaybackEncoder::get(int field, double fallback) {
+    return log->getValue(sensorChannel(id, field), clock()).value_or(fallback);
+}
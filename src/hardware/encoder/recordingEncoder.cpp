@@ -0,0 +1,52 @@
+#include "hardware/encoder/recordingEncoder.hpp"
+
+RecordingEncoder::RecordingEncoder(std::shared_ptr<Encoder> encoder, std::shared_ptr<SensorLogWriter> log, int id)
+    : encoder(encoder),
+      log(log),
+      id(id) {}
+
+void RecordingEncoder::calibrate() { encoder->calibrate(); }
+
+int RecordingEncoder::getStatus() {
+    const int status = encoder->getStatus();
+    log->write(sensorChannel(id, ENCODER_FIELD_STATUS), status);
+    return status;
+}
+
+void RecordingEncoder::tare() { encoder->tare(); }
+
+Angle RecordingEncoder::getPosition() {
+    const Angle position = encoder->getPosition();
+    log->write(sensorChannel(id, ENCODER_FIELD_POSITION), to_sRad(position));
+    return position;
+}
+
+void RecordingEncoder::setPosition(Angle angle) { encoder->setPosition(angle); }
+
+Angle RecordingEncoder::getAngle() {
+    const Angle angle = encoder->getAngle();
+    log->write(sensorChannel(id, ENCODER_FIELD_ANGLE), to_sRad(angle));
+    return angle;
+}
+
+AngularVelocity RecordingEncoder::getVelocity() {
+    const AngularVelocity velocity = encoder->getVelocity();
+    log->write(sensorChannel(id, ENCODER_FIELD_VELOCITY), to_radps(velocity));
+    return velocity;
+}
+
+bool RecordingEncoder::getReversed() {
+    const bool reversed = encoder->getReversed();
+    log->write(sensorChannel(id, ENCODER_FIELD_REVERSED), reversed);
+    return reversed;
+}
+
+void RecordingEncoder::setReversed(bool reversed) { encoder->setReversed(reversed); }
+
+float RecordingEncoder::getGearRatio() {
+    const float gearRatio = encoder->getGearRatio();
+    log->write(sensorChannel(id, ENCODER_FIELD_GEAR_RATIO), gearRatio);
+    return gearRatio;
+}
+
+void RecordingEncoder::setGearRatio(float gearRatio) { encoder->setGearRatio(gearRatio); }
@@ -1,44 +1,94 @@
 #include "hardware/encoder/rotation.hpp"
+#include "pros/error.h"
+#include <cmath>
+
+constexpr Angle CENTIDEGREE = 0.01 * deg; // resolution of the rotation sensor
 
 Rotation::Rotation(pros::Rotation* sensor, float gearRatio)
     : sensor(sensor),
-      gearRatio(gearRatio) {}
+      gearRatio(gearRatio),
+      tickAngle(CENTIDEGREE * gearRatio) {}
 
 Rotation::Rotation(int port, float gearRatio)
     : sensor(std::make_unique<pros::Rotation>(port)),
-      gearRatio(gearRatio) {}
+      gearRatio(gearRatio),
+      tickAngle(CENTIDEGREE * gearRatio) {}
 
-void Rotation::calibrate() { sensor->reset_position(); }
+void Rotation::calibrate() {
+    sensor->reset_position();
+    resetTicks(0);
+}
 
 int Rotation::getStatus() {
-    if (sensor->is_installed()) return ENCODER_UNKNOWN_ERROR;
-    else return ENCODER_CALIBRATED;
+    if (sensor->is_installed()) return ENCODER_CALIBRATED;
+    else return ENCODER_UNKNOWN_ERROR;
 }
 
-void Rotation::tare() { sensor->reset_position(); }
-
-Angle Rotation::getPosition() {
-    // divide get_position by 100 to convert from centidegrees to degrees
-    // multiply by the gear ratio
-    return from_sdeg(gearRatio * sensor->get_position() / 100.0);
+void Rotation::tare() {
+    sensor->reset_position();
+    resetTicks(0);
 }
 
+Angle Rotation::getPosition() { return getTicks() * tickAngle; }
+
 void Rotation::setPosition(Angle angle) {
-    // multiply get_angle by 100 to convert from degrees to centidegrees
-    // divide by the gear ratio
-    sensor->set_position(to_sDeg(angle) * 100 / gearRatio);
+    // convert to centidegrees of the sensor. The sensor only stores 32 bits, but the tick count keeps all 64
+    const int64_t target = std::llround((angle / tickAngle).val());
+    sensor->set_position(static_cast<uint32_t>(target));
+    resetTicks(target);
 }
 
 Angle Rotation::getAngle() {
     // divide get_angle by 100 to convert from centidegrees to degrees
     // multiply by the gear ratio
-    return from_sdeg(sensor->get_angle() / 100.0);
+    return from_sdeg(angleReading.get([this] { return sensor->get_angle(); }) / 100.0);
+}
+
+AngularVelocity Rotation::getVelocity() {
+    // the sensor measures velocity in centidegrees per second, so it's scaled the same way as ticks
+    return velocityReading.get([this] { return sensor->get_velocity(); }) * tickAngle / sec;
+}
+
+int64_t Rotation::getTicks() {
+    return positionReading.get([this] { return accumulate(sensor->get_position()); });
 }
 
+Angle Rotation::getTickAngle() { return tickAngle; }
+
 bool Rotation::getReversed() { return sensor->get_reversed(); }
 
-void Rotation::setReversed(bool reversed) { sensor->set_reversed(reversed); }
+void Rotation::setReversed(bool reversed) {
+    // the sensor negates its position when it's reversed, so the tick count has to be negated too
+    if (reversed != getReversed()) {
+        ticks = -ticks;
+        lastRaw = -lastRaw;
+    }
+    sensor->set_reversed(reversed);
+    positionReading.invalidate();
+    angleReading.invalidate();
+    velocityReading.invalidate();
+}
 
 float Rotation::getGearRatio() { return gearRatio; }
 
-void Rotation::setGearRatio(float gearRatio) { this->gearRatio = gearRatio; }
\ No newline at end of file
+void Rotation::setGearRatio(float gearRatio) {
+    this->gearRatio = gearRatio;
+    tickAngle = CENTIDEGREE * gearRatio;
+}
+
+int64_t Rotation::accumulate(int32_t raw) {
+    // keep the last count if the sensor can't be read, so the position doesn't jump when it reconnects
+    if (raw == PROS_ERR) return ticks;
+    // subtract in unsigned space so the difference is correct even if the 32 bit count wrapped
+    ticks += static_cast<int32_t>(static_cast<uint32_t>(raw) - static_cast<uint32_t>(lastRaw));
+    lastRaw = raw;
+    return ticks;
+}
+
+void Rotation::resetTicks(int64_t ticks) {
+    this->ticks = ticks;
+    lastRaw = static_cast<int32_t>(ticks);
+    positionReading.invalidate();
+    angleReading.invalidate();
+    velocityReading.invalidate();
+}
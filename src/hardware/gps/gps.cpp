@@ -0,0 +1,3 @@
+#include "hardware/gps/gps.hpp"
+
+GPS::~GPS() {}
@@ -0,0 +1,40 @@
+#include "hardware/gps/v5_gps.hpp"
+#include "pros/error.h"
+#include <cerrno>
+#include <cmath>
+
+V5GPS::V5GPS(int port, Length xOffset, Length yOffset)
+    : port(port),
+      xOffset(xOffset),
+      yOffset(yOffset) {}
+
+void V5GPS::calibrate() {
+    pros::c::gps_set_offset(port, to_m(xOffset), to_m(yOffset));
+    statusReading.invalidate();
+    errorReading.invalidate();
+    poseReading.invalidate();
+}
+
+int V5GPS::getStatus() {
+    return statusReading.get([this] {
+        if (pros::c::gps_get_error(port) != PROS_ERR_F) return GPS_READY;
+        return (errno == EAGAIN) ? GPS_CALIBRATING : GPS_UNKNOWN_ERROR;
+    });
+}
+
+units::Pose V5GPS::getPose() {
+    const pros::gps_status_s_t status =
+        poseReading.get([this] { return pros::c::gps_get_position_and_orientation(port); });
+    return units::Pose(from_m(status.x), from_m(status.y), from_cdeg(status.yaw));
+}
+
+Length V5GPS::getError() { return from_m(errorReading.get([this] { return pros::c::gps_get_error(port); })); }
+
+void V5GPS::setPose(units::Pose pose) {
+    // the GPS takes a heading from 0 to 360 degrees
+    const double heading = std::fmod(std::fmod(to_cDeg(pose.getTheta()), 360) + 360, 360);
+    pros::c::gps_set_position(port, to_m(pose.getX()), to_m(pose.getY()), heading);
+    statusReading.invalidate();
+    errorReading.invalidate();
+    poseReading.invalidate();
+}
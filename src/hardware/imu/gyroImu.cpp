@@ -0,0 +1,89 @@
+#include "hardware/imu/gyroImu.hpp"
+#include "pros/error.h"
+#include <cmath>
+
+constexpr uint32_t SAMPLE_PERIOD = 5; // fastest data rate of the V5 IMU, in milliseconds
+constexpr double STILL_RATE = 0.5; // the robot is still below this filtered rate, in degrees per second
+constexpr Time STILL_FILTER = 100_ms; // time constant of the filter used to detect when the robot is still
+constexpr Time STILL_TIME = 500_ms; // how long the robot has to be still before the bias is updated
+constexpr double BIAS_GAIN = 0.2; // how fast the bias follows the gyro while the robot is still, per second
+
+GyroIMU::GyroIMU(int port, double scale, Time biasTime)
+    : V5IMU(port),
+      scale(scale),
+      biasTime(biasTime) {}
+
+void GyroIMU::calibrate() {
+    V5IMU::calibrate();
+    imu->set_data_rate(SAMPLE_PERIOD);
+    biasMeasured = false;
+    restart = true;
+    heading = 90;
+    rate = 0;
+    // start the sampling task, but only if it hasn't been started yet
+    if (task == std::nullopt)
+        task = pros::Task {[this]() {
+            while (true) {
+                this->sample();
+                pros::delay(SAMPLE_PERIOD);
+            }
+        }};
+}
+
+int GyroIMU::getStatus() {
+    const int status = V5IMU::getStatus();
+    if (status == IMU_CALIBRATED && !biasMeasured) return IMU_CALIBRATING;
+    return status;
+}
+
+Angle GyroIMU::getRotation() { return from_sdeg(heading); }
+
+Angle GyroIMU::getYaw() {
+    // wrap the compass heading between -180 and 180 degrees, like the yaw of the sensor
+    const double compass = std::remainder(90 - heading, 360);
+    return from_cdeg(compass);
+}
+
+void GyroIMU::setYaw(Angle angle) { heading = to_sDeg(angle); }
+
+AngularVelocity GyroIMU::getAngularVelocity() { return from_degps(rate); }
+
+void GyroIMU::sample() {
+    if (restart.exchange(false)) {
+        biasSum = 0;
+        biasSamples = 0;
+        stillTime = 0_sec;
+        filteredRate = 0;
+        lastMicros = std::nullopt;
+    }
+    // the gyro can't be read while the sensor calibrates
+    if (imu->get_status() != pros::ImuStatus::ready) return;
+    const double raw = imu->get_gyro_rate().z;
+    if (raw == PROS_ERR_F) return;
+    const uint64_t now = pros::micros();
+    const Time dt = from_us(lastMicros ? now - *lastMicros : 0);
+    lastMicros = now;
+    // measure the bias while the robot sits still after calibrating
+    if (!biasMeasured) {
+        biasSum += raw;
+        biasSamples++;
+        if (biasSamples * SAMPLE_PERIOD >= to_ms(biasTime)) {
+            bias = biasSum / biasSamples;
+            biasMeasured = true;
+        }
+        return;
+    }
+    // integrate the heading with the trapezoidal rule. setYaw() can store a heading from another task at any time,
+    // so the step is added with a compare and swap instead of a separate load and store, which would overwrite it
+    const double newRate = (raw - bias) * scale;
+    const double step = (rate + newRate) / 2 * to_sec(dt);
+    double current = heading.load();
+    while (!heading.compare_exchange_weak(current, current + step)) {}
+    rate = newRate;
+    // the bias drifts with temperature, so keep following it whenever the robot stays still. The rate is filtered
+    // first, so noise doesn't make the robot look like it's moving
+    filteredRate += (raw - bias - filteredRate) * std::min(1.0, to_sec(dt) / to_sec(STILL_FILTER));
+    if (std::abs(filteredRate) < STILL_RATE) stillTime += dt;
+    else stillTime = 0_sec;
+    if (stillTime >= STILL_TIME) bias += (raw - bias) * std::min(1.0, BIAS_GAIN * to_sec(dt));
+}
@@ -0,0 +1,40 @@
+#include "hardware/imu/playbackImu.hpp"
+
+PlaybackIMU::PlaybackIMU(std::shared_ptr<SensorLogReader> log, int id, Clock clock)
+    : log(log),
+      id(id),
+      clock(clock) {}
+
+void PlaybackIMU::calibrate() {}
+
+int PlaybackIMU::getStatus() { return get(IMU_FIELD_STATUS, IMU_NOT_CALIBRATED); }
+
+Angle PlaybackIMU::getRotation() { return from_sRad(get(IMU_FIELD_ROTATION)); }
+
+Angle PlaybackIMU::getYaw() { return from_sRad(get(IMU_FIELD_YAW)); }
+
+void PlaybackIMU::setYaw(Angle angle) {}
+
+AngularVelocity PlaybackIMU::getAngularVelocity() { return from_radps(get(IMU_FIELD_ANGULAR_VELOCITY)); }
+
+Angle PlaybackIMU::getPitch() { return from_sRad(get(IMU_FIELD_PITCH)); }
+
+void PlaybackIMU::setPitch(Angle angle) {}
+
+Angle PlaybackIMU::getRoll() { return from_sRad(get(IMU_FIELD_ROLL)); }
+
+void PlaybackIMU::setRoll(Angle angle) {}
+
+LinearAcceleration PlaybackIMU::getXAcceleration() { return from_mps2(get(IMU_FIELD_X_ACCELERATION)); }
+
+LinearAcceleration PlaybackIMU::getYAcceleration() { return from_mps2(get(IMU_FIELD_Y_ACCELERATION)); }
+
+LinearAcceleration PlaybackIMU::getZAcceleration() { return from_mps2(get(IMU_FIELD_Z_ACCELERATION)); }
+
+IMUOrientation PlaybackIMU::getOrientation() {
+    return static_cast<IMUOrientation>(get(IMU_FIELD_ORIENTATION, static_cast<int>(IMUOrientation::Z_UP)));
+}
+
+double PlaybackIMU::get(int field, double fallback) {
+    return log->getValue(sensorChannel(id, field), clock()).value_or(fallback);
+}
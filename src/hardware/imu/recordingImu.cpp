@@ -0,0 +1,62 @@
+#include "hardware/imu/recordingImu.hpp"
+
+RecordingIMU::RecordingIMU(std::shared_ptr<IMU> imu, std::shared_ptr<SensorLogWriter> log, int id)
+    : imu(imu),
+      log(log),
+      id(id) {}
+
+void RecordingIMU::calibrate() { imu->calibrate(); }
+
+int RecordingIMU::getStatus() {
+    const int status = imu->getStatus();
+    log->write(sensorChannel(id, IMU_FIELD_STATUS), status);
+    return status;
+}
+
+Angle RecordingIMU::getRotation() { return record(IMU_FIELD_ROTATION, imu->getRotation()); }
+
+Angle RecordingIMU::getYaw() { return record(IMU_FIELD_YAW, imu->getYaw()); }
+
+void RecordingIMU::setYaw(Angle angle) { imu->setYaw(angle); }
+
+AngularVelocity RecordingIMU::getAngularVelocity() {
+    const AngularVelocity velocity = imu->getAngularVelocity();
+    log->write(sensorChannel(id, IMU_FIELD_ANGULAR_VELOCITY), to_radps(velocity));
+    return velocity;
+}
+
+Angle RecordingIMU::getPitch() { return record(IMU_FIELD_PITCH, imu->getPitch()); }
+
+void RecordingIMU::setPitch(Angle angle) { imu->setPitch(angle); }
+
+Angle RecordingIMU::getRoll() { return record(IMU_FIELD_ROLL, imu->getRoll()); }
+
+void RecordingIMU::setRoll(Angle angle) { imu->setRoll(angle); }
+
+LinearAcceleration RecordingIMU::getXAcceleration() {
+    return record(IMU_FIELD_X_ACCELERATION, imu->getXAcceleration());
+}
+
+LinearAcceleration RecordingIMU::getYAcceleration() {
+    return record(IMU_FIELD_Y_ACCELERATION, imu->getYAcceleration());
+}
+
+LinearAcceleration RecordingIMU::getZAcceleration() {
+    return record(IMU_FIELD_Z_ACCELERATION, imu->getZAcceleration());
+}
+
+IMUOrientation RecordingIMU::getOrientation() {
+    const IMUOrientation orientation = imu->getOrientation();
+    log->write(sensorChannel(id, IMU_FIELD_ORIENTATION), static_cast<int>(orientation));
+    return orientation;
+}
+
+Angle RecordingIMU::record(int field, Angle angle) {
+    log->write(sensorChannel(id, field), to_sRad(angle));
+    return angle;
+}
+
+LinearAcceleration RecordingIMU::record(int field, LinearAcceleration acceleration) {
+    log->write(sensorChannel(id, field), to_mps2(acceleration));
+    return acceleration;
+}
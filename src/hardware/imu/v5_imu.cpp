@@ -9,7 +9,15 @@ V5IMU::V5IMU(int port)
 V5IMU::V5IMU(pros::Imu* imu)
     : imu(imu) {}
 
-void V5IMU::calibrate() { imu->reset(); }
+void V5IMU::calibrate() {
+    imu->reset();
+    rotationReading.invalidate();
+    yawReading.invalidate();
+    pitchReading.invalidate();
+    rollReading.invalidate();
+    accelReading.invalidate();
+    gyroReading.invalidate();
+}
 
 int V5IMU::getStatus() {
     const pros::ImuStatus status = imu->get_status();
@@ -20,25 +28,48 @@ int V5IMU::getStatus() {
     }
 }
 
-Angle V5IMU::getRotation() { return from_cdeg(imu->get_rotation()); }
+Angle V5IMU::getRotation() {
+    return from_cdeg(rotationReading.get([this] { return imu->get_rotation(); }));
+}
 
-Angle V5IMU::getYaw() { return from_cdeg(imu->get_yaw()); }
+Angle V5IMU::getYaw() { return from_cdeg(yawReading.get([this] { return imu->get_yaw(); })); }
 
-void V5IMU::setYaw(Angle angle) { imu->set_yaw(to_cDeg(angle)); }
+void V5IMU::setYaw(Angle angle) {
+    imu->set_yaw(to_cDeg(angle));
+    yawReading.invalidate();
+    rotationReading.invalidate();
+}
+
+AngularVelocity V5IMU::getAngularVelocity() {
+    // the z axis points up, so the gyro measures counterclockwise rotation as positive
+    return from_degps(gyroReading.get([this] { return imu->get_gyro_rate(); }).z);
+}
 
-Angle V5IMU::getPitch() { return from_cdeg(imu->get_pitch()); }
+Angle V5IMU::getPitch() { return from_cdeg(pitchReading.get([this] { return imu->get_pitch(); })); }
 
-void V5IMU::setPitch(Angle angle) { imu->set_pitch(to_cDeg(angle)); }
+void V5IMU::setPitch(Angle angle) {
+    imu->set_pitch(to_cDeg(angle));
+    pitchReading.invalidate();
+}
 
-Angle V5IMU::getRoll() { return from_cdeg(imu->get_roll()); }
+Angle V5IMU::getRoll() { return from_cdeg(rollReading.get([this] { return imu->get_roll(); })); }
 
-void V5IMU::setRoll(Angle angle) { imu->set_roll(to_cDeg(angle)); }
+void V5IMU::setRoll(Angle angle) {
+    imu->set_roll(to_cDeg(angle));
+    rollReading.invalidate();
+}
 
-LinearAcceleration V5IMU::getXAcceleration() { return (imu->get_accel().x); }
+LinearAcceleration V5IMU::getXAcceleration() {
+    return accelReading.get([this] { return imu->get_accel(); }).x;
+}
 
-LinearAcceleration V5IMU::getYAcceleration() { return (imu->get_accel().y); }
+LinearAcceleration V5IMU::getYAcceleration() {
+    return accelReading.get([this] { return imu->get_accel(); }).y;
+}
 
-LinearAcceleration V5IMU::getZAcceleration() { return (imu->get_accel().z); }
+LinearAcceleration V5IMU::getZAcceleration() {
+    return accelReading.get([this] { return imu->get_accel(); }).z;
+}
 
 IMUOrientation V5IMU::getOrientation() {
     const pros::imu_orientation_e_t orientation = imu->get_physical_orientation();
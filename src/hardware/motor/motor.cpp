@@ -0,0 +1,60 @@
+#include "hardware/motor/motor.hpp"
+#include "pros/motors.h"
+#include <algorithm>
+
+Motor::Motor(int port, Cartridge cartridge, double gearRatio)
+    : port(port),
+      cartridge(cartridge),
+      gearRatio(gearRatio) {
+    // positions are always read in degrees, so they don't depend on the cartridge
+    pros::c::motor_set_encoder_units(port, pros::E_MOTOR_ENCODER_DEGREES);
+    switch (cartridge) {
+        case Cartridge::RED: pros::c::motor_set_gearing(port, pros::E_MOTOR_GEARSET_36); break;
+        case Cartridge::GREEN: pros::c::motor_set_gearing(port, pros::E_MOTOR_GEARSET_18); break;
+        case Cartridge::BLUE: pros::c::motor_set_gearing(port, pros::E_MOTOR_GEARSET_06); break;
+    }
+}
+
+void Motor::moveVoltage(Voltage voltage) {
+    // convert to millivolts, and clamp to the range the motor accepts
+    pros::c::motor_move_voltage(port, std::clamp(to_volt(voltage) * 1000, -12000.0, 12000.0));
+}
+
+void Motor::moveVelocity(AngularVelocity velocity) {
+    // the motor's velocity controller takes the velocity of the cartridge output in rpm
+    pros::c::motor_move_velocity(port, std::round(to_rpm(velocity) / gearRatio));
+}
+
+MotorTelemetry Motor::getTelemetry() {
+    return telemetry.get(
+        [this]() -> MotorTelemetry {
+            return {from_sdeg(pros::c::motor_get_position(port) * gearRatio),
+                    from_rpm(pros::c::motor_get_actual_velocity(port) * gearRatio),
+                    from_volt(pros::c::motor_get_voltage(port) / 1000.0),
+                    from_amp(pros::c::motor_get_current_draw(port) / 1000.0), pros::c::motor_get_temperature(port)};
+        },
+        5);
+}
+
+Angle Motor::getPosition() { return getTelemetry().position; }
+
+AngularVelocity Motor::getVelocity() { return getTelemetry().velocity; }
+
+Voltage Motor::getVoltage() { return getTelemetry().voltage; }
+
+Current Motor::getCurrent() { return getTelemetry().current; }
+
+double Motor::getTemperature() { return getTelemetry().temperature; }
+
+void Motor::tare() {
+    pros::c::motor_tare_position(port);
+    telemetry.invalidate();
+}
+
+AngularVelocity Motor::getMaxVelocity() const { return from_rpm(static_cast<int>(cartridge) * gearRatio); }
+
+Cartridge Motor::getCartridge() const { return cartridge; }
+
+double Motor::getGearRatio() const { return gearRatio; }
+
+int Motor::getPort() const { return port; }
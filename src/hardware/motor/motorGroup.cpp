@@ -0,0 +1,59 @@
+#include "hardware/motor/motorGroup.hpp"
+#include <algorithm>
+
+MotorGroup::MotorGroup(std::initializer_list<int> ports, Cartridge cartridge, double gearRatio) {
+    motors.reserve(ports.size());
+    for (const int port : ports) motors.emplace_back(port, cartridge, gearRatio);
+}
+
+void MotorGroup::moveVoltage(Voltage voltage) {
+    for (Motor& motor : motors) motor.moveVoltage(voltage);
+}
+
+void MotorGroup::moveVelocity(AngularVelocity velocity) {
+    for (Motor& motor : motors) motor.moveVelocity(velocity);
+}
+
+Angle MotorGroup::getPosition() {
+    if (motors.empty()) return 0_stRad;
+    Angle sum = 0_stRad;
+    for (Motor& motor : motors) sum += motor.getPosition();
+    return sum / motors.size();
+}
+
+AngularVelocity MotorGroup::getVelocity() {
+    if (motors.empty()) return 0_radps;
+    AngularVelocity sum = 0_radps;
+    for (Motor& motor : motors) sum += motor.getVelocity();
+    return sum / motors.size();
+}
+
+Voltage MotorGroup::getVoltage() {
+    if (motors.empty()) return 0_volt;
+    Voltage sum = 0_volt;
+    for (Motor& motor : motors) sum += motor.getVoltage();
+    return sum / motors.size();
+}
+
+Current MotorGroup::getCurrent() {
+    Current sum = 0_amp;
+    for (Motor& motor : motors) sum += motor.getCurrent();
+    return sum;
+}
+
+double MotorGroup::getTemperature() {
+    double hottest = 0;
+    for (Motor& motor : motors) hottest = std::max(hottest, motor.getTemperature());
+    return hottest;
+}
+
+void MotorGroup::tare() {
+    for (Motor& motor : motors) motor.tare();
+}
+
+AngularVelocity MotorGroup::getMaxVelocity() const {
+    if (motors.empty()) return 0_radps;
+    return motors.front().getMaxVelocity();
+}
+
+std::vector<Motor>& MotorGroup::getMotors() { return motors; }
@@ -0,0 +1,111 @@
+#include "hardware/motor/thermalModel.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+constexpr Time AVERAGING_WINDOW = 2_sec; // time constant of the low pass filter on the current of each motor
+
+MotorThermalModel::MotorThermalModel(ThermalParameters parameters)
+    : parameters(parameters) {}
+
+void MotorThermalModel::update(Current current, double measuredTemperature, Time dt) {
+    // initialize the estimate with the first measurement
+    if (temperature == std::nullopt) temperature = std::max(measuredTemperature, parameters.ambientTemperature);
+    // heat from the power lost in the windings, cooling proportional to the temperature above ambient
+    const double power = std::pow(to_amp(current), 2) * parameters.windingResistance;
+    const double cooling = (temperature.value() - parameters.ambientTemperature) / parameters.thermalResistance;
+    temperature = temperature.value() + (power - cooling) / parameters.thermalCapacitance * to_sec(dt);
+    // correct the estimate with the measured temperature, at a rate which doesn't depend on the update period
+    const double correction = 1 - std::exp(-parameters.observerGain * to_sec(dt));
+    temperature = temperature.value() + correction * (measuredTemperature - temperature.value());
+}
+
+double MotorThermalModel::getTemperature() const { return temperature.value_or(parameters.ambientTemperature); }
+
+double MotorThermalModel::predictTemperature(Current current, Time time) const {
+    // the solution of the first order model is an exponential approach to the steady state temperature
+    const double tau = getTimeConstant();
+    const double steadyState = getSteadyStateTemperature(current);
+    return steadyState + (getTemperature() - steadyState) * std::exp(-to_sec(time) / tau);
+}
+
+std::optional<Time> MotorThermalModel::getTimeToDerate(Current current) const {
+    const double tau = getTimeConstant();
+    const double steadyState = getSteadyStateTemperature(current);
+    if (getTemperature() >= parameters.derateTemperature) return 0_sec;
+    if (steadyState <= parameters.derateTemperature) return std::nullopt; // the motor never gets hot enough
+    return from_sec(-tau * std::log((parameters.derateTemperature - steadyState) / (getTemperature() - steadyState)));
+}
+
+Current MotorThermalModel::getSustainableCurrent(Time time) const {
+    const double decay = std::exp(-to_sec(time) / getTimeConstant());
+    if (decay >= 1) return std::numeric_limits<double>::infinity();
+    // find the steady state temperature which reaches the derate temperature exactly at the end of the period
+    const double maxSteadyState = (parameters.derateTemperature - getTemperature() * decay) / (1 - decay);
+    const double maxPower = (maxSteadyState - parameters.ambientTemperature) / parameters.thermalResistance;
+    if (maxPower <= 0) return 0_amp;
+    return from_amp(std::sqrt(maxPower / parameters.windingResistance));
+}
+
+double MotorThermalModel::getCurrentLimitScale() const {
+    const double above = getTemperature() - parameters.derateTemperature;
+    if (above < 0) return 1;
+    const int halvings = 1 + int(std::floor(above / parameters.derateStep));
+    if (halvings > parameters.derateSteps) return 0;
+    return std::ldexp(1.0, -halvings);
+}
+
+void MotorThermalModel::reset(double temperature) { this->temperature = temperature; }
+
+double MotorThermalModel::getTimeConstant() const {
+    return parameters.thermalResistance * parameters.thermalCapacitance;
+}
+
+double MotorThermalModel::getSteadyStateTemperature(Current current) const {
+    const double power = std::pow(to_amp(current), 2) * parameters.windingResistance;
+    return parameters.ambientTemperature + power * parameters.thermalResistance;
+}
+
+PowerBudget::PowerBudget(std::vector<std::shared_ptr<MotorGroup>> groups, Time duration, ThermalParameters parameters)
+    : groups(groups),
+      timer(duration) {
+    for (const std::shared_ptr<MotorGroup>& group : groups) {
+        for (size_t i = 0; i < group->getMotors().size(); i++) {
+            models.emplace_back(parameters);
+            averageCurrents.push_back(0);
+        }
+    }
+}
+
+void PowerBudget::start() {
+    timer.reset();
+    lastTime = std::nullopt;
+}
+
+void PowerBudget::update() {
+    const Time now = Timer::now();
+    const Time dt = (lastTime == std::nullopt) ? 0_sec : now - lastTime.value();
+    lastTime = now;
+    const Time remaining = timer.getTimeLeft();
+    const double filterGain = std::min(1.0, (dt / AVERAGING_WINDOW).val());
+    double newBudget = 1;
+    size_t i = 0;
+    for (const std::shared_ptr<MotorGroup>& group : groups) {
+        for (Motor& motor : group->getMotors()) {
+            const Current current = motor.getCurrent();
+            models[i].update(current, motor.getTemperature(), dt);
+            averageCurrents[i] += (to_amp(current) - averageCurrents[i]) * filterGain;
+            // scale the current the motor is drawing down to what it can sustain until the end of the period
+            // current is roughly proportional to torque, so scaling the maximum velocity scales it similarly
+            const double sustainable = to_amp(models[i].getSustainableCurrent(remaining));
+            if (averageCurrents[i] > 0.1) newBudget = std::min(newBudget, sustainable / averageCurrents[i]);
+            newBudget = std::min(newBudget, models[i].getCurrentLimitScale());
+            i++;
+        }
+    }
+    budget = std::clamp(newBudget, 0.0, 1.0);
+}
+
+double PowerBudget::getBudget() const { return budget; }
+
+const std::vector<MotorThermalModel>& PowerBudget::getModels() const { return models; }
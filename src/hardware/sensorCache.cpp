@@ -0,0 +1,20 @@
+#include "hardware/sensorCache.hpp"
+#include <atomic>
+
+static std::atomic<uint32_t> tick = 0; /** the current tick, 0 if caching is disabled */
+static std::atomic<int> deviceCalls = 0; /** device calls made during the current tick */
+static std::atomic<int> lastTickDeviceCalls = 0; /** device calls made during the previous tick */
+
+void SensorCache::invalidate() {
+    lastTickDeviceCalls = deviceCalls.exchange(0);
+    // skip 0 when the tick counter wraps around, since 0 disables caching
+    if (++tick == 0) ++tick;
+}
+
+uint32_t SensorCache::getTick() { return tick; }
+
+void SensorCache::recordDeviceCall(int calls) { deviceCalls += calls; }
+
+int SensorCache::getDeviceCalls() { return deviceCalls; }
+
+int SensorCache::getLastTickDeviceCalls() { return lastTickDeviceCalls; }
@@ -0,0 +1,88 @@
+#include "hardware/sensorLog.hpp"
+#include "timer.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+constexpr char HEADER[5] = {'S', 'L', 'O', 'G', 2}; // magic number identifying a sensor log, and the format version
+constexpr size_t RECORD_SIZE = 17; // channel, time and value
+constexpr size_t V1_RECORD_SIZE = 13; // the first version stored the time in 4 bytes
+
+// both the brain and the hosts we run on are little endian, so values are copied as they are in memory
+SensorLogWriter::SensorLogWriter(std::unique_ptr<std::ostream> stream, size_t bufferSize)
+    : stream(std::move(stream)),
+      bufferSize(bufferSize) {
+    buffer.reserve(bufferSize + RECORD_SIZE);
+    buffer.assign(HEADER, HEADER + sizeof(HEADER));
+}
+
+void SensorLogWriter::write(uint8_t channel, double value) {
+    // only record changes, so reading a sensor several times doesn't grow the log
+    if (lastValues[channel] == value) return;
+    lastValues[channel] = value;
+    const int64_t time = std::llround(to_us(Timer::now()));
+    const size_t offset = buffer.size();
+    buffer.resize(offset + RECORD_SIZE);
+    buffer[offset] = channel;
+    std::memcpy(&buffer[offset + 1], &time, sizeof(time));
+    std::memcpy(&buffer[offset + 9], &value, sizeof(value));
+    if (buffer.size() >= bufferSize) flush();
+}
+
+void SensorLogWriter::flush() {
+    stream->write(buffer.data(), buffer.size());
+    stream->flush();
+    buffer.clear();
+}
+
+SensorLogWriter::~SensorLogWriter() { flush(); }
+
+SensorLogReader::SensorLogReader(std::istream& stream) {
+    // check the header. The last byte is the version
+    char header[sizeof(HEADER)];
+    if (!stream.read(header, sizeof(header)) || std::memcmp(header, HEADER, sizeof(HEADER) - 1) != 0) return;
+    const bool v1 = header[sizeof(HEADER) - 1] == 1;
+    if (!v1 && header[sizeof(HEADER) - 1] != HEADER[sizeof(HEADER) - 1]) return;
+    valid = true;
+    // read records until the end of the stream, ignoring a truncated record at the end
+    const size_t recordSize = v1 ? V1_RECORD_SIZE : RECORD_SIZE;
+    char record[RECORD_SIZE];
+    uint32_t prevTime = 0; /** the last 4 byte time of a first version log */
+    int64_t wraps = 0; /** how many times the 4 byte time of a first version log overflowed */
+    while (stream.read(record, recordSize)) {
+        int64_t time;
+        double value;
+        if (v1) {
+            // records are written in order, so a time before the previous one means the time overflowed
+            uint32_t shortTime;
+            std::memcpy(&shortTime, record + 1, sizeof(shortTime));
+            if (shortTime < prevTime) wraps++;
+            prevTime = shortTime;
+            time = (wraps << 32) + shortTime;
+            std::memcpy(&value, record + 5, sizeof(value));
+        } else {
+            std::memcpy(&time, record + 1, sizeof(time));
+            std::memcpy(&value, record + 9, sizeof(value));
+        }
+        const SensorSample sample = {from_us(time), value};
+        channels[uint8_t(record[0])].push_back(sample);
+        endTime = std::max(endTime, sample.time);
+    }
+}
+
+bool SensorLogReader::isValid() const { return valid; }
+
+const std::vector<SensorSample>& SensorLogReader::getSamples(uint8_t channel) const { return channels[channel]; }
+
+std::optional<double> SensorLogReader::getValue(uint8_t channel, Time time) const {
+    const std::vector<SensorSample>& samples = channels[channel];
+    // round the time to the resolution of the log, so a value is found at exactly the time it was recorded
+    const Time query = from_us(std::llround(to_us(time)));
+    // find the first sample after the time, the one before it is the value at that time
+    const auto after = std::upper_bound(samples.begin(), samples.end(), query,
+                                        [](Time time, const SensorSample& sample) { return time < sample.time; });
+    if (after == samples.begin()) return std::nullopt;
+    return std::prev(after)->value;
+}
+
+Time SensorLogReader::getEndTime() const { return endTime; }
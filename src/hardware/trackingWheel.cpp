@@ -5,7 +5,22 @@ TrackingWheel::TrackingWheel(std::shared_ptr<Encoder> encoder, Length radius, Le
       radius(radius),
       offset(offset) {}
 
-Length TrackingWheel::getDistance() { return to_sDeg(encoder->getPosition()) * radius; }
+Length TrackingWheel::getDistance() { return getTicks() * getDistancePerTick(); }
+
+int64_t TrackingWheel::getTicks() { return encoder->getTicks(); }
+
+Length TrackingWheel::getDistancePerTick() {
+    const Angle angle = encoder->getTickAngle();
+    if (angle != tickAngle) {
+        tickAngle = angle;
+        distancePerTick = to_sRad(angle) * radius;
+    }
+    return distancePerTick;
+}
+
+LinearVelocity TrackingWheel::getVelocity() { return to_radps(encoder->getVelocity()) * radius / sec; }
+
+int TrackingWheel::getStatus() { return encoder->getStatus(); }
 
 Length TrackingWheel::getOffset() { return offset; }
 
@@ -0,0 +1,83 @@
+#include "motion/autotune.hpp"
+#include "timer.hpp"
+#include <algorithm>
+#include <cmath>
+
+AutotuneMotion::AutotuneMotion(int loop, std::shared_ptr<MotorGroup> leftDrive, std::shared_ptr<MotorGroup> rightDrive,
+                               Length wheelDiameter, AutotuneSettings settings,
+                               std::shared_ptr<std::optional<RelayResult>> result)
+    : loop(loop),
+      leftDrive(leftDrive),
+      rightDrive(rightDrive),
+      wheelDiameter(wheelDiameter),
+      settings(settings),
+      result(result) {}
+
+ChassisSpeeds AutotuneMotion::update(units::Pose pose) {
+    const Time now = Timer::now();
+    if (startTime == std::nullopt) {
+        startTime = now;
+        startPose = pose;
+    }
+    if (now - *startTime > settings.timeout) {
+        running = false;
+        return {false, 0_mps, 0_mps, 0, 0};
+    }
+    // calculate the error of the loop, in meters, radians or meters per second
+    double error;
+    if (loop == AUTOTUNE_ANGULAR_POSITION) {
+        error = to_sRad(startPose->getTheta() - pose.getTheta());
+    } else if (loop == AUTOTUNE_WHEEL_VELOCITY) {
+        const Length radius = wheelDiameter / 2;
+        const LinearVelocity velocity =
+            (to_radps(leftDrive->getVelocity()) + to_radps(rightDrive->getVelocity())) / 2 * radius / sec;
+        error = to_mps(settings.velocityTarget - velocity);
+    } else {
+        // distance driven along the starting heading
+        const Angle theta = startPose->getTheta();
+        const Length driven = (pose.getX() - startPose->getX()) * units::cos(theta) +
+                              (pose.getY() - startPose->getY()) * units::sin(theta);
+        error = -to_m(driven);
+    }
+    // measure the noise of the loop while the robot is still, and keep the relay from switching on it
+    if (hysteresis == std::nullopt) {
+        noiseSum += error;
+        noiseSquares += error * error;
+        noiseSamples++;
+        if (now - *startTime < settings.noiseTime) return {false, 0_mps, 0_mps, 0, 0};
+        const double mean = noiseSum / noiseSamples;
+        const double deviation = std::sqrt(std::max(noiseSquares / noiseSamples - mean * mean, 0.0));
+        hysteresis = std::max(settings.hysteresis, settings.noiseHysteresis * deviation);
+        rampStart = now;
+        // position loops hold their target with no voltage, so their relay starts right away
+        if (loop != AUTOTUNE_WHEEL_VELOCITY)
+            relay.emplace(to_volt(settings.relayVoltage), *hysteresis, settings.cycles, settings.warmupCycles);
+    }
+    double voltage;
+    if (relay == std::nullopt) {
+        // ramp up the velocity loop, and start the relay from the voltage that reached the target
+        voltage = settings.rampRate * to_sec(now - *rampStart);
+        if (error <= 0)
+            relay.emplace(to_volt(settings.relayVoltage), *hysteresis, settings.cycles, settings.warmupCycles, voltage);
+    } else {
+        voltage = relay->update(error, now);
+        if (relay->isDone()) {
+            *result = relay->getResult();
+            running = false;
+            return {false, 0_mps, 0_mps, 0, 0};
+        }
+    }
+    // angular oscillation turns in place, positive counterclockwise
+    double left = (loop == AUTOTUNE_ANGULAR_POSITION) ? -voltage : voltage;
+    double right = voltage;
+    // cancel the static friction of each side in the direction it moves
+    if (loop != AUTOTUNE_WHEEL_VELOCITY) {
+        const auto friction = [&](AngularVelocity velocity) {
+            if (velocity == 0_radps) return 0.0;
+            return velocity > 0_radps ? settings.kS : -settings.kS;
+        };
+        left += friction(leftDrive->getVelocity());
+        right += friction(rightDrive->getVelocity());
+    }
+    return {false, 0_mps, 0_mps, std::clamp(left / 12, -1.0, 1.0), std::clamp(right / 12, -1.0, 1.0)};
+}
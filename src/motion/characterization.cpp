@@ -0,0 +1,45 @@
+#include "motion/characterization.hpp"
+#include "timer.hpp"
+
+CharacterizationMotion::CharacterizationMotion(int test, int run, bool reversed, std::shared_ptr<MotorGroup> leftDrive,
+                                               std::shared_ptr<MotorGroup> rightDrive, Length wheelDiameter,
+                                               SysIdSettings settings,
+                                               std::shared_ptr<std::vector<SysIdSample>> samples)
+    : test(test),
+      run(run),
+      reversed(reversed),
+      leftDrive(leftDrive),
+      rightDrive(rightDrive),
+      wheelDiameter(wheelDiameter),
+      settings(settings),
+      samples(samples) {}
+
+ChassisSpeeds CharacterizationMotion::update(units::Pose pose) {
+    const Time now = Timer::now();
+    const bool angular = test == SYSID_QUASISTATIC_ANGULAR || test == SYSID_DYNAMIC_ANGULAR;
+    // the sign of each side. Angular tests turn counterclockwise, so the left side drives backwards
+    const double direction = reversed ? -1 : 1;
+    const double leftSign = angular ? -direction : direction;
+    const double rightSign = direction;
+    if (startTime == std::nullopt) {
+        startTime = now;
+        startPose = pose;
+    } else {
+        // record the response to the voltage applied on the last update
+        samples->push_back({test, run, now, lastVoltage * leftSign, lastVoltage * rightSign,
+                            to_radps(leftDrive->getVelocity()) * wheelDiameter / 2 / sec,
+                            to_radps(rightDrive->getVelocity()) * wheelDiameter / 2 / sec, pose.getTheta()});
+    }
+    // calculate the voltage for the next update, and stop when the test is done
+    const Time elapsed = now - *startTime;
+    const bool quasistatic = test == SYSID_QUASISTATIC_LINEAR || test == SYSID_QUASISTATIC_ANGULAR;
+    const Voltage voltage = quasistatic ? from_volt(settings.rampRate * to_sec(elapsed)) : settings.maxVoltage;
+    const Length distance = units::hypot(pose.getX() - startPose->getX(), pose.getY() - startPose->getY());
+    if ((quasistatic && voltage > settings.maxVoltage) || (!quasistatic && elapsed > settings.dynamicDuration) ||
+        (!angular && distance > settings.maxDistance)) {
+        running = false;
+        return {false, 0_mps, 0_mps, 0, 0};
+    }
+    lastVoltage = voltage;
+    return {false, 0_mps, 0_mps, leftSign * to_volt(voltage) / 12, rightSign * to_volt(voltage) / 12};
+}
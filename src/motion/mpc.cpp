@@ -0,0 +1,165 @@
+#include "motion/mpc.hpp"
+#include "timer.hpp"
+#include <algorithm>
+#include <array>
+#include <cmath>
+
+MPCMotion::MPCMotion(Trajectory trajectory, FeedforwardGains linear, FeedforwardGains angular,
+                     std::shared_ptr<MotorGroup> leftDrive, std::shared_ptr<MotorGroup> rightDrive,
+                     Length wheelDiameter, Length trackWidth, MPCSettings settings, std::shared_ptr<ILC> learning)
+    : trajectory(std::move(trajectory)),
+      linear(linear),
+      angular(angular),
+      leftDrive(leftDrive),
+      rightDrive(rightDrive),
+      wheelDiameter(wheelDiameter),
+      trackWidth(trackWidth),
+      settings(settings),
+      learning(learning),
+      solver(settings.solver) {
+    // the model needs the robot to have inertia, so a characterization without kA can't be followed
+    if (linear.kA <= 0 || angular.kA <= 0) {
+        running = false;
+        return;
+    }
+    const auto [a, b] = driveModel(linear, angular);
+    const auto [discreteA, discreteB] = discretize(a, b, settings.step);
+    wheelA = discreteA;
+    wheelB = discreteB;
+    wheelBInverse = inverse(discreteB).value_or(Matrix<2, 2> {});
+}
+
+ChassisSpeeds MPCMotion::update(units::Pose pose) {
+    const Time now = Timer::now();
+    if (startTime == std::nullopt) {
+        startTime = now;
+        // errors recorded by an interrupted run aren't learned from
+        if (learning != nullptr) learning->discard();
+    }
+    const Time elapsed = now - *startTime;
+    if (!running || elapsed > trajectory.getDuration()) {
+        if (running && learning != nullptr) learning->learn();
+        running = false;
+        return {false, 0_mps, 0_mps, 0, 0};
+    }
+    const double dt = to_sec(settings.step);
+    const double width = to_m(trackWidth);
+    // the trajectory and the velocities of its wheels at every step of the horizon
+    std::array<TrajectoryPoint, MPC_HORIZON + 1> reference;
+    std::array<std::array<double, 2>, MPC_HORIZON + 1> wheels;
+    std::array<double, MPC_HORIZON + 1> friction; // kS of the sides, like DriveLQR
+    for (size_t k = 0; k <= MPC_HORIZON; k++) {
+        reference[k] = trajectory.sample(elapsed + settings.step * double(k));
+        const double velocity = to_mps(reference[k].velocity);
+        const double turn = to_radps(reference[k].angularVelocity) * width / 2;
+        wheels[k] = {velocity - turn, velocity + turn};
+        friction[k] = driveFriction(linear, angular, velocity, turn);
+    }
+    // feedforward voltages which keep the robot on the trajectory, by inverting the model of the wheels
+    std::array<std::array<double, 2>, MPC_HORIZON> feedforward;
+    for (size_t k = 0; k < MPC_HORIZON; k++) {
+        Matrix<2, 1> change;
+        for (size_t side = 0; side < 2; side++)
+            change(side, 0) = wheels[k + 1][side] - wheelA(side, 0) * wheels[k][0] - wheelA(side, 1) * wheels[k][1];
+        const Matrix<2, 1> voltage = wheelBInverse * change;
+        for (size_t side = 0; side < 2; side++) {
+            const double kS = (wheels[k + 1][side] == 0) ? 0 : std::copysign(friction[k + 1], wheels[k + 1][side]);
+            feedforward[k][side] = voltage(side, 0) + kS;
+        }
+        // the model doesn't know about the disturbances the corrections cancel, so they're part of the feedforward
+        if (learning != nullptr) {
+            const auto [left, right] = learning->correction(elapsed + settings.step * double(k));
+            feedforward[k][0] += left;
+            feedforward[k][1] += right;
+        }
+    }
+    // the current error, in the frame of the trajectory
+    units::Pose start = reference[0].pose;
+    const double theta = to_sRad(start.getTheta());
+    const double dx = to_m(pose.getX() - start.getX());
+    const double dy = to_m(pose.getY() - start.getY());
+    const double radius = to_m(wheelDiameter) / 2;
+    Matrix<STATES, 1> error;
+    error.data = {{{std::cos(theta) * dx + std::sin(theta) * dy},
+                   {-std::sin(theta) * dx + std::cos(theta) * dy},
+                   {to_sRad(pose.getTheta() - start.getTheta())},
+                   {to_radps(leftDrive->getVelocity()) * radius - wheels[0][0]},
+                   {to_radps(rightDrive->getVelocity()) * radius - wheels[0][1]}}};
+    // a side is behind when the robot is behind or turned away from it
+    if (learning != nullptr)
+        learning->record(elapsed, -error(0, 0) + error(2, 0) * width / 2, -error(0, 0) - error(2, 0) * width / 2,
+                         -error(3, 0), -error(4, 0));
+    const auto square = [](double x) { return x * x; };
+    const std::array<double, STATES> weights = {
+        1 / square(to_m(settings.maxAlongTrackError)), 1 / square(to_m(settings.maxCrossTrackError)),
+        1 / square(to_sRad(settings.maxHeadingError)), 1 / square(to_mps(settings.maxVelocityError)),
+        1 / square(to_mps(settings.maxVelocityError))};
+    // build the problem step by step. The error at step k is free + response * corrections, where free is the error
+    // if the feedforward voltages were applied without corrections
+    hessian = Matrix<VARIABLES, VARIABLES>::identity() * (1 / square(settings.maxVoltageCorrection));
+    gradient = {};
+    constraints = {};
+    response = {};
+    Matrix<STATES, 1> free = error;
+    for (size_t k = 0; k < MPC_HORIZON; k++) {
+        // the error dynamics, linearized around the trajectory, with the wheels from the model
+        const double velocity = to_mps(reference[k].velocity);
+        const double angularVelocity = to_radps(reference[k].angularVelocity);
+        Matrix<STATES, STATES> f = Matrix<STATES, STATES>::identity();
+        f(0, 1) = angularVelocity * dt;
+        f(0, 3) = dt / 2;
+        f(0, 4) = dt / 2;
+        f(1, 0) = -angularVelocity * dt;
+        f(1, 2) = velocity * dt;
+        f(2, 3) = -dt / width;
+        f(2, 4) = dt / width;
+        for (size_t i = 0; i < 2; i++)
+            for (size_t j = 0; j < 2; j++) f(3 + i, 3 + j) = wheelA(i, j);
+        lastResponse = response;
+        const Matrix<STATES, 1> lastFree = free;
+        response = f * response;
+        for (size_t i = 0; i < 2; i++)
+            for (size_t j = 0; j < 2; j++) response(3 + i, 2 * k + j) += wheelB(i, j);
+        free = f * free;
+        // add the cost of the error at the next step
+        for (size_t i = 0; i < VARIABLES; i++) {
+            for (size_t s = 0; s < STATES; s++) {
+                const double weighted = weights[s] * response(s, i);
+                if (weighted == 0) continue;
+                gradient(i, 0) += weighted * free(s, 0);
+                for (size_t j = 0; j <= i; j++) hessian(i, j) += weighted * response(s, j);
+            }
+        }
+        for (size_t side = 0; side < 2; side++) {
+            // limit the voltage
+            const size_t voltageRow = 2 * k + side;
+            constraints(voltageRow, voltageRow) = 1;
+            lower(voltageRow, 0) = -settings.maxVoltage - feedforward[k][side];
+            upper(voltageRow, 0) = settings.maxVoltage - feedforward[k][side];
+            // limit the acceleration over the step. The row is normalized, so it has the same scale as the voltages
+            const size_t accelerationRow = VARIABLES + 2 * k + side;
+            double norm = 0;
+            for (size_t j = 0; j < VARIABLES; j++) {
+                constraints(accelerationRow, j) = (response(3 + side, j) - lastResponse(3 + side, j)) / dt;
+                norm += square(constraints(accelerationRow, j));
+            }
+            norm = std::sqrt(norm);
+            const double acceleration =
+                (wheels[k + 1][side] - wheels[k][side] + free(3 + side, 0) - lastFree(3 + side, 0)) / dt;
+            for (size_t j = 0; j < VARIABLES; j++) constraints(accelerationRow, j) /= norm;
+            lower(accelerationRow, 0) = (-to_mps2(settings.maxAcceleration) - acceleration) / norm;
+            upper(accelerationRow, 0) = (to_mps2(settings.maxAcceleration) - acceleration) / norm;
+        }
+    }
+    for (size_t i = 0; i < VARIABLES; i++)
+        for (size_t j = 0; j < i; j++) hessian(j, i) = hessian(i, j);
+    // solve, starting from the last solution, and apply the voltages of the first step
+    stats = solver.solve(hessian, gradient, constraints, lower, upper);
+    const double left =
+        std::clamp(feedforward[0][0] + solver.solution(0, 0), -settings.maxVoltage, settings.maxVoltage);
+    const double right =
+        std::clamp(feedforward[0][1] + solver.solution(1, 0), -settings.maxVoltage, settings.maxVoltage);
+    return {false, 0_mps, 0_mps, left / 12, right / 12};
+}
+
+QPResult MPCMotion::getStats() const { return stats; }
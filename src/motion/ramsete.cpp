@@ -0,0 +1,50 @@
+#include "motion/ramsete.hpp"
+#include "timer.hpp"
+#include <cmath>
+
+// time over which the acceleration of the trajectory is measured
+constexpr Time ACCELERATION_STEP = 10_ms;
+
+RamseteMotion::RamseteMotion(Trajectory trajectory, Length trackWidth, RamseteSettings settings)
+    : trajectory(std::move(trajectory)),
+      trackWidth(trackWidth),
+      settings(settings) {}
+
+ChassisSpeeds RamseteMotion::update(units::Pose pose) {
+    const Time now = Timer::now();
+    if (startTime == std::nullopt) startTime = now;
+    const Time elapsed = now - *startTime;
+    if (!running || elapsed > trajectory.getDuration()) {
+        running = false;
+        return {true, 0_mps, 0_mps, 0, 0};
+    }
+    TrajectoryPoint reference = trajectory.sample(elapsed);
+    const TrajectoryPoint next = trajectory.sample(elapsed + ACCELERATION_STEP);
+    // the error in the frame of the robot
+    const double theta = to_sRad(pose.getTheta());
+    const double dx = to_m(reference.pose.getX() - pose.getX());
+    const double dy = to_m(reference.pose.getY() - pose.getY());
+    const double errorX = std::cos(theta) * dx + std::sin(theta) * dy;
+    const double errorY = -std::sin(theta) * dx + std::cos(theta) * dy;
+    const double errorTheta = to_sRad(reference.pose.getTheta() - pose.getTheta());
+    // the RAMSETE control law
+    const double velocity = to_mps(reference.velocity);
+    const double angularVelocity = to_radps(reference.angularVelocity);
+    const double k =
+        2 * settings.zeta * std::sqrt(angularVelocity * angularVelocity + settings.b * velocity * velocity);
+    const double sinc = (std::abs(errorTheta) < 1e-6) ? 1 : std::sin(errorTheta) / errorTheta;
+    const double v = velocity * std::cos(errorTheta) + k * errorX;
+    const double omega = angularVelocity + k * errorTheta + settings.b * velocity * sinc * errorY;
+    // the accelerations of the trajectory are the feedforward of the velocity controllers
+    const double step = to_sec(ACCELERATION_STEP);
+    const double acceleration = to_mps(next.velocity - reference.velocity) / step;
+    const double angularAcceleration = to_radps(next.angularVelocity - reference.angularVelocity) / step;
+    const double halfWidth = to_m(trackWidth) / 2;
+    return {true,
+            from_mps(v - omega * halfWidth),
+            from_mps(v + omega * halfWidth),
+            0,
+            0,
+            from_mps2(acceleration - angularAcceleration * halfWidth),
+            from_mps2(acceleration + angularAcceleration * halfWidth)};
+}
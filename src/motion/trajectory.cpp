@@ -0,0 +1,51 @@
+#include "motion/trajectory.hpp"
+#include <algorithm>
+#include <cmath>
+
+Trajectory::Trajectory(std::vector<TrajectoryPoint> points)
+    : points(std::move(points)) {}
+
+TrajectoryPoint Trajectory::sample(Time time) const {
+    if (points.empty()) return {time, units::Pose(), 0_mps, 0_radps};
+    if (time <= points.front().time) return points.front();
+    if (time >= points.back().time) {
+        TrajectoryPoint end = points.back();
+        end.velocity = 0_mps;
+        end.angularVelocity = 0_radps;
+        return end;
+    }
+    // find the points around the time, and interpolate between them
+    const auto next = std::upper_bound(points.begin(), points.end(), time,
+                                       [](Time t, const TrajectoryPoint& point) { return t < point.time; });
+    TrajectoryPoint before = *(next - 1);
+    TrajectoryPoint after = *next;
+    const double t = to_sec(time - before.time) / to_sec(after.time - before.time);
+    return {time,
+            units::Pose(before.pose.getX() + (after.pose.getX() - before.pose.getX()) * t,
+                        before.pose.getY() + (after.pose.getY() - before.pose.getY()) * t,
+                        before.pose.getTheta() + (after.pose.getTheta() - before.pose.getTheta()) * t),
+            before.velocity + (after.velocity - before.velocity) * t,
+            before.angularVelocity + (after.angularVelocity - before.angularVelocity) * t};
+}
+
+Time Trajectory::getDuration() const { return points.empty() ? 0_sec : points.back().time; }
+
+uint32_t Trajectory::hash() const {
+    uint32_t result = 2166136261;
+    const auto add = [&](double value) {
+        const int64_t rounded = std::llround(value * 1000);
+        for (int i = 0; i < 8; i++) {
+            result ^= uint8_t(rounded >> (8 * i));
+            result *= 16777619;
+        }
+    };
+    for (TrajectoryPoint point : points) {
+        add(to_sec(point.time));
+        add(to_m(point.pose.getX()));
+        add(to_m(point.pose.getY()));
+        add(to_sRad(point.pose.getTheta()));
+        add(to_mps(point.velocity));
+        add(to_radps(point.angularVelocity));
+    }
+    return result;
+}
@@ -0,0 +1,141 @@
+#include "odometry/fusedOdom.hpp"
+#include "timer.hpp"
+#include <algorithm>
+
+FusedOdom::FusedOdom(std::shared_ptr<Odometry> odometry, std::shared_ptr<GPS> gps, FusionSettings settings)
+    : odometry(odometry),
+      gps(gps),
+      settings(settings),
+      history(size_t(std::max(0.0, std::ceil(to_sec(settings.historyLength) / to_sec(settings.period)))) + 2) {
+    resetFilter();
+}
+
+void FusedOdom::calibrate() {
+    odometry->calibrate();
+    gps->calibrate();
+    pose = odometry->getPose();
+    resetFilter();
+    rejectedFixes = 0;
+}
+
+void FusedOdom::setPose(units::Pose pose) {
+    odometry->setPose(pose);
+    this->pose = pose;
+    resetFilter();
+}
+
+void FusedOdom::correctPosition(Length x, Length y) {
+    offsetX += x;
+    offsetY += y;
+    Odometry::correctPosition(x, y);
+}
+
+Length FusedOdom::getUncertainty() const { return units::sqrt(variance); }
+
+int FusedOdom::getRejectedFixes() const { return rejectedFixes; }
+
+const FusedOdom::HistoryEntry& FusedOdom::historyAt(size_t index) const {
+    return history[(historyStart + index) % history.size()];
+}
+
+void FusedOdom::resetFilter() {
+    historyStart = 0;
+    historySize = 0;
+    offsetX = 0_m;
+    offsetY = 0_m;
+    variance = units::square(settings.initialUncertainty);
+    resetGated();
+}
+
+void FusedOdom::resetGated() {
+    gatedInARow = 0;
+    gatedSumX = 0_m;
+    gatedSumY = 0_m;
+    gatedSumSquares = 0_m2;
+}
+
+units::Pose FusedOdom::update() {
+    units::Pose raw = odometry->update();
+    const Time now = Timer::now();
+    // odometry becomes less certain the further the robot travels
+    if (historySize > 0) {
+        const HistoryEntry& prev = historyAt(historySize - 1);
+        const Length traveled = units::hypot(raw.getX() - prev.pose.getX(), raw.getY() - prev.pose.getY());
+        variance += units::square(settings.drift) * to_m(traveled) +
+                    units::square(settings.driftPerSecond) * to_sec(now - prev.time);
+    }
+    // record the pose, overwriting the oldest one if the history is full, and forget poses older than any fix we
+    // could still receive
+    if (historySize == history.size()) {
+        historyStart = (historyStart + 1) % history.size();
+        historySize--;
+    }
+    history[(historyStart + historySize) % history.size()] = {now, raw};
+    historySize++;
+    while (historySize > 1 && now - historyAt(0).time > settings.historyLength) {
+        historyStart = (historyStart + 1) % history.size();
+        historySize--;
+    }
+    fuse(now);
+    pose = units::Pose(raw.getX() + offsetX, raw.getY() + offsetY, raw.getTheta());
+    return pose;
+}
+
+void FusedOdom::fuse(Time now) {
+    if (gps->getStatus() != GPS_READY) return;
+    units::Pose fix = gps->getPose();
+    const Length error = gps->getError();
+    // the GPS updates slower than odometry, so only use each fix once
+    if (lastFix != std::nullopt && lastFix->getX() == fix.getX() && lastFix->getY() == fix.getY()) return;
+    lastFix = fix;
+    if (error > settings.maxError) {
+        rejectedFixes++;
+        return;
+    }
+    // find the pose of the wrapped odometry when the fix was measured. Skip the fix if it's older than the history,
+    // which happens right after the pose is set
+    const Time measured = now - settings.latency;
+    if (historyAt(0).time > measured) return;
+    size_t after = 0;
+    while (after < historySize && historyAt(after).time < measured) after++;
+    units::Pose past = historyAt(historySize - 1).pose;
+    if (after < historySize && after > 0) {
+        const HistoryEntry& before = historyAt(after - 1);
+        const HistoryEntry& next = historyAt(after);
+        const double t = to_sec(measured - before.time) / to_sec(next.time - before.time);
+        past = units::Pose(before.pose.getX() + (next.pose.getX() - before.pose.getX()) * t,
+                           before.pose.getY() + (next.pose.getY() - before.pose.getY()) * t);
+    } else if (after < historySize) {
+        past = historyAt(after).pose;
+    }
+    // compare the fix to where we think the robot was
+    const Length innovationX = fix.getX() - (past.getX() + offsetX);
+    const Length innovationY = fix.getY() - (past.getY() + offsetY);
+    const Area noise = units::square(std::max(error, settings.minNoise));
+    const Length deviation = units::sqrt(variance + noise);
+    // a fix far from the estimate is more likely a reflection or a blocked sensor than drift. If many fixes in a row
+    // are far but agree with each other though, the estimate is what's wrong, so raise its uncertainty until the next
+    // fix is accepted
+    if (units::abs(innovationX) > settings.gate * deviation || units::abs(innovationY) > settings.gate * deviation) {
+        rejectedFixes++;
+        gatedInARow++;
+        gatedSumX += innovationX;
+        gatedSumY += innovationY;
+        gatedSumSquares += units::square(innovationX) + units::square(innovationY);
+        if (gatedInARow >= settings.maxRejections) {
+            const Length meanX = gatedSumX / gatedInARow;
+            const Length meanY = gatedSumY / gatedInARow;
+            const Area bias = units::square(meanX) + units::square(meanY);
+            const Area spread = gatedSumSquares / gatedInARow - bias;
+            if (spread <= settings.gate * settings.gate * noise) variance = std::max(variance, bias);
+            resetGated();
+        }
+        return;
+    }
+    resetGated();
+    // pull the offset towards the fix, weighted by how certain the estimate and the fix are
+    const double gain = (variance / (variance + noise)).val();
+    offsetX += innovationX * gain;
+    offsetY += innovationY * gain;
+    variance *= 1 - gain;
+}
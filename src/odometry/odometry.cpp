@@ -7,4 +7,8 @@ units::Pose Odometry::getPose() { return pose; }
 
 void Odometry::setPose(units::Pose pose) { this->pose = pose; }
 
+void Odometry::correctPosition(Length x, Length y) {
+    pose = units::Pose(pose.getX() + x, pose.getY() + y, pose.getTheta());
+}
+
 Odometry::~Odometry() {}
@@ -2,6 +2,7 @@
 #include "hardware/imu/imu.hpp"
 #include "pros/rtos.hpp"
 #include "pros/misc.h"
+#include <algorithm>
 #include <iostream>
 
 /**
@@ -19,15 +20,22 @@ Length calculateChord(Length deltaLength, Length offset, Angle deltaAngle) {
 }
 
 PerpWheelOdom::PerpWheelOdom(std::shared_ptr<TrackingWheel> verticalWheel,
-                             std::shared_ptr<TrackingWheel> horizontalWheel, std::shared_ptr<IMU> imu)
+                             std::shared_ptr<TrackingWheel> horizontalWheel, std::shared_ptr<IMU> imu,
+                             std::shared_ptr<TrackingWheel> leftDriveWheel,
+                             std::shared_ptr<TrackingWheel> rightDriveWheel, std::shared_ptr<IMU> backupImu)
     : verticalWheel(verticalWheel),
       horizontalWheel(horizontalWheel),
-      imu(imu) {}
+      imu(imu),
+      leftDriveWheel(leftDriveWheel),
+      rightDriveWheel(rightDriveWheel),
+      backupImu(backupImu) {}
 
 void PerpWheelOdom::calibrate() {
     // reset the tracking wheels and the IMU
     verticalWheel->reset();
     if (horizontalWheel != nullptr) horizontalWheel->reset();
+    if (leftDriveWheel != nullptr) leftDriveWheel->reset();
+    if (rightDriveWheel != nullptr) rightDriveWheel->reset();
     // calibrate IMU
     for (int i = 0; i < 5; i++) {
         while (imu->getStatus() == IMU_CALIBRATING) pros::delay(10);
@@ -35,50 +43,137 @@ void PerpWheelOdom::calibrate() {
         if (imu->getStatus() == IMU_CALIBRATED) break;
         if (i == 4) pros::c::controller_rumble(pros::E_CONTROLLER_MASTER, "---");
     }
+    if (backupImu != nullptr)
+        while (backupImu->getStatus() == IMU_CALIBRATING) pros::delay(10);
     // reset the pose
     pose = {0_m, 0_m, 0_cRad};
+    headingOffset = 0_stRad;
     // reset the previous values
     prevVertical = std::nullopt;
     prevHorizontal = std::nullopt;
     prevAngle = std::nullopt;
+    prevLeftDrive = std::nullopt;
+    prevRightDrive = std::nullopt;
+    prevBackupAngle = std::nullopt;
+    // clear any latched sensor faults
+    verticalMonitor.reset();
+    horizontalMonitor.reset();
+    imuMonitor.reset();
+    backupImuMonitor.reset();
+    failoverCount = 0;
 }
 
 void PerpWheelOdom::setPose(units::Pose pose) {
     this->pose = pose;
-    imu->setYaw(pose.getTheta());
+    // the IMU isn't written to, so the heading is the rotation it measures plus an offset
+    headingOffset = pose.getTheta() - imu->getRotation();
+}
+
+std::vector<FailoverEvent> PerpWheelOdom::getFailoverEvents() const {
+    const size_t count = std::min(failoverCount, failoverEvents.size());
+    std::vector<FailoverEvent> events;
+    for (size_t i = failoverCount - count; i < failoverCount; i++)
+        events.push_back(failoverEvents[i % failoverEvents.size()]);
+    return events;
+}
+
+void PerpWheelOdom::recordFailover(const char* sensor, int prevHealth, int health) {
+    if (prevHealth != SENSOR_HEALTHY || health == SENSOR_HEALTHY) return;
+    failoverEvents[failoverCount++ % failoverEvents.size()] = {from_ms(pros::millis()), sensor, health};
 }
 
 units::Pose PerpWheelOdom::update() {
     // get the distance traveled by the tracking wheels and the angle rotated by the IMU
-    const Length vertical = verticalWheel->getDistance();
-    // if horizontalWheel is nullptr, set horizontal to 0_m, otherwise set it to the distance traveled by the
-    // horizontal wheel
-    const Length horizontal = (horizontalWheel == nullptr) ? 0_m : horizontalWheel->getDistance();
+    // every source is read every tick, so a fallback source is up to date when it is needed
+    // wheel positions are read in ticks, so deltas are exact no matter how far the robot has traveled
+    const int64_t vertical = verticalWheel->getTicks();
+    // if horizontalWheel is nullptr, set horizontal to 0, otherwise set it to the position of the horizontal wheel
+    const int64_t horizontal = (horizontalWheel == nullptr) ? 0 : horizontalWheel->getTicks();
     const Angle angle = imu->getRotation();
+    const bool hasDrive = leftDriveWheel != nullptr && rightDriveWheel != nullptr;
+    const int64_t leftDrive = hasDrive ? leftDriveWheel->getTicks() : 0;
+    const int64_t rightDrive = hasDrive ? rightDriveWheel->getTicks() : 0;
+    const Angle backupAngle = (backupImu == nullptr) ? 0_stRad : backupImu->getRotation();
     // set previous values to the current values if they are not set
     // this should only happen on the first iteration
     if (prevVertical == std::nullopt) prevVertical = vertical;
     if (prevHorizontal == std::nullopt) prevHorizontal = horizontal;
     if (prevAngle == std::nullopt) prevAngle = angle;
-    // calculate deltas
-    const Length deltaVertical = vertical - prevVertical.value();
-    const Length deltaHorizontal = horizontal - prevHorizontal.value();
-    const Angle deltaAngle = angle - prevAngle.value();
-    // calculate average angle
-    const Angle avgAngle = prevAngle.value() + deltaAngle / 2;
+    if (prevLeftDrive == std::nullopt) prevLeftDrive = leftDrive;
+    if (prevRightDrive == std::nullopt) prevRightDrive = rightDrive;
+    if (prevBackupAngle == std::nullopt) prevBackupAngle = backupAngle;
+    // calculate deltas. Wheel deltas are calculated in ticks before they are converted to distances
+    const Length deltaVertical = (vertical - prevVertical.value()) * verticalWheel->getDistancePerTick();
+    const Length deltaHorizontal = (horizontalWheel == nullptr)
+                                       ? 0_m
+                                       : (horizontal - prevHorizontal.value()) * horizontalWheel->getDistancePerTick();
+    const Angle deltaImu = angle - prevAngle.value();
+    const Length deltaLeft =
+        hasDrive ? (leftDrive - prevLeftDrive.value()) * leftDriveWheel->getDistancePerTick() : 0_m;
+    const Length deltaRight =
+        hasDrive ? (rightDrive - prevRightDrive.value()) * rightDriveWheel->getDistancePerTick() : 0_m;
+    const Angle deltaBackupImu = backupAngle - prevBackupAngle.value();
     // update previous values
     prevVertical = vertical;
     prevHorizontal = horizontal;
     prevAngle = angle;
+    prevLeftDrive = leftDrive;
+    prevRightDrive = rightDrive;
+    prevBackupAngle = backupAngle;
+    // estimate the change in heading and the vertical wheel's travel from the drive encoders
+    // the vertical wheel's travel is interpolated between the drive wheels based on its offset
+    std::optional<Angle> driveDeltaAngle;
+    std::optional<Length> driveDeltaVertical;
+    if (hasDrive) {
+        const Length leftOffset = leftDriveWheel->getOffset();
+        const Length rightOffset = rightDriveWheel->getOffset();
+        driveDeltaAngle = from_sRad(((deltaRight - deltaLeft) / (leftOffset - rightOffset)).val());
+        const double verticalRatio = ((verticalWheel->getOffset() - leftOffset) / (rightOffset - leftOffset)).val();
+        driveDeltaVertical = deltaLeft + (deltaRight - deltaLeft) * verticalRatio;
+    }
+    // check the health of the sensors
+    const int prevVerticalHealth = verticalMonitor.getHealth();
+    const int prevHorizontalHealth = horizontalMonitor.getHealth();
+    const int prevImuHealth = imuMonitor.getHealth();
+    const int prevBackupImuHealth = backupImuMonitor.getHealth();
+    // the backup IMU is a better heading reference than the drive encoders, which scrub while turning
+    std::optional<Angle> imuReference = driveDeltaAngle;
+    if (backupImu != nullptr && prevBackupImuHealth == SENSOR_HEALTHY) imuReference = deltaBackupImu;
+    recordFailover("vertical tracking wheel", prevVerticalHealth,
+                   verticalMonitor.update(verticalWheel->getStatus() < ENCODER_UNKNOWN_ERROR, deltaVertical,
+                                          driveDeltaVertical));
+    if (horizontalWheel != nullptr)
+        recordFailover("horizontal tracking wheel", prevHorizontalHealth,
+                       horizontalMonitor.update(horizontalWheel->getStatus() < ENCODER_UNKNOWN_ERROR, deltaHorizontal));
+    recordFailover("IMU", prevImuHealth,
+                   imuMonitor.update(imu->getStatus() < IMU_UNKOWN_ERROR, deltaImu, imuReference));
+    if (backupImu != nullptr)
+        recordFailover("backup IMU", prevBackupImuHealth,
+                       backupImuMonitor.update(backupImu->getStatus() < IMU_UNKOWN_ERROR, deltaBackupImu,
+                                               (prevImuHealth == SENSOR_HEALTHY) ? deltaImu : driveDeltaAngle));
+    // pick the best healthy source for each measurement
+    Length verticalSource = 0_m;
+    if (verticalMonitor.getHealth() == SENSOR_HEALTHY) verticalSource = deltaVertical;
+    else if (driveDeltaVertical) verticalSource = *driveDeltaVertical;
+    const Length horizontalSource = (horizontalMonitor.getHealth() == SENSOR_HEALTHY) ? deltaHorizontal : 0_m;
+    Angle deltaAngle = 0_stRad;
+    if (imuMonitor.getHealth() == SENSOR_HEALTHY) deltaAngle = deltaImu;
+    else if (backupImu != nullptr && backupImuMonitor.getHealth() == SENSOR_HEALTHY) deltaAngle = deltaBackupImu;
+    else if (driveDeltaAngle) deltaAngle = *driveDeltaAngle;
+    // calculate average angle
+    const Angle avgAngle = pose.getTheta() + deltaAngle / 2;
     // calculate local coordinates
-    const Length localX = calculateChord(deltaHorizontal, horizontalWheel->getOffset(), deltaAngle);
-    const Length localY = calculateChord(deltaVertical, verticalWheel->getOffset(), deltaAngle);
+    const Length horizontalOffset = (horizontalWheel == nullptr) ? 0_m : horizontalWheel->getOffset();
+    const Length localX = calculateChord(horizontalSource, horizontalOffset, deltaAngle);
+    const Length localY = calculateChord(verticalSource, verticalWheel->getOffset(), deltaAngle);
     units::Pose localPose(localX, localY);
     // rotate the local coordinates by the average angle to get the change in global coordinates
-    localPose.rotateBy(avgAngle);
+    // the local y axis points forwards, which is 90 degrees from the x axis the heading is measured from
+    localPose.rotateBy(avgAngle - 90_stDeg);
     // add the change in global coordinates to the current pose
     pose += localPose;
-    // set the global heading
-    pose.setTheta(angle);
+    // set the global heading. The IMU measures absolute heading, so it's used directly when it's healthy
+    if (imuMonitor.getHealth() == SENSOR_HEALTHY) pose.setTheta(angle + headingOffset);
+    else pose.setTheta(pose.getTheta() + deltaAngle);
     return pose;
-}
\ No newline at end of file
+}
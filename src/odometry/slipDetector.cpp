@@ -0,0 +1,85 @@
+#include "odometry/slipDetector.hpp"
+#include <algorithm>
+
+constexpr double FILTER_GAIN = 0.3; // weight of the newest reading in the low pass filter
+constexpr Length MIN_MOTION = 2_mm; // minimum displacement per tick to be considered moving
+constexpr Angle MIN_ROTATION = 0.5_stDeg; // minimum rotation per tick to be considered turning
+constexpr int DEBOUNCE_TICKS = 3; // how many ticks a state has to persist before it's reported
+
+SlipDetector::SlipDetector(std::shared_ptr<TrackingWheel> verticalWheel, std::shared_ptr<IMU> imu, Length trackWidth,
+                           double effortThreshold, double slipThreshold)
+    : verticalWheel(verticalWheel),
+      imu(imu),
+      trackWidth(trackWidth),
+      effortThreshold(effortThreshold),
+      slipThreshold(slipThreshold) {}
+
+TractionSignal SlipDetector::update(Length left, Length right, double leftEffort, double rightEffort) {
+    const int64_t tracking = verticalWheel->getTicks();
+    const Angle angle = imu->getRotation();
+    // set previous values to the current values if they are not set
+    if (prevLeft == std::nullopt) prevLeft = left;
+    if (prevRight == std::nullopt) prevRight = right;
+    if (prevTracking == std::nullopt) prevTracking = tracking;
+    if (prevAngle == std::nullopt) prevAngle = angle;
+    // calculate deltas. The tracking wheel's travel is corrected for its offset so it measures the forward motion
+    // of the tracking center, same as the average of the drive wheels
+    const Angle deltaAngle = angle - prevAngle.value();
+    const Length deltaDrive = ((left - prevLeft.value()) + (right - prevRight.value())) / 2;
+    const Length deltaTracking = (tracking - prevTracking.value()) * verticalWheel->getDistancePerTick() +
+                                 verticalWheel->getOffset() * to_sRad(deltaAngle);
+    const Angle deltaDriveAngle =
+        from_sRad((((right - prevRight.value()) - (left - prevLeft.value())) / trackWidth).val());
+    prevLeft = left;
+    prevRight = right;
+    prevTracking = tracking;
+    prevAngle = angle;
+    // low pass filter the deltas
+    driveDelta = driveDelta + (deltaDrive - driveDelta) * FILTER_GAIN;
+    trackingDelta = trackingDelta + (deltaTracking - trackingDelta) * FILTER_GAIN;
+    driveAngleDelta = driveAngleDelta + (deltaDriveAngle - driveAngleDelta) * FILTER_GAIN;
+    imuAngleDelta = imuAngleDelta + (deltaAngle - imuAngleDelta) * FILTER_GAIN;
+    // calculate how much of the drive's motion is lost, both linearly and angularly
+    double slipRatio = 0;
+    if (units::abs(driveDelta) > MIN_MOTION) slipRatio = 1 - (trackingDelta / driveDelta).val();
+    if (units::abs(driveAngleDelta) > MIN_ROTATION)
+        slipRatio = std::max(slipRatio, 1 - (imuAngleDelta / driveAngleDelta).val());
+    slipRatio = std::clamp(slipRatio, 0.0, 1.0);
+    // classify the traction state
+    const bool powered = std::max(std::fabs(leftEffort), std::fabs(rightEffort)) > effortThreshold;
+    const bool driveMoving = units::abs(driveDelta) > MIN_MOTION || units::abs(driveAngleDelta) > MIN_ROTATION;
+    const bool robotMoving = units::abs(trackingDelta) > MIN_MOTION || units::abs(imuAngleDelta) > MIN_ROTATION;
+    int state = TRACTION_OK;
+    if (powered && !driveMoving && !robotMoving) state = TRACTION_STALLED;
+    // wheels spinning while the robot is held in place, or the robot moving while the wheels aren't
+    else if (driveMoving != robotMoving) state = TRACTION_PUSHING;
+    // the robot moving in the opposite direction of the wheels
+    else if (units::abs(driveDelta) > MIN_MOTION && units::abs(trackingDelta) > MIN_MOTION &&
+             units::sgn(driveDelta) != units::sgn(trackingDelta))
+        state = TRACTION_PUSHING;
+    else if (slipRatio > slipThreshold) state = TRACTION_SLIP;
+    // debounce the state
+    if (state == candidateState) candidateTicks++;
+    else candidateTicks = 1;
+    candidateState = state;
+    if (candidateTicks >= DEBOUNCE_TICKS) signal.state = state;
+    signal.slipRatio = slipRatio;
+    signal.poseUncertain = signal.state == TRACTION_SLIP || signal.state == TRACTION_PUSHING;
+    return signal;
+}
+
+TractionSignal SlipDetector::getSignal() const { return signal; }
+
+void SlipDetector::reset() {
+    prevLeft = std::nullopt;
+    prevRight = std::nullopt;
+    prevTracking = std::nullopt;
+    prevAngle = std::nullopt;
+    driveDelta = 0_m;
+    trackingDelta = 0_m;
+    driveAngleDelta = 0_stRad;
+    imuAngleDelta = 0_stRad;
+    candidateState = TRACTION_OK;
+    candidateTicks = 0;
+    signal = {};
+}
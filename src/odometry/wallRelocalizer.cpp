@@ -0,0 +1,65 @@
+#include "odometry/wallRelocalizer.hpp"
+#include <algorithm>
+#include <optional>
+
+WallRelocalizer::WallRelocalizer(std::shared_ptr<Odometry> odometry, std::vector<MountedDistanceSensor> sensors,
+                                 std::vector<Wall> walls, RelocalizerSettings settings)
+    : odometry(odometry),
+      sensors(sensors),
+      walls(walls),
+      settings(settings) {}
+
+void WallRelocalizer::update() {
+    units::Pose pose = odometry->getPose();
+    const Angle heading = pose.getTheta();
+    // the local frame has x to the right and y forwards, which is 90 degrees from the x axis the heading is
+    // measured from
+    const double cosLocal = std::cos(to_sRad(heading) - M_PI / 2);
+    const double sinLocal = std::sin(to_sRad(heading) - M_PI / 2);
+    const double minAlignment = std::cos(to_sRad(settings.maxIncidence));
+    Length errorSum[2] = {0_m, 0_m};
+    int errorCount[2] = {0, 0};
+    for (const MountedDistanceSensor& mounted : sensors) {
+        const std::optional<Length> distance = mounted.sensor->getDistance();
+        if (distance == std::nullopt || distance.value() > settings.maxRange) continue;
+        if (mounted.sensor->getConfidence() < settings.minConfidence) continue;
+        // position of the sensor and direction of its beam on the field
+        const Length sensorX = pose.getX() + mounted.x * cosLocal - mounted.y * sinLocal;
+        const Length sensorY = pose.getY() + mounted.x * sinLocal + mounted.y * cosLocal;
+        const double beamX = std::cos(to_sRad(heading + mounted.angle));
+        const double beamY = std::sin(to_sRad(heading + mounted.angle));
+        // find the closest wall the beam hits while roughly square to it
+        std::optional<Length> expected;
+        int axis = WALL_X;
+        double alignment = 0;
+        for (const Wall& wall : walls) {
+            const double beam = (wall.axis == WALL_X) ? beamX : beamY;
+            if (std::abs(beam) < minAlignment) continue;
+            const Length toWall = (wall.axis == WALL_X) ? wall.position - sensorX : wall.position - sensorY;
+            const Length range = toWall / beam;
+            if (range <= 0_m || (expected != std::nullopt && range >= expected.value())) continue;
+            expected = range;
+            axis = wall.axis;
+            alignment = beam;
+        }
+        // a reading far from the expected distance is probably not the wall
+        if (expected == std::nullopt || units::abs(distance.value() - expected.value()) > settings.maxError) continue;
+        // the sensor is closer to the wall than odometry thinks if the reading is shorter than expected
+        errorSum[axis] += (expected.value() - distance.value()) * alignment;
+        errorCount[axis]++;
+    }
+    // replace the remaining correction with the new measurement, since it already includes previous corrections
+    if (errorCount[WALL_X] > 0) pendingX = errorSum[WALL_X] / errorCount[WALL_X];
+    if (errorCount[WALL_Y] > 0) pendingY = errorSum[WALL_Y] / errorCount[WALL_Y];
+    // apply part of the correction
+    const Length stepX = std::clamp(pendingX * settings.blendGain, -settings.maxStep, settings.maxStep);
+    const Length stepY = std::clamp(pendingY * settings.blendGain, -settings.maxStep, settings.maxStep);
+    pendingX -= stepX;
+    pendingY -= stepY;
+    if (stepX != 0_m || stepY != 0_m) odometry->correctPosition(stepX, stepY);
+}
+
+void WallRelocalizer::reset() {
+    pendingX = 0_m;
+    pendingY = 0_m;
+}
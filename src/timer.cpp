@@ -3,7 +3,7 @@
 
 Timer::Timer(Time time)
     : period(time) {
-    lastTime = from_ms(pros::millis());
+    lastTime = now();
 }
 
 Time Timer::getTimeSet() {
@@ -65,4 +65,8 @@ void Timer::resume() {
 void Timer::waitUntilDone() {
     do delay(5_ms);
     while (!this->isDone());
-}
\ No newline at end of file
+}
+
+Time Timer::now() { return from_us(pros::micros()); }
+
+void Timer::delay(Time time) { pros::delay(to_ms(time)); }